@@ -11,13 +11,35 @@
 // CHANGELOG
 //  2023-10-20: Initial version.
 //  2023-11-29: Rendering triangles
+//  2026-10-16: Added ImGui_ImplD2D_EnableTextureAtlas() to pack small textures into shared pages, textured quads are drawn as bitmaps.
+//  2026-10-16: Font atlas is uploaded to ID2D1Bitmap once per atlas build instead of using a dummy texture id.
+//  2026-10-16: Added ImGui_ImplD2D_LoadTexture() overload decoding memory mapped image file.
+//  2026-10-16: Added ImGui_ImplD2D_GetFrameStats().
+//  2026-10-16: Draw lists are translated to commands by portable code, added ImGui_ImplD2D_BeginCapture()/ImGui_ImplD2D_EndCapture().
+//  2026-10-16: Added trace zones (Tracy or Chrome trace JSON), ImGui_ImplD2D_BeginTrace()/ImGui_ImplD2D_EndTrace().
+//  2026-10-16: Added ImGui_ImplD2D_ShowMetricsWindow().
+//  2026-10-16: Glyph lookup by hash of texture coordinates, classification work is linear in index count (ClassifySteps stat).
+//  2026-10-16: Added ImGui_ImplD2D_SetParallelFor() to translate draw lists with job system.
+//  2026-10-16: Added ImGui_ImplD2D_StartRenderThread(), draw data is copied & rendered on backend owned thread.
+//  2026-10-16: Multithreaded factory is locked with ID2D1Multithread only around drawing & uploads, textures can be loaded on any thread.
+//  2026-10-16: Added ImGui_ImplD2D_BuildCommandBuffer()/ImGui_ImplD2D_Submit(), translation is separated from submission.
+//  2026-10-16: Color table is generated at compile time.
+//  2026-10-16: Long solid polygons are grouped by vectorized triangle adjacency scanner (SSE2/NEON, 16 & 32 bit indices).
+//  2026-10-16: Translation loop is instantiated for index type & features (text, gradients, statistics).
+//  2026-10-16: Commands of draw lists with unchanged hash are reused from previous frame, added ImGui_ImplD2D_SetDrawListReuse().
+//  2026-10-16: Added ImGui_ImplD2D_EnableWindowCache(), draw lists are rendered into offscreen bitmaps redrawn only when they change.
+//  2026-10-16: Added ImGui_ImplD2D_ComputeDirtyRects() for partial presents & ImGui_ImplD2D_SetDirtyRectClipping().
+//  2026-10-16: Added ImGui_ImplD2D_IsFrameUnchanged(), frames fingerprinted same as last drawn one can be skipped.
+//  2026-10-16: Added ImGui_ImplD2D_EnableGeometryCache(), path geometries are keyed by shape relative to first point & drawn with transform.
+//  2026-10-16: Primitives outside of clip rectangle are culled by translation, clip is skipped for draw commands entirely inside it.
+//  2026-10-16: Added ImGui_ImplD2D_SetOcclusionCulling(), draw commands covered by opaque rectangles of later windows are skipped.
 
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_d2d.h"
+#include "imgui_impl_d2d_internal.h"
 
 #include <cstdio>
-#include <vector>
 #include <cstdint>     // intptr_t
 #include <cmath>
 
@@ -124,10 +146,33 @@ struct ImGui_ImplD2D_ComPtr
 };
 #endif
 
+/** @brief Identifies uploaded font atlas build
+
+    ImFontAtlas does not carry build counter, instead AddFont(), ClearFonts() & Clear() reset TexReady until atlas
+    is built again, so atlas seen not ready is uploaded again. Font count & atlas size catch builds done by application
+    in between. Pixel pointers are not compared, allocator may return the same address for new build.
+ */
+struct ImGui_ImplD2D_FontAtlasVersion {
+    /** @brief ImFontAtlas::ConfigData size */
+    int FontCount;
+    int Width;
+    int Height;
+};
+
 /** @brief Font store object */
 struct ImGui_ImplD2D_Fonts {
     // store texture bitmap
     ImGui_ImplD2D_ComPtr<ID2D1Bitmap> FontBitmap;
+    /** @brief Atlas version uploaded to @see FontBitmap */
+    ImGui_ImplD2D_FontAtlasVersion Version;
+    /** @brief Copy of uploaded pixels (premultiplied BGRA) used to find area changed by atlas rebuild */
+    ImVector<ImU32> Pixels;
+    /** @brief Copy of file data of default font, DirectWrite font collection is created from it on first text format,
+        possibly on render thread which must not read ImGui font atlas */
+    ImVector<unsigned char> FontFileData;
+    /** @brief Number of atlas uploads & uploaded bytes, each upload is a noticeable frame spike */
+    int UploadCount;
+    ImU64 UploadBytes;
     // store texture bitmap brush
     ImGui_ImplD2D_ComPtr<ID2D1BitmapBrush> FontBitmapBrush;
     struct {
@@ -148,11 +193,19 @@ struct ImGui_ImplD2D_Fonts {
 struct ImGui_ImplD2D_Images {
 };
 
+/** @brief Texture packed into texture atlas page, pointer to it is used as ImTextureID */
+struct ImGui_ImplD2D_AtlasImage {
+    /** @brief Place in page, bitmap of page is @see ImGui_ImplD2D_Data::TextureAtlasPages at Rect.Page */
+    ImGui_ImplD2D_AtlasRect Rect;
+};
+
 using ImGui_ImplD2D_Factory = ID2D1Factory;
 
 struct ImGui_ImplD2D_Data
 {
     ImGui_ImplD2D_ComPtr<ImGui_ImplD2D_Factory> Factory;
+    /** @brief Lock of multithreaded factory, null when factory is single threaded */
+    ImGui_ImplD2D_ComPtr<ID2D1Multithread> Multithread;
     /** @brief Render target */
     ImGui_ImplD2D_ComPtr<ImGui_ImplD2D_RenderTarget> RenderTarget;
     /** @brief Text renderer factory */
@@ -164,8 +217,91 @@ struct ImGui_ImplD2D_Data
     ImGui_ImplD2D_Fonts* Fonts;
     ImGui_ImplD2D_ComPtr<ID2D1SolidColorBrush> SolidColorBrush;
     ImGui_ImplD2D_ComPtr<ID2D1StrokeStyle> StrokeStyle;
-    D2D1_GRADIENT_STOP GradientStops[2];
-    ImGui_ImplD2D_Data() { memset((void*)this, 0, sizeof(*this)); }
+
+    /** @brief Small textures are packed into pages when enabled, atlas memory is allocated on loading threads
+        without ImGui allocator, which is not synchronized */
+    bool TextureAtlasEnabled;
+    ImGui_ImplD2D_AtlasPacker TextureAtlas;
+    /** @brief Bitmap of each texture atlas page, null until page is drawn on current render target */
+    std::vector<ID2D1Bitmap*> TextureAtlasPages;
+    /** @brief Premultiplied BGRA pixels of all pages one after another, pages are recreated from them after device loss */
+    std::vector<BYTE> TextureAtlasPixels;
+    /** @brief Packed textures sorted by address, so any texture id can be looked up */
+    std::vector<ImGui_ImplD2D_AtlasImage*> TextureAtlasImages;
+
+    /** @brief Statistics of last rendered frame */
+    ImGui_ImplD2D_FrameStats FrameStats;
+    /** @brief Font atlas upload count when @see FrameStats were reset */
+    int FrameStatsUploadCount;
+    /** @brief Statistics of last frames shown by ImGui_ImplD2D_ShowMetricsWindow() */
+    ImGui_ImplD2D_FrameHistory FrameHistory;
+
+    /** @brief Glyph metadata of uploaded font atlas, used to recognize text */
+    ImGui_ImplD2D_FontTable FontTable;
+    /** @brief Commands of each draw list being rendered, memory is reused between frames */
+    ImGui_ImplD2D_FrameCommands FrameCommands;
+    /** @brief Offscreen bitmaps of draw lists, enabled by ImGui_ImplD2D_EnableWindowCache() */
+    ImGui_ImplD2D_LayerCache LayerCache;
+    /** @brief Path geometries of polygons by shape, enabled by ImGui_ImplD2D_EnableGeometryCache() */
+    ImGui_ImplD2D_GeometryCache GeometryCache;
+    /** @brief Changes between frames passed to ImGui_ImplD2D_ComputeDirtyRects() */
+    ImGui_ImplD2D_DirtyTracker DirtyTracker;
+    /** @brief Font atlas upload count of last ImGui_ImplD2D_ComputeDirtyRects(), new atlas pixels make whole frame dirty */
+    int DirtyTrackerUploadCount;
+    /** @brief Drawing is restricted to dirty rectangles, set by ImGui_ImplD2D_SetDirtyRectClipping() */
+    bool DirtyRectClipping;
+    /** @brief Dirty rectangles were computed for frame not rendered yet */
+    bool DirtyRectsPending;
+    /** @brief Fingerprint of last frame drawn, valid when ImGui_ImplD2D_IsFrameUnchanged() was called for it */
+    ImU64 PresentedFingerprint;
+    bool HasPresentedFingerprint;
+    /** @brief Fingerprint computed by ImGui_ImplD2D_IsFrameUnchanged() for frame not rendered yet */
+    ImU64 PendingFingerprint;
+    bool HasPendingFingerprint;
+    /** @brief Job system hook set by ImGui_ImplD2D_SetParallelFor(), draw lists are translated serially when null */
+    ImGui_ImplD2D_ParallelForFunc ParallelFor;
+    void* ParallelForUserData;
+    /** @brief Set between ImGui_ImplD2D_StartRenderThread() & ImGui_ImplD2D_StopRenderThread() */
+    ImGui_ImplD2D_RenderThread* RenderThread;
+    ImGui_ImplD2D_RenderThreadFunc RenderThreadBeginFrame;
+    ImGui_ImplD2D_RenderThreadFunc RenderThreadEndFrame;
+    void* RenderThreadUserData;
+    /** @brief Device frames are submitted to instead of render target, set by ImGui_ImplD2D_SetSubmitDevice() */
+    ImGui_ImplD2D_Device* SubmitDevice;
+    /** @brief Draw data capture, set between ImGui_ImplD2D_BeginCapture() & ImGui_ImplD2D_EndCapture() */
+    ImGui_ImplD2D_CaptureWriter* Capture;
+    /** @brief Totals of factory lock sections of all threads, frame statistics report difference to previous frame */
+    std::atomic<int> FactoryLocks;
+    std::atomic<ImU64> FactoryLockWaitTime;
+    std::atomic<ImU64> FactoryLockHoldTime;
+    int FrameStatsFactoryLocks;
+    ImU64 FrameStatsFactoryLockWaitTime;
+    ImU64 FrameStatsFactoryLockHoldTime;
+    // members with constructors (atomics, caches, vectors) must not be zero filled over
+    ImGui_ImplD2D_Data() : FactoryLocks(0), FactoryLockWaitTime(0), FactoryLockHoldTime(0) {
+        Fonts = nullptr;
+        TextureAtlasEnabled = false;
+        memset(&FrameStats, 0, sizeof(FrameStats));
+        FrameStatsUploadCount = 0;
+        DirtyTrackerUploadCount = 0;
+        DirtyRectClipping = false;
+        DirtyRectsPending = false;
+        PresentedFingerprint = 0;
+        HasPresentedFingerprint = false;
+        PendingFingerprint = 0;
+        HasPendingFingerprint = false;
+        ParallelFor = nullptr;
+        ParallelForUserData = nullptr;
+        RenderThread = nullptr;
+        RenderThreadBeginFrame = nullptr;
+        RenderThreadEndFrame = nullptr;
+        RenderThreadUserData = nullptr;
+        SubmitDevice = nullptr;
+        Capture = nullptr;
+        FrameStatsFactoryLocks = 0;
+        FrameStatsFactoryLockWaitTime = 0;
+        FrameStatsFactoryLockHoldTime = 0;
+    }
 };
 
 inline static ImGui_ImplD2D_Data* ImGui_ImplD2D_GetBackendData()
@@ -173,6 +309,139 @@ inline static ImGui_ImplD2D_Data* ImGui_ImplD2D_GetBackendData()
     return ImGui::GetCurrentContext() ? (ImGui_ImplD2D_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
 }
 
+/** @brief Keep ID2D1Multithread interface when factory is multithreaded, called when factory changes */
+static void ImGui_ImplD2D_UpdateMultithread(ImGui_ImplD2D_Data* backendData) {
+    backendData->Multithread.Reset();
+    ImGui_ImplD2D_ComPtr<ID2D1Multithread> multithread;
+    if (backendData->Factory != nullptr && SUCCEEDED(backendData->Factory.As(&multithread)) && multithread->GetMultithreadProtected()) {
+        backendData->Multithread = multithread;
+    }
+}
+
+/** @brief Scoped ID2D1Multithread lock, does nothing when factory is single threaded
+
+    Taken only around sections touching render target or bitmaps (drawing, uploads), so other threads can create
+    resources in between. Wait & hold times are added to backend totals.
+ */
+struct ImGui_ImplD2D_FactoryLock
+{
+    ImGui_ImplD2D_Data* BackendData;
+    ImU64   Acquired;
+
+    explicit ImGui_ImplD2D_FactoryLock(ImGui_ImplD2D_Data* backendData) : BackendData(nullptr), Acquired(0) {
+        if (backendData == nullptr || backendData->Multithread == nullptr) {
+            return;
+        }
+        BackendData = backendData;
+        IMGUI_IMPL_D2D_STAT_TIMER_BEGIN(waitStart);
+        backendData->Multithread->Enter();
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+        Acquired = ImGui_ImplD2D_GetTicks();
+        backendData->FactoryLocks++;
+        backendData->FactoryLockWaitTime += Acquired - waitStart;
+#endif
+    }
+
+    ~ImGui_ImplD2D_FactoryLock() {
+        if (BackendData == nullptr) {
+            return;
+        }
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+        BackendData->FactoryLockHoldTime += ImGui_ImplD2D_GetTicks() - Acquired;
+#endif
+        BackendData->Multithread->Leave();
+    }
+};
+
+/** @brief Report factory lock totals since previous frame in @p stats */
+static void ImGui_ImplD2D_UpdateFactoryLockStats(ImGui_ImplD2D_Data* backendData, ImGui_ImplD2D_FrameStats* stats) {
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    const int locks = backendData->FactoryLocks;
+    const ImU64 waitTime = backendData->FactoryLockWaitTime;
+    const ImU64 holdTime = backendData->FactoryLockHoldTime;
+    stats->FactoryLocks = locks - backendData->FrameStatsFactoryLocks;
+    stats->FactoryLockWaitTime = waitTime - backendData->FrameStatsFactoryLockWaitTime;
+    stats->FactoryLockHoldTime = holdTime - backendData->FrameStatsFactoryLockHoldTime;
+    backendData->FrameStatsFactoryLocks = locks;
+    backendData->FrameStatsFactoryLockWaitTime = waitTime;
+    backendData->FrameStatsFactoryLockHoldTime = holdTime;
+#else
+    IM_UNUSED(backendData);
+    IM_UNUSED(stats);
+#endif
+}
+
+/** @brief Index of first packed texture in @see ImGui_ImplD2D_Data::TextureAtlasImages at or after @p texture address */
+static int ImGui_ImplD2D_LowerBoundAtlasImage(const ImGui_ImplD2D_Data* backendData, ImTextureID texture) {
+    const std::vector<ImGui_ImplD2D_AtlasImage*>& images = backendData->TextureAtlasImages;
+    int first = 0;
+    int count = (int)images.size();
+    while (count > 0) {
+        const int half = count / 2;
+        if ((uintptr_t)images[first + half] < (uintptr_t)texture) {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+/** @brief Bitmap of texture atlas page, created on backend render target from kept pixels when missing */
+static ID2D1Bitmap* ImGui_ImplD2D_GetAtlasPage(ImGui_ImplD2D_Data* backendData, int page) {
+    ID2D1Bitmap*& bitmap = backendData->TextureAtlasPages[page];
+    if (bitmap == nullptr && backendData->RenderTarget.Get() != nullptr) {
+        const ImGui_ImplD2D_AtlasPacker& atlas = backendData->TextureAtlas;
+        const int pitch = atlas.PageWidth * 4;
+        const D2D1_BITMAP_PROPERTIES props = D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+        backendData->RenderTarget->CreateBitmap(D2D1::SizeU(atlas.PageWidth, atlas.PageHeight),
+            backendData->TextureAtlasPixels.data() + (size_t)page * pitch * atlas.PageHeight, pitch, props, &bitmap);
+    }
+    return bitmap;
+}
+
+/** @brief Find bitmap of texture
+
+    @param rect[out] Set to sub-rectangle of the page for packed texture, or null
+
+    @returns
+        This function returns bitmap that should be sampled with texture coordinates remapped
+        by @see ImGui_ImplD2D_AtlasRemapUV (when @p rect is set), null when page could not be created
+ */
+inline static ID2D1Bitmap* ImGui_ImplD2D_ResolveTexture(ImGui_ImplD2D_Data* backendData, ImTextureID texture, const ImGui_ImplD2D_AtlasRect** rect) {
+    *rect = nullptr;
+    const int index = ImGui_ImplD2D_LowerBoundAtlasImage(backendData, texture);
+    if (index < (int)backendData->TextureAtlasImages.size() && (ImTextureID)backendData->TextureAtlasImages[index] == texture) {
+        const ImGui_ImplD2D_AtlasImage* image = backendData->TextureAtlasImages[index];
+        *rect = &image->Rect;
+        return ImGui_ImplD2D_GetAtlasPage(backendData, image->Rect.Page);
+    }
+    return (ID2D1Bitmap*)texture;
+}
+
+/** @brief Release page bitmaps of render target, pixels are kept so pages are recreated when drawn again */
+static void ImGui_ImplD2D_ReleaseTextureAtlasPages(ImGui_ImplD2D_Data* backendData) {
+    for (size_t i = 0; i < backendData->TextureAtlasPages.size(); i++) {
+        if (backendData->TextureAtlasPages[i] != nullptr) {
+            backendData->TextureAtlasPages[i]->Release();
+            backendData->TextureAtlasPages[i] = nullptr;
+        }
+    }
+}
+
+static void ImGui_ImplD2D_DestroyTextureAtlas(ImGui_ImplD2D_Data* backendData) {
+    for (size_t i = 0; i < backendData->TextureAtlasImages.size(); i++) {
+        delete backendData->TextureAtlasImages[i];
+    }
+    backendData->TextureAtlasImages.clear();
+    ImGui_ImplD2D_ReleaseTextureAtlasPages(backendData);
+    backendData->TextureAtlasPages.clear();
+    backendData->TextureAtlasPixels.clear();
+    backendData->TextureAtlas.Clear();
+}
+
 bool     ImGui_ImplD2D_Init(ID2D1RenderTarget* rendererTarget, IDWriteFactory* writeFactory) {
     ImGuiIO& io = ImGui::GetIO();
     IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
@@ -186,22 +455,16 @@ bool     ImGui_ImplD2D_Init(ID2D1RenderTarget* rendererTarget, IDWriteFactory* w
     io.BackendRendererName = "imgui_impl_d2d";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
 
-    bd->GradientStops[0U].position = 0.f;
-    bd->GradientStops[1U].position = 1.f;
     HRESULT hr = S_OK;
     bool success = SUCCEEDED(hr);
     rendererTarget->GetFactory(bd->Factory.GetAddressOf());
-    if (success) {
-        success = ImGui_ImplD2D_CreateDeviceObjects(rendererTarget);
-    }
-    if (success) {
+    ImGui_ImplD2D_UpdateMultithread(bd);
+    if (success && !io.Fonts->IsBuilt()) {
         success = io.Fonts->Build();
     }
     if (success) {
-
-        if (io.Fonts->TexID == 0) {
-            io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
-        }
+        // uploads font atlas & sets its texture id
+        success = ImGui_ImplD2D_CreateDeviceObjects(rendererTarget);
     }
     if (success) {
         D2D1_STROKE_STYLE_PROPERTIES props = D2D1::StrokeStyleProperties();
@@ -235,6 +498,7 @@ bool ImGui_ImplD2D_CreateDeviceObjects(ID2D1RenderTarget* renderTarget) {
         // those this increase reference count?
         bd->Factory.Reset();
         renderTarget->GetFactory(bd->Factory.GetAddressOf());
+        ImGui_ImplD2D_UpdateMultithread(bd);
         if (FAILED(hr)) {
             return false;
         }
@@ -247,18 +511,133 @@ bool ImGui_ImplD2D_CreateDeviceObjects(ID2D1RenderTarget* renderTarget) {
     return ImGui_ImplD2D_CreateFontsTexture();
 }
 
+static void ImGui_ImplD2D_DestroyLayerCache(ImGui_ImplD2D_Data* backendData);
+static void ImGui_ImplD2D_DestroyGeometryCache(ImGui_ImplD2D_Data* backendData);
+
 void    ImGui_ImplD2D_DestroyDeviceObjects()
 {
     ImGui_ImplD2D_Data* backendData = ImGui_ImplD2D_GetBackendData();
+    ImGui_ImplD2D_WaitForRenderThread();
+    // layers are compatible targets of render target
+    ImGui_ImplD2D_DestroyLayerCache(backendData);
+    // geometries belong to factory of render target
+    ImGui_ImplD2D_DestroyGeometryCache(backendData);
+    // contents of new render target are unknown
+    backendData->DirtyTracker.Invalidate();
+    backendData->HasPresentedFingerprint = false;
     backendData->SolidColorBrush.Reset();
     backendData->StrokeStyle.Reset();
+    // packed textures stay valid, their pages are recreated on next render target
+    ImGui_ImplD2D_ReleaseTextureAtlasPages(backendData);
 
     ImGui_ImplD2D_DestroyFontsTexture();
 }
 
+/** @brief Check if font atlas was invalidated or rebuilt since upload, cheap enough to be called every frame */
+inline static bool ImGui_ImplD2D_IsFontAtlasChanged(const ImGui_ImplD2D_Fonts* fonts, const ImFontAtlas* atlas) {
+    if (fonts->FontBitmap == nullptr) {
+        return true;
+    }
+    // fonts were added or cleared, atlas must be built & uploaded again (ImFontAtlas::ClearTexData() keeps it ready)
+    if (!atlas->TexReady) {
+        return true;
+    }
+    const ImGui_ImplD2D_FontAtlasVersion& version = fonts->Version;
+    return version.FontCount != atlas->ConfigData.Size || version.Width != atlas->TexWidth || version.Height != atlas->TexHeight;
+}
+
 bool    ImGui_ImplD2D_CreateFontsTexture() {
     ImGui_ImplD2D_Data* backendData = ImGui_ImplD2D_GetBackendData();
     ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplD2D_Fonts* fonts = backendData->Fonts;
+    if (!ImGui_ImplD2D_IsFontAtlasChanged(fonts, io.Fonts)) {
+        return true;
+    }
+    // font bitmap & font table are used by render thread
+    ImGui_ImplD2D_WaitForRenderThread();
+    if (backendData->RenderTarget == nullptr) {
+        return false;
+    }
+    IMGUI_IMPL_D2D_ZONE("UploadFontAtlas");
+
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    if (pixels == nullptr) {
+        return false;
+    }
+    // RGBA (straight alpha) to BGRA (premultiplied alpha)
+    ImVector<ImU32> converted;
+    converted.resize(width * height);
+    const ImU32* src = (const ImU32*)pixels;
+    for (int i = 0; i < converted.Size; i++) {
+        const ImU32 a = src[i] >> 24;
+        const ImU32 r = ((src[i] >> 0) & 0xFFu) * a / 255u;
+        const ImU32 g = ((src[i] >> 8) & 0xFFu) * a / 255u;
+        const ImU32 b = ((src[i] >> 16) & 0xFFu) * a / 255u;
+        converted[i] = (a << 24) | (r << 16) | (g << 8) | b;
+    }
+
+    const bool fullUpload = fonts->FontBitmap == nullptr || fonts->Version.Width != width || fonts->Version.Height != height;
+    D2D1_RECT_U dirty = D2D1::RectU(0, 0, width, height);
+    if (!fullUpload) {
+        // fonts added at runtime: only upload bounding box of changed pixels
+        dirty = D2D1::RectU(width, height, 0, 0);
+        for (int y = 0; y < height; y++) {
+            const ImU32* prevRow = fonts->Pixels.Data + y * width;
+            const ImU32* currRow = converted.Data + y * width;
+            if (memcmp(prevRow, currRow, width * sizeof(ImU32)) == 0) {
+                continue;
+            }
+            int x0 = 0, x1 = width;
+            while (prevRow[x0] == currRow[x0]) {
+                x0++;
+            }
+            while (prevRow[x1 - 1] == currRow[x1 - 1]) {
+                x1--;
+            }
+            if ((UINT32)x0 < dirty.left) {
+                dirty.left = (UINT32)x0;
+            }
+            if ((UINT32)x1 > dirty.right) {
+                dirty.right = (UINT32)x1;
+            }
+            if ((UINT32)y < dirty.top) {
+                dirty.top = (UINT32)y;
+            }
+            dirty.bottom = (UINT32)y + 1;
+        }
+    }
+
+    HRESULT hr = S_OK;
+    ImGui_ImplD2D_FactoryLock lock(backendData);
+    if (fullUpload) {
+        fonts->FontBitmap.Reset();
+        const D2D1_BITMAP_PROPERTIES props = D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+        hr = backendData->RenderTarget->CreateBitmap(D2D1::SizeU(width, height), converted.Data, width * 4, props, fonts->FontBitmap.GetAddressOf());
+    }
+    else if (dirty.left < dirty.right && dirty.top < dirty.bottom) {
+        hr = fonts->FontBitmap->CopyFromMemory(&dirty, converted.Data + dirty.top * width + dirty.left, width * 4);
+    }
+    if (FAILED(hr)) {
+        return false;
+    }
+    if (dirty.left < dirty.right && dirty.top < dirty.bottom) {
+        fonts->UploadCount++;
+        fonts->UploadBytes += (ImU64)(dirty.right - dirty.left) * (dirty.bottom - dirty.top) * 4;
+    }
+    fonts->Pixels.swap(converted);
+    if (fonts->Data.FontFile == NULL && io.Fonts->Fonts.Size > 0) {
+        // DirectWrite collection is built from data of the default font only
+        const ImFontConfig* configData = io.Fonts->Fonts.Data[0]->ConfigData;
+        fonts->FontFileData.resize(configData->FontDataSize);
+        memcpy(fonts->FontFileData.Data, configData->FontData, (size_t)configData->FontDataSize);
+    }
+    fonts->Version.FontCount = io.Fonts->ConfigData.Size;
+    fonts->Version.Width = width;
+    fonts->Version.Height = height;
+    io.Fonts->SetTexID((ImTextureID)fonts->FontBitmap.Get());
+    backendData->FontTable.Build(io.Fonts);
     return true;
 }
 
@@ -268,8 +647,10 @@ void    ImGui_ImplD2D_DestroyFontsTexture()
     ImGuiIO& io = ImGui::GetIO();
 
     if (backendData->Fonts) {
-        ///  io.Fonts->SetTexID(0);
-
+        backendData->Fonts->FontBitmap.Reset();
+        backendData->Fonts->Pixels.clear();
+        memset(&backendData->Fonts->Version, 0, sizeof(backendData->Fonts->Version));
+        io.Fonts->SetTexID(0);
     }
 }
 
@@ -278,7 +659,13 @@ void     ImGui_ImplD2D_Shutdown() {
     IM_ASSERT(backendData != nullptr && "No renderer backend to shutdown, or already shutdown?");
     ImGuiIO& io = ImGui::GetIO();
 
+    ImGui_ImplD2D_StopRenderThread();
+    ImGui_ImplD2D_EndCapture();
     ImGui_ImplD2D_DestroyDeviceObjects();
+    ImGui_ImplD2D_DestroyTextureAtlas(backendData);
+    IM_DELETE(backendData->Fonts);
+    backendData->FontTable.Clear();
+    backendData->FrameCommands.Clear();
 
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
@@ -290,275 +677,14 @@ void     ImGui_ImplD2D_NewFrame() {
     ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
     IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
     // auto detect new fonts if required
-
-    ImGui_ImplD2D_CreateFontsTexture();
+    if (ImGui_ImplD2D_IsFontAtlasChanged(bd->Fonts, ImGui::GetIO().Fonts)) {
+        ImGui_ImplD2D_CreateFontsTexture();
+    }
 }
-static float ImGui_Impl2D2_ColorMap[256] = {
-    0.0f / 255.0f,
-    1.0f / 255.0f,
-    2.0f / 255.0f,
-    3.0f / 255.0f,
-    4.0f / 255.0f,
-    5.0f / 255.0f,
-    6.0f / 255.0f,
-    7.0f / 255.0f,
-    8.0f / 255.0f,
-    9.0f / 255.0f,
-    10.0f / 255.0f,
-    11.0f / 255.0f,
-    12.0f / 255.0f,
-    13.0f / 255.0f,
-    14.0f / 255.0f,
-    15.0f / 255.0f,
-    16.0f / 255.0f,
-    17.0f / 255.0f,
-    18.0f / 255.0f,
-    19.0f / 255.0f,
-    20.0f / 255.0f,
-    21.0f / 255.0f,
-    22.0f / 255.0f,
-    23.0f / 255.0f,
-    24.0f / 255.0f,
-    25.0f / 255.0f,
-    26.0f / 255.0f,
-    27.0f / 255.0f,
-    28.0f / 255.0f,
-    29.0f / 255.0f,
-    30.0f / 255.0f,
-    31.0f / 255.0f,
-    32.0f / 255.0f,
-    33.0f / 255.0f,
-    34.0f / 255.0f,
-    35.0f / 255.0f,
-    36.0f / 255.0f,
-    37.0f / 255.0f,
-    38.0f / 255.0f,
-    39.0f / 255.0f,
-    40.0f / 255.0f,
-    41.0f / 255.0f,
-    42.0f / 255.0f,
-    43.0f / 255.0f,
-    44.0f / 255.0f,
-    45.0f / 255.0f,
-    46.0f / 255.0f,
-    47.0f / 255.0f,
-    48.0f / 255.0f,
-    49.0f / 255.0f,
-    50.0f / 255.0f,
-    51.0f / 255.0f,
-    52.0f / 255.0f,
-    53.0f / 255.0f,
-    54.0f / 255.0f,
-    55.0f / 255.0f,
-    56.0f / 255.0f,
-    57.0f / 255.0f,
-    58.0f / 255.0f,
-    59.0f / 255.0f,
-    60.0f / 255.0f,
-    61.0f / 255.0f,
-    62.0f / 255.0f,
-    63.0f / 255.0f,
-    64.0f / 255.0f,
-    65.0f / 255.0f,
-    66.0f / 255.0f,
-    67.0f / 255.0f,
-    68.0f / 255.0f,
-    69.0f / 255.0f,
-    70.0f / 255.0f,
-    71.0f / 255.0f,
-    72.0f / 255.0f,
-    73.0f / 255.0f,
-    74.0f / 255.0f,
-    75.0f / 255.0f,
-    76.0f / 255.0f,
-    77.0f / 255.0f,
-    78.0f / 255.0f,
-    79.0f / 255.0f,
-    80.0f / 255.0f,
-    81.0f / 255.0f,
-    82.0f / 255.0f,
-    83.0f / 255.0f,
-    84.0f / 255.0f,
-    85.0f / 255.0f,
-    86.0f / 255.0f,
-    87.0f / 255.0f,
-    88.0f / 255.0f,
-    89.0f / 255.0f,
-    90.0f / 255.0f,
-    91.0f / 255.0f,
-    92.0f / 255.0f,
-    93.0f / 255.0f,
-    94.0f / 255.0f,
-    95.0f / 255.0f,
-    96.0f / 255.0f,
-    97.0f / 255.0f,
-    98.0f / 255.0f,
-    99.0f / 255.0f,
-    100.0f / 255.0f,
-    101.0f / 255.0f,
-    102.0f / 255.0f,
-    103.0f / 255.0f,
-    104.0f / 255.0f,
-    105.0f / 255.0f,
-    106.0f / 255.0f,
-    107.0f / 255.0f,
-    108.0f / 255.0f,
-    109.0f / 255.0f,
-    110.0f / 255.0f,
-    111.0f / 255.0f,
-    112.0f / 255.0f,
-    113.0f / 255.0f,
-    114.0f / 255.0f,
-    115.0f / 255.0f,
-    116.0f / 255.0f,
-    117.0f / 255.0f,
-    118.0f / 255.0f,
-    119.0f / 255.0f,
-    120.0f / 255.0f,
-    121.0f / 255.0f,
-    122.0f / 255.0f,
-    123.0f / 255.0f,
-    124.0f / 255.0f,
-    125.0f / 255.0f,
-    126.0f / 255.0f,
-    127.0f / 255.0f,
-    128.0f / 255.0f,
-    129.0f / 255.0f,
-    130.0f / 255.0f,
-    131.0f / 255.0f,
-    132.0f / 255.0f,
-    133.0f / 255.0f,
-    134.0f / 255.0f,
-    135.0f / 255.0f,
-    136.0f / 255.0f,
-    137.0f / 255.0f,
-    138.0f / 255.0f,
-    139.0f / 255.0f,
-    140.0f / 255.0f,
-    141.0f / 255.0f,
-    142.0f / 255.0f,
-    143.0f / 255.0f,
-    144.0f / 255.0f,
-    145.0f / 255.0f,
-    146.0f / 255.0f,
-    147.0f / 255.0f,
-    148.0f / 255.0f,
-    149.0f / 255.0f,
-    150.0f / 255.0f,
-    151.0f / 255.0f,
-    152.0f / 255.0f,
-    153.0f / 255.0f,
-    154.0f / 255.0f,
-    155.0f / 255.0f,
-    156.0f / 255.0f,
-    157.0f / 255.0f,
-    158.0f / 255.0f,
-    159.0f / 255.0f,
-    160.0f / 255.0f,
-    161.0f / 255.0f,
-    162.0f / 255.0f,
-    163.0f / 255.0f,
-    164.0f / 255.0f,
-    165.0f / 255.0f,
-    166.0f / 255.0f,
-    167.0f / 255.0f,
-    168.0f / 255.0f,
-    169.0f / 255.0f,
-    170.0f / 255.0f,
-    171.0f / 255.0f,
-    172.0f / 255.0f,
-    173.0f / 255.0f,
-    174.0f / 255.0f,
-    175.0f / 255.0f,
-    176.0f / 255.0f,
-    177.0f / 255.0f,
-    178.0f / 255.0f,
-    179.0f / 255.0f,
-    180.0f / 255.0f,
-    181.0f / 255.0f,
-    182.0f / 255.0f,
-    183.0f / 255.0f,
-    184.0f / 255.0f,
-    185.0f / 255.0f,
-    186.0f / 255.0f,
-    187.0f / 255.0f,
-    188.0f / 255.0f,
-    189.0f / 255.0f,
-    190.0f / 255.0f,
-    191.0f / 255.0f,
-    192.0f / 255.0f,
-    193.0f / 255.0f,
-    194.0f / 255.0f,
-    195.0f / 255.0f,
-    196.0f / 255.0f,
-    197.0f / 255.0f,
-    198.0f / 255.0f,
-    199.0f / 255.0f,
-    200.0f / 255.0f,
-    201.0f / 255.0f,
-    202.0f / 255.0f,
-    203.0f / 255.0f,
-    204.0f / 255.0f,
-    205.0f / 255.0f,
-    206.0f / 255.0f,
-    207.0f / 255.0f,
-    208.0f / 255.0f,
-    209.0f / 255.0f,
-    210.0f / 255.0f,
-    211.0f / 255.0f,
-    212.0f / 255.0f,
-    213.0f / 255.0f,
-    214.0f / 255.0f,
-    215.0f / 255.0f,
-    216.0f / 255.0f,
-    217.0f / 255.0f,
-    218.0f / 255.0f,
-    219.0f / 255.0f,
-    220.0f / 255.0f,
-    221.0f / 255.0f,
-    222.0f / 255.0f,
-    223.0f / 255.0f,
-    224.0f / 255.0f,
-    225.0f / 255.0f,
-    226.0f / 255.0f,
-    227.0f / 255.0f,
-    228.0f / 255.0f,
-    229.0f / 255.0f,
-    230.0f / 255.0f,
-    231.0f / 255.0f,
-    232.0f / 255.0f,
-    233.0f / 255.0f,
-    234.0f / 255.0f,
-    235.0f / 255.0f,
-    236.0f / 255.0f,
-    237.0f / 255.0f,
-    238.0f / 255.0f,
-    239.0f / 255.0f,
-    240.0f / 255.0f,
-    241.0f / 255.0f,
-    242.0f / 255.0f,
-    243.0f / 255.0f,
-    244.0f / 255.0f,
-    245.0f / 255.0f,
-    246.0f / 255.0f,
-    247.0f / 255.0f,
-    248.0f / 255.0f,
-    249.0f / 255.0f,
-    250.0f / 255.0f,
-    251.0f / 255.0f,
-    252.0f / 255.0f,
-    253.0f / 255.0f,
-    254.0f / 255.0f,
-    255.0f / 255.0f
-};
 
 inline static D2D1_COLOR_F ImGui_ImplD2D_Color(ImU32 color) {
-    constexpr float norm = 1.0f / 255.0f;
-    const float a = ImGui_Impl2D2_ColorMap[color >> 24 & 0xFFu];
-    const float b = ImGui_Impl2D2_ColorMap[(color >> 16) & 0xFFu];
-    const float g = ImGui_Impl2D2_ColorMap[(color >> 8) & 0xFFu];
-    const float r = ImGui_Impl2D2_ColorMap[(color >> 0) & 0xFFu];
-    return D2D1_COLOR_F{ r, g, b, a };
+    const ImGui_ImplD2D_ColorF col = ImGui_ImplD2D_ConvertColor(color);
+    return D2D1_COLOR_F{ col.r, col.g, col.b, col.a };
 }
 
 inline static D2D1_POINT_2F ImGui_ImplD2D_Point(const ImVec2& point) {
@@ -572,6 +698,7 @@ static bool ImGui_ImplD2D_CreateBrush(
     D2D1_RADIAL_GRADIENT_BRUSH_PROPERTIES& props,
     ID2D1RenderTarget* renderTarget,
     ImVec2 aPos, ImVec2 bPos, ImU32 aCol, ImU32 bCol) {
+    IMGUI_IMPL_D2D_ZONE("CreateRadialGradientBrush");
     props.center = ImGui_ImplD2D_Point(aPos);
     props.gradientOriginOffset = D2D1_POINT_2F{ 0, 0 };
     props.radiusX = abs(aPos.x - bPos.x);
@@ -596,6 +723,7 @@ static bool ImGui_ImplD2D_CreateBrush(
     ID2D1RenderTarget* renderTarget,
     ImVec2 aPos, ImVec2 bPos, ImU32 aCol, ImU32 bCol
 ) {
+    IMGUI_IMPL_D2D_ZONE("CreateLinearGradientBrush");
     props.startPoint = ImGui_ImplD2D_Point(aPos);
     props.endPoint = ImGui_ImplD2D_Point(bPos);
     stops[0U].color = ImGui_ImplD2D_Color(aCol);
@@ -609,111 +737,145 @@ static bool ImGui_ImplD2D_CreateBrush(
     return SUCCEEDED(hr);
 }
 
-/** @brief Return of element is a glayh
-
-    @params RenderTarget The target of rendering
-    @param bd[in]
-    @param io[in]
-    @param pcmd[in]
+/** @brief Direct2D implementation of @see ImGui_ImplD2D_Device
 
-    @returns
-        This function returns number of indicates to skip for it to be rendered
-*/
-static int ImGui_ImplD2D_IsGlyph(ID2D1RenderTarget* renderTarget,
-    ImGui_ImplD2D_Data* backendData, const ImGuiIO& io,
-    const ImDrawCmd* pcmd,
-    const ImDrawVert* vert,
-    const ImDrawIdx* idx,
-    const int offset = 0) {
-    ImTextureID texture = pcmd->GetTexID();
-    if (texture != io.Fonts->TexID) {
-        return 0;
-    }
-    const ImU32 noFont = io.Fonts->Fonts.Size;
-    ImU32 font = noFont; // out of range
-    const ImDrawVert* v0 = vert + idx[offset];
-    if (offset < pcmd->ElemCount) {
-        for (int f = 0; f < io.Fonts->Fonts.Size && font == noFont; ++f) {
-            auto glyphs = io.Fonts->Fonts.Data[f]->Glyphs;
-            const auto uv = v0->uv;
-            for (int c = 0; c < glyphs.size(); c++) {
-                if (uv.x == glyphs[c].U0 && uv.y == glyphs[c].V0 ||
-                    uv.x == glyphs[c].U1 && uv.y == glyphs[c].V1) {
-                    font = f;
-                    break;
-                }
+    Objects returned to the submission code are COM pointers detached from ComPtr, they are released
+    by matching Release* call.
+ */
+struct ImGui_ImplD2D_Direct2DDevice : ImGui_ImplD2D_Device
+{
+    ImGui_ImplD2D_Data* BackendData;
+    /** @brief Target of drawing calls, backend render target unless submitting command buffer elsewhere */
+    ID2D1RenderTarget* RenderTarget;
+    /** @brief Target replaced by layer between BeginLayer() & EndLayer() */
+    ID2D1RenderTarget* LayerParent;
+    /** @brief Framebuffer position of top-left corner of target, non zero while drawing into layer */
+    ImVec2 Origin;
+    ImGui_ImplD2D_ComPtr<ID2D1SolidColorBrush> SolidColorBrush;
+    D2D1_LINEAR_GRADIENT_BRUSH_PROPERTIES LinGradProps;
+    D2D1_RADIAL_GRADIENT_BRUSH_PROPERTIES RadGradProps;
+
+    ImGui_ImplD2D_Direct2DDevice(ImGui_ImplD2D_Data* backendData, ID2D1RenderTarget* renderTarget = nullptr) : BackendData(backendData) {
+        memset(&LinGradProps, 0, sizeof(LinGradProps));
+        memset(&RadGradProps, 0, sizeof(RadGradProps));
+        RenderTarget = renderTarget != nullptr ? renderTarget : backendData->RenderTarget.Get();
+        LayerParent = nullptr;
+        Origin = ImVec2(0, 0);
+        if (RenderTarget == backendData->RenderTarget.Get()) {
+            SolidColorBrush = backendData->SolidColorBrush;
+        }
+        else {
+            // brushes are device dependent resources, other target gets its own
+            HRESULT hr = RenderTarget->CreateSolidColorBrush(D2D1::ColorF(D2D1::ColorF::Black), SolidColorBrush.GetAddressOf());
+            if (FAILED(hr)) {
+                SolidColorBrush.Reset();
             }
         }
     }
-    // not a glpyh
-    if (font == noFont) {
-        return 0;
-    }
-    // contener
-    ImU32 item = 0;
-    int glyphCount = 0;
-    std::vector<int> glyphRun;
-    std::vector<WCHAR> codepointRun;
-    std::vector<ImVec2> codepointPos;
-    std::vector<char> codeRun;
-
-    codepointRun.reserve(255);
-    glyphRun.reserve(255);
-    codepointPos.reserve(255);
-    // get glyphs metadata
-    const auto& fontData = io.Fonts->Fonts.Data[font];
-    auto fontGlyphs = fontData->Glyphs;
-    auto fontScale = io.FontGlobalScale * fontData->Scale;
-    auto fontSize = fontData->FontSize * fontScale;
-    const auto top = (fontData->FontSize - fontData->Ascent) * fontScale;
-    // Each letter is rendered as two polygons (4 vecticles/6 indicates)
-    constexpr int countPerLetter = 6;
-    for (int i = offset, c = 0; i < pcmd->ElemCount && c < fontGlyphs.size(); i += countPerLetter) {
-        const ImDrawVert* v = vert + idx[i];
-        const auto uv = v->uv;
-        for (c = 0; c < fontGlyphs.size(); c++) {
-            const auto& glyph = fontGlyphs[c];
-            if (uv.x == glyph.U0 && uv.y == glyph.V0 ||
-                uv.x == glyph.U1 && uv.y == glyph.V1) {
-                glyphRun.push_back(c);
-                float dist = (glyph.X1 - glyph.X0);
-                ImVec2 pos = { v->pos.x - glyph.X0 * fontScale , v->pos.y - glyph.Y0 * fontScale + top };
-                codepointPos.push_back(pos);
-
-                codepointRun.push_back(fontGlyphs[c].Codepoint);
-                codeRun.push_back(fontGlyphs[c].Codepoint);
-
-                break;
-            }
+
+    void PushAxisAlignedClip(const ImVec4& rect) override {
+        RenderTarget->PushAxisAlignedClip(D2D1::RectF(rect.x, rect.y, rect.z, rect.w), D2D1_ANTIALIAS_MODE_ALIASED);
+    }
+
+    void PopAxisAlignedClip() override {
+        RenderTarget->PopAxisAlignedClip();
+    }
+
+    void SetAntialiasMode(bool aliased) override {
+        RenderTarget->SetAntialiasMode(aliased ? D2D1_ANTIALIAS_MODE_ALIASED : D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
+    }
+
+    void SetTransform(const ImVec2& offset) override {
+        RenderTarget->SetTransform(D2D1::Matrix3x2F::Translation(offset.x - Origin.x, offset.y - Origin.y));
+    }
+
+    void* CreateGeometry(const ImVec2* points, int triangleCount) override {
+        ImGui_ImplD2D_ComPtr<ID2D1PathGeometry> pathGeometry;
+        ImGui_ImplD2D_ComPtr<ID2D1GeometrySink> geometrySink;
+        HRESULT hr = BackendData->Factory->CreatePathGeometry(pathGeometry.GetAddressOf());
+        if (SUCCEEDED(hr)) {
+            hr = pathGeometry->Open(geometrySink.GetAddressOf());
+        }
+        if (FAILED(hr)) {
+            return nullptr;
+        }
+        geometrySink->SetFillMode(D2D1_FILL_MODE_ALTERNATE);
+        geometrySink->SetSegmentFlags(D2D1_PATH_SEGMENT_FORCE_ROUND_LINE_JOIN);
+        for (int i = 0; i < triangleCount * 3; i += 3) {
+            geometrySink->BeginFigure(ImGui_ImplD2D_Point(points[i]), D2D1_FIGURE_BEGIN_FILLED);
+            geometrySink->AddLine(ImGui_ImplD2D_Point(points[i]));
+            geometrySink->AddLine(ImGui_ImplD2D_Point(points[i + 1]));
+            geometrySink->AddLine(ImGui_ImplD2D_Point(points[i + 2]));
+            geometrySink->EndFigure(D2D1_FIGURE_END_CLOSED);
+        }
+        hr = geometrySink->Close();
+        if (FAILED(hr)) {
+            return nullptr;
+        }
+        return pathGeometry.Detach();
+    }
+
+    void ReleaseGeometry(void* geometry) override {
+        ((ID2D1PathGeometry*)geometry)->Release();
+    }
+
+    void SetSolidColor(ImU32 col) override {
+        SolidColorBrush->SetColor(ImGui_ImplD2D_Color(col));
+    }
+
+    void* CreateLinearGradientBrush(const ImVec2& start, const ImVec2& end, ImU32 startCol, ImU32 endCol) override {
+        ImGui_ImplD2D_ComPtr<ID2D1LinearGradientBrush> brush;
+        ImGui_ImplD2D_ComPtr<ID2D1GradientStopCollection> stops;
+        // local, command buffers can be submitted on several threads at once
+        D2D1_GRADIENT_STOP gradientStops[2U] = { { 0.f }, { 1.f } };
+        if (!ImGui_ImplD2D_CreateBrush(brush, gradientStops, stops, LinGradProps, RenderTarget, start, end, startCol, endCol)) {
+            return nullptr;
         }
+        return static_cast<ID2D1Brush*>(brush.Detach());
+    }
+
+    void* CreateRadialGradientBrush(const ImVec2& center, const ImVec2& edge, ImU32 centerCol, ImU32 edgeCol) override {
+        ImGui_ImplD2D_ComPtr<ID2D1RadialGradientBrush> brush;
+        ImGui_ImplD2D_ComPtr<ID2D1GradientStopCollection> stops;
+        D2D1_GRADIENT_STOP gradientStops[2U] = { { 0.f }, { 1.f } };
+        if (!ImGui_ImplD2D_CreateBrush(brush, gradientStops, stops, RadGradProps, RenderTarget, center, edge, centerCol, edgeCol)) {
+            return nullptr;
+        }
+        return static_cast<ID2D1Brush*>(brush.Detach());
+    }
+
+    void ReleaseBrush(void* brush) override {
+        ((ID2D1Brush*)brush)->Release();
+    }
+
+    void FillGeometry(void* geometry, void* brush) override {
+        ID2D1Brush* fill = brush != nullptr ? (ID2D1Brush*)brush : SolidColorBrush.Get();
+        RenderTarget->FillGeometry((ID2D1PathGeometry*)geometry, fill);
     }
-    if (glyphRun.size()) {
-        codepointRun.push_back(0);
-        codeRun.push_back(0);
-        //std::wcerr << codepointRun.data() << std::endl << std::flush;
+
+    void* CreateTextFormat(int font, float fontSize) override {
+        IM_UNUSED(font);
+        ImGui_ImplD2D_Fonts* fonts = BackendData->Fonts;
+        IDWriteFactory5* writeFactory = BackendData->WriteFactory.Get();
         HRESULT hresult = S_OK;
-        // should use smart com object for text format
-        IDWriteTextFormat* textFormat = NULL;
         // create for backend data
-        if (backendData->Fonts->FontInMemoryLoader == NULL) {
-            hresult = backendData->WriteFactory->CreateInMemoryFontFileLoader(&backendData->Fonts->FontInMemoryLoader);
+        if (fonts->FontInMemoryLoader == NULL) {
+            hresult = writeFactory->CreateInMemoryFontFileLoader(&fonts->FontInMemoryLoader);
             if (hresult == S_OK) {
-                hresult = backendData->WriteFactory->RegisterFontFileLoader(backendData->Fonts->FontInMemoryLoader);
+                hresult = writeFactory->RegisterFontFileLoader(fonts->FontInMemoryLoader);
             }
         }
-        if (backendData->Fonts->FontSetBuilder == NULL) {
-            hresult = backendData->WriteFactory->CreateFontSetBuilder(&backendData->Fonts->FontSetBuilder);
+        if (fonts->FontSetBuilder == NULL) {
+            hresult = writeFactory->CreateFontSetBuilder(&fonts->FontSetBuilder);
         }
-        IDWriteInMemoryFontFileLoader* fontLoader = backendData->Fonts->FontInMemoryLoader;
-        if (fontLoader) {
-            auto configData = io.Fonts->Fonts.Data[0]->ConfigData;
-            auto fontDataScale = io.FontGlobalScale * io.Fonts->Fonts.Data[0]->Scale;
-            if (backendData->Fonts->Data.FontFile == NULL) {
-                hresult = backendData->Fonts->FontInMemoryLoader->
-                    CreateInMemoryFontFileReference(backendData->WriteFactory.Get(), configData->FontData, configData->FontDataSize, NULL, &backendData->Fonts->Data.FontFile);
+        if (fonts->FontInMemoryLoader != NULL && fonts->FontFileData.Size > 0) {
+            if (fonts->Data.FontFile == NULL) {
+                // loader copies data without owner object, so snapshot can be replaced by next atlas upload
+                hresult = fonts->FontInMemoryLoader->
+                    CreateInMemoryFontFileReference(writeFactory, fonts->FontFileData.Data, (UINT32)fonts->FontFileData.Size, NULL, &fonts->Data.FontFile);
             }
-            if (backendData->Fonts->Data.FontFile && backendData->Fonts->Data.FontFace == NULL) {
-                hresult = backendData->WriteFactory->CreateFontFaceReference(backendData->Fonts->Data.FontFile, 0, DWRITE_FONT_SIMULATIONS_NONE, &backendData->Fonts->Data.FontFace);
+            if (fonts->Data.FontFile && fonts->Data.FontFace == NULL) {
+                hresult = writeFactory->CreateFontFaceReference(fonts->Data.FontFile, 0, DWRITE_FONT_SIMULATIONS_NONE, &fonts->Data.FontFace);
                 DWRITE_FONT_PROPERTY props[] =
                 {
                     // We're only using names to reference fonts programmatically, so won't worry about localized names.
@@ -721,53 +883,171 @@ static int ImGui_ImplD2D_IsGlyph(ID2D1RenderTarget* renderTarget,
                     { DWRITE_FONT_PROPERTY_ID_FULL_NAME, L"Arial", L"en-US"},
                     { DWRITE_FONT_PROPERTY_ID_WEIGHT, L"400", nullptr}
                 };
-                if (backendData->Fonts->Data.FontFace) {
-                    hresult = backendData->Fonts->FontSetBuilder->AddFontFaceReference(backendData->Fonts->Data.FontFace, props, ARRAYSIZE(props));
-                    backendData->Fonts->FontSetBuilder->CreateFontSet(&backendData->Fonts->FontSet);
+                if (fonts->Data.FontFace) {
+                    hresult = fonts->FontSetBuilder->AddFontFaceReference(fonts->Data.FontFace, props, ARRAYSIZE(props));
+                    fonts->FontSetBuilder->CreateFontSet(&fonts->FontSet);
                 }
-                hresult = backendData->WriteFactory->CreateFontCollectionFromFontSet(backendData->Fonts->FontSet, &backendData->Fonts->FontCollection);
+                hresult = writeFactory->CreateFontCollectionFromFontSet(fonts->FontSet, &fonts->FontCollection);
             }
+        }
+        IDWriteTextFormat* textFormat = NULL;
+        hresult = writeFactory->CreateTextFormat(L"Arial", fonts->FontCollection, DWRITE_FONT_WEIGHT_NORMAL,
+            DWRITE_FONT_STYLE_NORMAL,
+            DWRITE_FONT_STRETCH_NORMAL,
+            fontSize,
+            L"en-US",
+            &textFormat);
+        return SUCCEEDED(hresult) ? textFormat : nullptr;
+    }
 
-            if (backendData->Fonts->Data.FontFace == NULL) {
-                // cannot continue
-
-            }
+    void ReleaseTextFormat(void* format) override {
+        ((IDWriteTextFormat*)format)->Release();
+    }
 
+    void DrawGlyph(void* format, unsigned int codepoint, const ImVec2& pos) override {
+        const D2D1_SIZE_U renderTargetSize = RenderTarget->GetPixelSize();
+        const D2D1_RECT_F rect = D2D1::RectF(pos.x, pos.y, Origin.x + (FLOAT)renderTargetSize.width, Origin.y + (FLOAT)renderTargetSize.height);
+        const WCHAR character = (WCHAR)codepoint;
+        RenderTarget->DrawText(&character, 1, (IDWriteTextFormat*)format, &rect, SolidColorBrush.Get());
+    }
 
+    void DrawImage(ImTextureID texture, const ImVec4& rect, const ImVec2& uv0, const ImVec2& uv1, ImU32 col) override {
+        const ImGui_ImplD2D_AtlasRect* packed = nullptr;
+        ID2D1Bitmap* bitmap = ImGui_ImplD2D_ResolveTexture(BackendData, texture, &packed);
+        if (bitmap == nullptr) {
+            return;
         }
-        if (textFormat == NULL) {
-
-            hresult = backendData->WriteFactory->CreateTextFormat(L"Arial", backendData->Fonts->FontCollection, DWRITE_FONT_WEIGHT_NORMAL,
-                DWRITE_FONT_STYLE_NORMAL,
-                DWRITE_FONT_STRETCH_NORMAL,
-                fontSize,
-                L"en-US",
-                &textFormat);
+        ImVec2 sourceMin = uv0, sourceMax = uv1;
+        if (packed != nullptr) {
+            sourceMin = ImGui_ImplD2D_AtlasRemapUV(*packed, uv0);
+            sourceMax = ImGui_ImplD2D_AtlasRemapUV(*packed, uv1);
         }
-        if (SUCCEEDED(hresult)) {
-            const D2D1_SIZE_U renderTargetSize = renderTarget->GetPixelSize();
-            backendData->SolidColorBrush.Get()->SetColor(ImGui_ImplD2D_Color(v0->col));
-            backendData->RenderTarget->SetTransform(D2D1::Matrix3x2F::Identity());
-
-            for (size_t c = 0; c < codepointRun.size() - 1; c++) {
-                ImVec2 pos = codepointPos[c];
-                const auto& glyph = fontGlyphs[glyphRun[c]];
-                D2D1_RECT_F rect = D2D1::RectF(pos.x, pos.y, renderTargetSize.width, renderTargetSize.height);
-#if defined(UNICODE)
-                bd->RenderTarget->DrawText(codepointRun.data() + c, 1, textFormat, rect, bd->SolidColorBrush.Get());
-#else
-                backendData->RenderTarget->DrawTextA(codepointRun.data() + c, 1, textFormat, &rect, backendData->SolidColorBrush.Get());
-#endif
+        const D2D1_SIZE_F size = bitmap->GetSize();
+        const D2D1_RECT_F source = D2D1::RectF(sourceMin.x * size.width, sourceMin.y * size.height, sourceMax.x * size.width, sourceMax.y * size.height);
+        // DrawBitmap only modulates by opacity, so tint color keeps just its alpha
+        const FLOAT opacity = ((col >> IM_COL32_A_SHIFT) & 0xFF) / 255.0f;
+        RenderTarget->DrawBitmap(bitmap, D2D1::RectF(rect.x, rect.y, rect.z, rect.w), opacity, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, &source);
+    }
+
+    void* CreateLayer(int width, int height) override {
+        // compatible target shares device resources (brushes, font bitmap) with backend render target
+        ID2D1BitmapRenderTarget* layer = nullptr;
+        const D2D1_PIXEL_FORMAT format = D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED);
+        HRESULT hr = RenderTarget->CreateCompatibleRenderTarget(D2D1::SizeF((FLOAT)width, (FLOAT)height), D2D1::SizeU(width, height),
+            format, D2D1_COMPATIBLE_RENDER_TARGET_OPTIONS_NONE, &layer);
+        return SUCCEEDED(hr) ? layer : nullptr;
+    }
+
+    void ReleaseLayer(void* layer) override {
+        ((ID2D1BitmapRenderTarget*)layer)->Release();
+    }
+
+    void BeginLayer(void* layer, const ImVec2& origin) override {
+        IM_ASSERT(LayerParent == nullptr);
+        ID2D1BitmapRenderTarget* target = (ID2D1BitmapRenderTarget*)layer;
+        LayerParent = RenderTarget;
+        RenderTarget = target;
+        Origin = origin;
+        target->BeginDraw();
+        target->Clear(D2D1::ColorF(0, 0, 0, 0));
+        // ClearType needs opaque pixels behind text, layer is transparent, so text of every layer is grayscale
+        target->SetTextAntialiasMode(D2D1_TEXT_ANTIALIAS_MODE_GRAYSCALE);
+        // clip rectangles & geometries are in framebuffer space
+        SetTransform(ImVec2(0, 0));
+    }
 
+    bool EndLayer() override {
+        IM_ASSERT(LayerParent != nullptr);
+        const HRESULT hr = RenderTarget->EndDraw();
+        RenderTarget = LayerParent;
+        LayerParent = nullptr;
+        Origin = ImVec2(0, 0);
+        return SUCCEEDED(hr);
+    }
+
+    void DrawLayer(void* layer, const ImVec2& origin) override {
+        ImGui_ImplD2D_ComPtr<ID2D1Bitmap> bitmap;
+        if (FAILED(((ID2D1BitmapRenderTarget*)layer)->GetBitmap(bitmap.GetAddressOf()))) {
+            return;
+        }
+        const D2D1_SIZE_U size = bitmap->GetPixelSize();
+        RenderTarget->SetTransform(D2D1::Matrix3x2F::Identity());
+        RenderTarget->DrawBitmap(bitmap.Get(), D2D1::RectF(origin.x, origin.y, origin.x + (FLOAT)size.width, origin.y + (FLOAT)size.height),
+            1.0f, D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
+    }
+};
+
+static void ImGui_ImplD2D_DestroyLayerCache(ImGui_ImplD2D_Data* backendData) {
+    ImGui_ImplD2D_Direct2DDevice device(backendData);
+    backendData->LayerCache.Clear(&device);
+}
+
+static void ImGui_ImplD2D_DestroyGeometryCache(ImGui_ImplD2D_Data* backendData) {
+    ImGui_ImplD2D_Direct2DDevice device(backendData);
+    backendData->GeometryCache.Clear(&device);
+}
+
+/** @brief Render target clipped to dirty rectangles: axis aligned clip for one rectangle, layer with geometric mask for more */
+struct ImGui_ImplD2D_DirtyClip
+{
+    ImGui_ImplD2D_ComPtr<ID2D1PathGeometry> Mask;
+    ImGui_ImplD2D_ComPtr<ID2D1Layer> Layer;
+    bool Pushed;
+
+    ImGui_ImplD2D_DirtyClip() : Pushed(false) {}
+
+    /** @brief Whole frame is drawn when mask cannot be created */
+    void Push(ImGui_ImplD2D_Data* backendData, const ImVec4* rects, int count) {
+        ID2D1RenderTarget* renderTarget = backendData->RenderTarget.Get();
+        // rectangles are in framebuffer pixels, clip is transformed when pushed
+        renderTarget->SetTransform(D2D1::Matrix3x2F::Identity());
+        if (count == 1) {
+            renderTarget->PushAxisAlignedClip(D2D1::RectF(rects[0].x, rects[0].y, rects[0].z, rects[0].w), D2D1_ANTIALIAS_MODE_ALIASED);
+            Pushed = true;
+            return;
+        }
+        ImGui_ImplD2D_ComPtr<ID2D1GeometrySink> geometrySink;
+        HRESULT hr = backendData->Factory->CreatePathGeometry(Mask.GetAddressOf());
+        if (SUCCEEDED(hr)) {
+            hr = Mask->Open(geometrySink.GetAddressOf());
+        }
+        if (SUCCEEDED(hr)) {
+            // rectangles do not overlap, so alternate fill mode covers each of them
+            for (int n = 0; n < count; n++) {
+                const ImVec4& rect = rects[n];
+                geometrySink->BeginFigure(ImGui_ImplD2D_Point(ImVec2(rect.x, rect.y)), D2D1_FIGURE_BEGIN_FILLED);
+                geometrySink->AddLine(ImGui_ImplD2D_Point(ImVec2(rect.z, rect.y)));
+                geometrySink->AddLine(ImGui_ImplD2D_Point(ImVec2(rect.z, rect.w)));
+                geometrySink->AddLine(ImGui_ImplD2D_Point(ImVec2(rect.x, rect.w)));
+                geometrySink->EndFigure(D2D1_FIGURE_END_CLOSED);
             }
+            hr = geometrySink->Close();
         }
-        if (textFormat != NULL) {
-            textFormat->Release();
-            textFormat = NULL;
+        if (SUCCEEDED(hr)) {
+            hr = renderTarget->CreateLayer(nullptr, Layer.GetAddressOf());
+        }
+        if (FAILED(hr)) {
+            Mask.Reset();
+            Layer.Reset();
+            return;
         }
+        renderTarget->PushLayer(D2D1::LayerParameters(D2D1::InfiniteRect(), Mask.Get(), D2D1_ANTIALIAS_MODE_ALIASED), Layer.Get());
+        Pushed = true;
     }
-    return glyphRun.size() * countPerLetter;
-}
+
+    void Pop(ImGui_ImplD2D_Data* backendData) {
+        if (!Pushed) {
+            return;
+        }
+        if (Layer != nullptr) {
+            backendData->RenderTarget->PopLayer();
+        }
+        else {
+            backendData->RenderTarget->PopAxisAlignedClip();
+        }
+        Pushed = false;
+    }
+};
 
 #endif // 1
 
@@ -809,245 +1089,360 @@ static bool isLine(const ImVec2& uv, ImVec4* texUvLines, int count = IM_DRAWLIST
     return false;
 }
 
+/** @brief Translate & draw frame, on render thread when it runs */
+static void ImGui_ImplD2D_RenderFrame(ImGui_ImplD2D_Data* backendData, const ImDrawData* drawData, const ImGuiID* listKeys, const ImVector<ImVec4>* clipRects, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_FrameStats* stats) {
+    if (clipRects != nullptr && clipRects->Size == 0) {
+        // nothing changed, previous pixels are still there
+        return;
+    }
+    // draw lists are translated (possibly in parallel) before any Direct2D call, render target is used by this thread only
+    ImGui_ImplD2D_FrameCommands& frameCommands = backendData->FrameCommands;
+    frameCommands.Translate(drawData, params, backendData->ParallelFor, backendData->ParallelForUserData, stats, listKeys);
+    ImGui_ImplD2D_Direct2DDevice direct2DDevice(backendData);
+    ImGui_ImplD2D_Device* device = backendData->SubmitDevice != nullptr ? backendData->SubmitDevice : &direct2DDevice;
+    ImGui_ImplD2D_DirtyClip dirtyClip;
+    if (clipRects != nullptr) {
+        ImGui_ImplD2D_FactoryLock lock(backendData);
+        dirtyClip.Push(backendData, clipRects->Data, clipRects->Size);
+    }
+    ImGui_ImplD2D_LayerCache& layerCache = backendData->LayerCache;
+    ImGui_ImplD2D_GeometryCache* geometryCache = backendData->GeometryCache.IsEnabled() ? &backendData->GeometryCache : nullptr;
+    layerCache.BeginFrame();
+    backendData->GeometryCache.BeginFrame();
+    for (int n = 0; n < frameCommands.Count; n++)
+    {
+        IMGUI_IMPL_D2D_ZONE("SubmitDrawList");
+        // lock per draw list, so resources created on other threads wait for one list at most
+        ImGui_ImplD2D_FactoryLock lock(backendData);
+        if (layerCache.IsEnabled()) {
+            layerCache.Submit(*frameCommands.Lists[n], params.FramebufferSize, device, stats, geometryCache);
+        }
+        else {
+            ImGui_ImplD2D_SubmitCommandList(*frameCommands.Lists[n], device, stats, geometryCache);
+        }
+    }
+    ImGui_ImplD2D_FactoryLock lock(backendData);
+    layerCache.EndFrame(device);
+    if (geometryCache != nullptr) {
+        geometryCache->EndFrame(device);
+    }
+    dirtyClip.Pop(backendData);
+}
+
+/** @brief Render thread entry of each published snapshot */
+static void ImGui_ImplD2D_RenderSnapshot(ImGui_ImplD2D_DrawDataSnapshot* snapshot, void* userData) {
+    IMGUI_IMPL_D2D_ZONE("RenderSnapshot");
+    ImGui_ImplD2D_Data* backendData = (ImGui_ImplD2D_Data*)userData;
+    IMGUI_IMPL_D2D_STAT_TIMER_BEGIN(renderStart);
+    if (backendData->RenderThreadBeginFrame != nullptr) {
+        backendData->RenderThreadBeginFrame(backendData->RenderTarget.Get(), backendData->RenderThreadUserData);
+    }
+    ImGui_ImplD2D_RenderFrame(backendData, &snapshot->DrawData, snapshot->ListKeys.Data, snapshot->ClipToDirtyRects ? &snapshot->DirtyRects : nullptr, snapshot->Params, &snapshot->Stats);
+    if (backendData->RenderThreadEndFrame != nullptr) {
+        backendData->RenderThreadEndFrame(backendData->RenderTarget.Get(), backendData->RenderThreadUserData);
+    }
+    IMGUI_IMPL_D2D_STAT_TIMER_END(snapshot->Stats, RenderTime, renderStart);
+}
+
 void     ImGui_ImplD2D_RenderDrawData(ImDrawData* draw_data) {
+    IMGUI_IMPL_D2D_ZONE("RenderDrawData");
     ImGuiIO& io = ImGui::GetIO();
     ImGui_ImplD2D_Data* backendData = ImGui_ImplD2D_GetBackendData();
+    int fontAtlasUploads = 0;
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    fontAtlasUploads = backendData->Fonts->UploadCount - backendData->FrameStatsUploadCount;
+    backendData->FrameStatsUploadCount = backendData->Fonts->UploadCount;
+#endif
+    IMGUI_IMPL_D2D_STAT_TIMER_BEGIN(renderStart);
+    // font scale can change without rebuilding the atlas
+    backendData->FontTable.UpdateMetrics(io.Fonts);
 
     // Will project scissor/clipping rectangles into framebuffer space
-    ImVec2 clip_off = ImVec2{ 0, 0 };         // (0,0) unless using multi-viewports
-    ImVec2 clip_scale = ImVec2{ 1, 1 };
-    const float fb_width = static_cast<float>(backendData->RenderTarget->GetPixelSize().width);
-    const float fb_height = static_cast<float>(backendData->RenderTarget->GetPixelSize().height);
-
-    D2D1_POINT_2F points2f[3];
-    memset(&points2f, 0, sizeof(points2f));
-    ImGui_ImplD2D_ComPtr<ID2D1BitmapBrush> bitmapBrush;
-    ImGui_ImplD2D_ComPtr<ID2D1PathGeometry> pathGeometry;
-    ImGui_ImplD2D_ComPtr<ID2D1GeometrySink> geometrySink;
-    ImGui_ImplD2D_ComPtr<ID2D1GradientStopCollection> stopsCol;
-    D2D1_RADIAL_GRADIENT_BRUSH_PROPERTIES radGradProps;
-    memset(&radGradProps, 0, sizeof(radGradProps));
-    ImGui_ImplD2D_ComPtr<ID2D1RadialGradientBrush> radGradBrush;
-    D2D1_LINEAR_GRADIENT_BRUSH_PROPERTIES linGradProps;
-    memset(&linGradProps, 0, sizeof(linGradProps));
-    ImGui_ImplD2D_ComPtr<ID2D1LinearGradientBrush> linGradBrush;
+    ImGui_ImplD2D_TranslateParams params;
+    params.Fonts = &backendData->FontTable;
+    params.FontGlobalScale = io.FontGlobalScale;
+    params.ClipOffset = ImVec2{ 0, 0 };         // (0,0) unless using multi-viewports
+    params.ClipScale = ImVec2{ 1, 1 };
+    ImGui_ImplD2D_RenderThread* renderThread = backendData->RenderThread;
+    if (renderThread != nullptr) {
+        // render target belongs to render thread, framebuffer size is derived from draw data
+        params.FramebufferSize = ImVec2{ draw_data->DisplaySize.x * draw_data->FramebufferScale.x, draw_data->DisplaySize.y * draw_data->FramebufferScale.y };
+    }
+    else {
+        const D2D1_SIZE_U renderTargetSize = backendData->RenderTarget->GetPixelSize();
+        params.FramebufferSize = ImVec2{ static_cast<float>(renderTargetSize.width), static_cast<float>(renderTargetSize.height) };
+    }
 
-    HRESULT hr = S_OK;
+    if (backendData->Capture != nullptr) {
+        backendData->Capture->WriteFrame(draw_data, backendData->FontTable, io.FontGlobalScale, params.FramebufferSize);
+    }
+    // rectangles are used by frame they were computed for only
+    const ImVector<ImVec4>* clipRects = backendData->DirtyRectClipping && backendData->DirtyRectsPending ? &backendData->DirtyTracker.Rects : nullptr;
+    backendData->DirtyRectsPending = false;
+    // frame without fingerprint is never reported unchanged
+    backendData->PresentedFingerprint = backendData->PendingFingerprint;
+    backendData->HasPresentedFingerprint = backendData->HasPendingFingerprint;
+    backendData->HasPendingFingerprint = false;
+
+    if (renderThread != nullptr) {
+        ImGui_ImplD2D_DrawDataSnapshot* snapshot = renderThread->Acquire();
+        // statistics are reported once render thread finished frame
+        if (snapshot->Rendered) {
+            backendData->FrameStats = snapshot->Stats;
+            ImGui_ImplD2D_UpdateFactoryLockStats(backendData, &backendData->FrameStats);
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+            backendData->FrameHistory.Add(backendData->FrameStats);
+#endif
+            snapshot->Rendered = false;
+        }
+        snapshot->Copy(draw_data, backendData->FontTable, params);
+        snapshot->ClipToDirtyRects = clipRects != nullptr;
+        if (clipRects != nullptr) {
+            snapshot->DirtyRects = *clipRects;
+        }
+        memset(&snapshot->Stats, 0, sizeof(snapshot->Stats));
+        snapshot->Stats.FontAtlasUploads = fontAtlasUploads;
+        renderThread->Publish(snapshot);
+        return;
+    }
 
-    for (int n = 0; n < draw_data->CmdListsCount; n++)
-    {
-        const ImDrawList* cmd_list = draw_data->CmdLists[n];
-        const ImDrawVert* vtx_buffer = cmd_list->VtxBuffer.Data;
-        const ImDrawIdx* idx_buffer = cmd_list->IdxBuffer.Data;
-        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
-        {
-            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
-            if (pcmd->UserCallback)
-            {
-                // User callback, registered via ImDrawList::AddCallback()
-                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
-                if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
-                    ; //ImGui_ImplSDLRenderer2_SetupRenderState();
-                else
-                    pcmd->UserCallback(cmd_list, pcmd);
-            }
-            else
-            {
-                // Project scissor/clipping rectangles into framebuffer space
-                ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
-                ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
-                if (clip_min.x < 0.0f) { clip_min.x = 0.0f; }
-                if (clip_min.y < 0.0f) { clip_min.y = 0.0f; }
-                if (clip_max.x > (float)fb_width) { clip_max.x = (float)fb_width; }
-                if (clip_max.y > (float)fb_height) { clip_max.y = (float)fb_height; }
-                if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
-                    continue;
-
-                D2D1_RECT_F clip = D2D1::RectF(clip_min.x, clip_min.y, clip_max.x, clip_max.y);
-                backendData->RenderTarget->PushAxisAlignedClip(clip, D2D1_ANTIALIAS_MODE_ALIASED);
-
-                unsigned int indCount = pcmd->ElemCount;
-                if (indCount == 0)
-                {
-                    continue;
-                }
-                const ImDrawVert* vert = vtx_buffer + pcmd->VtxOffset;
-                const ImDrawIdx* idx = idx_buffer + pcmd->IdxOffset;
-                const ImTextureID texture = pcmd->GetTexID();
-                const bool isFontOrLine = texture == io.Fonts->TexID;
-                int idxOffset = 0;
-                pathGeometry.Reset();
-                geometrySink.Reset();
-                int prev = idxOffset;
-                while (idxOffset < indCount) {
-                    prev = idxOffset;
-                    int polygonIndicates = 0;
-                    int polygonColorsCount = 1;
-                    ImDrawIdx prevIdx[3] = { idx[idxOffset + 0], idx[idxOffset + 1], idx[idxOffset + 2] };
-                    ImU32 polygonColors[6] = { (vert + prevIdx[0])->col, 0x0, 0x0, 0x0, 0x0, 0x0 };
-                    for (int i = idxOffset; i < indCount; i += 3) {
-                        ImDrawIdx currIdx[3] = { idx[i], idx[i + 1], idx[i + 2] };
-                        const bool commonIndicateTest =
-                            prevIdx[0] == currIdx[0] || prevIdx[0] == currIdx[1] || prevIdx[0] == currIdx[2] ||
-                            prevIdx[1] == currIdx[0] || prevIdx[1] == currIdx[1] || prevIdx[1] == currIdx[2] ||
-                            prevIdx[2] == currIdx[0] || prevIdx[2] == currIdx[1] || prevIdx[2] == currIdx[2];
-                        if (commonIndicateTest == false) {
-                            break;
-                        }
-                        const ImDrawVert* verts[3] = { vert + currIdx[0], vert + currIdx[1], vert + currIdx[2] };
-                        int currColCount = 0;
-                        const ImU32 currCol[3] = { verts[0]->col, verts[1]->col, verts[2]->col };
-                        int nextPolygonColorsCount = polygonColorsCount;
-                        for (int c = 0; c < 3; c++) {
-                            bool nextColor = true;
-                            for (int p = 0; p < nextPolygonColorsCount; p++) {
-                                if (currCol[c] == polygonColors[p]) {
-                                    nextColor = false;
-                                    break;
-                                }
-                            }
-                            if (nextColor) {
-                                polygonColors[nextPolygonColorsCount] = currCol[c];
-                                nextPolygonColorsCount++;
-                            }
-                        }
-
-                        // only triangles & quads can be renderer with more than one color
-                        if (polygonIndicates > 6 && nextPolygonColorsCount > 1) {
-                            break;
-                        }
-                        const bool isOnePoly = prevIdx[0] == currIdx[0] && prevIdx[2] == currIdx[1];
-                        polygonColorsCount = nextPolygonColorsCount;
-                        memcpy(&prevIdx, &currIdx, sizeof(currIdx));
-                        polygonIndicates += 3;
-                        if (polygonIndicates >= 3 && polygonColorsCount > 2) {
-                            break;
-                        }
-                        if (polygonIndicates == 6 && polygonColorsCount == 2) {
-                            break;
-                        }
-
-                    }
-                    const int idxStart = idxOffset;
-                    idxOffset += polygonIndicates;
-                    // drawing
-                    hr = backendData->Factory->CreatePathGeometry(pathGeometry.GetAddressOf());
-                    if (FAILED(hr))
-                    {
-                        continue;
-                    }
-                    hr = pathGeometry.Get()->Open(geometrySink.GetAddressOf());
-                    if (FAILED(hr))
-                    {
-                        continue;
-                    }
-                    geometrySink.Get()->SetFillMode(D2D1_FILL_MODE_ALTERNATE);
-                    geometrySink.Get()->SetSegmentFlags(D2D1_PATH_SEGMENT_FORCE_ROUND_LINE_JOIN);
-
-                    D2D1_POINT_2F point;
-                    for (int i = idxStart; i < idxOffset; i += 3) {
-                        int o = idx[i];
-                        point.x = (vert + o)->pos.x;
-                        point.y = (vert + o)->pos.y;
-                        geometrySink.Get()->BeginFigure(point, D2D1_FIGURE_BEGIN_FILLED);
-
-                        geometrySink.Get()->AddLine(point);
-                        o = idx[i + 1];
-                        point.x = (vert + o)->pos.x;
-                        point.y = (vert + o)->pos.y;
-                        geometrySink.Get()->AddLine(point);
-                        o = idx[i + 2];
-                        point.x = (vert + o)->pos.x;
-                        point.y = (vert + o)->pos.y;
-                        geometrySink.Get()->AddLine(point);
-                        geometrySink.Get()->EndFigure(D2D1_FIGURE_END_CLOSED);
-                    }
-                    hr = geometrySink.Get()->Close();
-                    geometrySink.Reset();
-                    if (FAILED(hr))
-                    {
-                        continue;
-                    }
-                    const ImDrawVert* verts[4] = {
-                        vert + idx[idxStart],
-                        vert + idx[idxStart + 1],
-                        vert + idx[idxStart + 2],
-                        vert + idx[idxOffset - 1],
-                    };
-                    backendData->RenderTarget->SetAntialiasMode(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
-
-                    if (polygonColorsCount == 1) {
-                        backendData->SolidColorBrush.Get()->SetColor(ImGui_ImplD2D_Color(polygonColors[0]));
-                        int skip = ImGui_ImplD2D_IsGlyph(backendData->RenderTarget.Get(), backendData, io, pcmd, vert, idx, prev);
-                        if (skip == 0) {
-                            backendData->RenderTarget->FillGeometry(pathGeometry.Get(), backendData->SolidColorBrush.Get());
-                        }
-                        else {
-                            idxOffset = prev + skip;
-                        }
-                    }
-                    else if (polygonColorsCount == 2)
-                    {
-                        const ImDrawVert* verts[4] = {
-                            vert + idx[idxStart],
-                            vert + idx[idxStart + 1],
-                            vert + idx[idxStart + 2],
-                            vert + idx[idxOffset - 1],
-                        };
-                        bool success = true;
-                        if (verts[0]->col == verts[3]->col) {
-                            success = ImGui_ImplD2D_CreateBrush(linGradBrush, backendData->GradientStops, stopsCol, linGradProps, backendData->RenderTarget.Get(),
-                                verts[0]->pos, verts[1]->pos, verts[0]->col, verts[1]->col);
-                        }
-                        else {
-                            success = ImGui_ImplD2D_CreateBrush(linGradBrush, backendData->GradientStops, stopsCol, linGradProps, backendData->RenderTarget.Get(),
-                                verts[1]->pos, verts[2]->pos, verts[1]->col, verts[2]->col);
-                        }
-                        if (success) {
-                            backendData->RenderTarget->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
-                            backendData->RenderTarget->FillGeometry(pathGeometry.Get(), linGradBrush.Get());
-                            linGradBrush.Reset();
-                            stopsCol.Reset();
-                        }
-                    }
-                    else if (polygonColorsCount == 3) {
-                        ImVec2 middle;
-                        middle.x = 0.25 * (verts[0]->pos.x + verts[1]->pos.x + verts[2]->pos.x + verts[3]->pos.x);
-                        middle.y = 0.25 * (verts[0]->pos.y + verts[1]->pos.y + verts[2]->pos.y + verts[3]->pos.y);
-                        backendData->RenderTarget->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
-                        if (ImGui_ImplD2D_CreateBrush(radGradBrush, backendData->GradientStops, stopsCol, radGradProps, backendData->RenderTarget.Get(),
-                            verts[0]->pos, verts[2]->pos, verts[0]->col, verts[0]->col & 0x00FFFFFFu)) {
-                            backendData->RenderTarget->FillGeometry(pathGeometry.Get(), radGradBrush.Get());
-                        }
-                        if (ImGui_ImplD2D_CreateBrush(radGradBrush, backendData->GradientStops, stopsCol, radGradProps, backendData->RenderTarget.Get(),
-                            verts[2]->pos, verts[0]->pos, verts[2]->col, verts[2]->col & 0x00FFFFFFu)) {
-                            backendData->RenderTarget->FillGeometry(pathGeometry.Get(), radGradBrush.Get());
-                        }
-                        if (ImGui_ImplD2D_CreateBrush(radGradBrush, backendData->GradientStops, stopsCol, radGradProps, backendData->RenderTarget.Get(),
-                            verts[1]->pos, verts[3]->pos, verts[1]->col, verts[1]->col & 0x00FFFFFFu)) {
-                            backendData->RenderTarget->FillGeometry(pathGeometry.Get(), radGradBrush.Get());
-                        }
-                        if (polygonIndicates > 3 && ImGui_ImplD2D_CreateBrush(radGradBrush, backendData->GradientStops, stopsCol, radGradProps, backendData->RenderTarget.Get(),
-                            verts[3]->pos, verts[1]->pos, verts[3]->col, verts[3]->col & 0x00FFFFFFu)) {
-                            backendData->RenderTarget->FillGeometry(pathGeometry.Get(), radGradBrush.Get());
-                        }
-                        radGradBrush.Reset();
-                        stopsCol.Reset();
-                        // only triangle rendering
-                    }
-                    pathGeometry.Reset();
+    memset(&backendData->FrameStats, 0, sizeof(backendData->FrameStats));
+    backendData->FrameStats.FontAtlasUploads = fontAtlasUploads;
+    ImGui_ImplD2D_RenderFrame(backendData, draw_data, nullptr, clipRects, params, &backendData->FrameStats);
+    IMGUI_IMPL_D2D_STAT_TIMER_END(backendData->FrameStats, RenderTime, renderStart);
+    ImGui_ImplD2D_UpdateFactoryLockStats(backendData, &backendData->FrameStats);
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    backendData->FrameHistory.Add(backendData->FrameStats);
+#endif
+}
 
+bool ImGui_ImplD2D_StartRenderThread(ImGui_ImplD2D_RenderThreadFunc beginFrame, ImGui_ImplD2D_RenderThreadFunc endFrame, void* userData, bool doubleBuffer) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    if (bd->RenderThread != nullptr) {
+        return false;
+    }
+    bd->RenderThreadBeginFrame = beginFrame;
+    bd->RenderThreadEndFrame = endFrame;
+    bd->RenderThreadUserData = userData;
+    bd->RenderThread = IM_NEW(ImGui_ImplD2D_RenderThread)();
+    bd->RenderThread->Start(ImGui_ImplD2D_RenderSnapshot, bd, doubleBuffer);
+    return true;
+}
 
+void ImGui_ImplD2D_StopRenderThread() {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    if (bd == nullptr || bd->RenderThread == nullptr) {
+        return;
+    }
+    bd->RenderThread->Stop();
+    IM_DELETE(bd->RenderThread);
+    bd->RenderThread = nullptr;
+}
 
-                }
-                backendData->RenderTarget->PopAxisAlignedClip();
-            }
-        }
+void ImGui_ImplD2D_WaitForRenderThread() {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    if (bd != nullptr && bd->RenderThread != nullptr) {
+        bd->RenderThread->WaitIdle();
     }
+}
+
+void ImGui_ImplD2D_SetSubmitDevice(ImGui_ImplD2D_Device* device) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    // render thread submits to the same device
+    ImGui_ImplD2D_WaitForRenderThread();
+    bd->SubmitDevice = device;
+}
 
+void ImGui_ImplD2D_SetParallelFor(ImGui_ImplD2D_ParallelForFunc parallelFor, void* userData) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    bd->ParallelFor = parallelFor;
+    bd->ParallelForUserData = userData;
+}
+
+void ImGui_ImplD2D_SetDrawListReuse(bool enabled) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    // render thread translates with the same command lists
+    ImGui_ImplD2D_WaitForRenderThread();
+    bd->FrameCommands.ReuseUnchanged = enabled;
 }
 
-ID2D1Bitmap* ImGui_Impl2D2_CreateTexture(ID2D1RenderTarget* renderTarget, IWICImagingFactory* WICFactory, IWICBitmapSource* source) {
+void ImGui_ImplD2D_EnableWindowCache(size_t memoryBudget) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    // render thread draws with the same layers
+    ImGui_ImplD2D_WaitForRenderThread();
+    if (memoryBudget == 0) {
+        ImGui_ImplD2D_DestroyLayerCache(bd);
+    }
+    bd->LayerCache.Budget = (ImU64)memoryBudget;
+    bd->FrameCommands.HashLists = memoryBudget > 0;
+}
+
+int ImGui_ImplD2D_ComputeDirtyRects(const ImDrawData* draw_data, const ImVec4** out_rects, int max_rects) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    IM_ASSERT(draw_data != nullptr && out_rects != nullptr && max_rects > 0);
+    // tracker is only used by thread rendering draw data, render thread gets copy of rectangles
+    if (bd->DirtyTrackerUploadCount != bd->Fonts->UploadCount) {
+        bd->DirtyTrackerUploadCount = bd->Fonts->UploadCount;
+        bd->DirtyTracker.Invalidate();
+    }
+    // text is recognized & its DirectWrite margin sized with metrics ImGui_ImplD2D_RenderDrawData() will translate with
+    ImGuiIO& io = ImGui::GetIO();
+    bd->FontTable.UpdateMetrics(io.Fonts);
+    const int count = bd->DirtyTracker.Compute(draw_data, &bd->FontTable, io.FontGlobalScale, max_rects);
+    bd->DirtyRectsPending = true;
+    *out_rects = bd->DirtyTracker.Rects.Data;
+    return count;
+}
+
+bool ImGui_ImplD2D_IsFrameUnchanged(const ImDrawData* draw_data) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    IM_ASSERT(draw_data != nullptr);
+    // new atlas pixels & resized render target change output of the same draw data
+    ImU64 seed = (ImU64)bd->Fonts->UploadCount;
+    if (bd->RenderThread == nullptr) {
+        const D2D1_SIZE_U renderTargetSize = bd->RenderTarget->GetPixelSize();
+        seed = seed * 31 + renderTargetSize.width;
+        seed = seed * 31 + renderTargetSize.height;
+    }
+    bd->HasPendingFingerprint = ImGui_ImplD2D_HashDrawData(draw_data, seed, &bd->PendingFingerprint);
+    return bd->HasPendingFingerprint && bd->HasPresentedFingerprint && bd->PendingFingerprint == bd->PresentedFingerprint;
+}
+
+void ImGui_ImplD2D_SetDirtyRectClipping(bool enabled) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    bd->DirtyRectClipping = enabled;
+}
+
+void ImGui_ImplD2D_EnableGeometryCache(int maxGeometries) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    // render thread draws with the same geometries
+    ImGui_ImplD2D_WaitForRenderThread();
+    if (maxGeometries <= 0) {
+        ImGui_ImplD2D_DestroyGeometryCache(bd);
+    }
+    bd->GeometryCache.MaxEntries = maxGeometries > 0 ? maxGeometries : 0;
+}
+
+void ImGui_ImplD2D_SetOcclusionCulling(bool enabled) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    // render thread translates with the same command lists
+    ImGui_ImplD2D_WaitForRenderThread();
+    bd->FrameCommands.OcclusionCulling = enabled;
+}
+
+ImGui_ImplD2D_CommandBuffer* ImGui_ImplD2D_BuildCommandBuffer(const ImDrawData* draw_data, ImGui_ImplD2D_CommandBuffer* reuse) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    IM_ASSERT(draw_data != nullptr);
+    ImGuiIO& io = ImGui::GetIO();
+    bd->FontTable.UpdateMetrics(io.Fonts);
+
+    // render target may belong to other thread, framebuffer size is derived from draw data
+    ImGui_ImplD2D_TranslateParams params;
+    params.Fonts = &bd->FontTable;
+    params.FontGlobalScale = io.FontGlobalScale;
+    params.ClipOffset = ImVec2{ 0, 0 };
+    params.ClipScale = ImVec2{ 1, 1 };
+    params.FramebufferSize = ImVec2{ draw_data->DisplaySize.x * draw_data->FramebufferScale.x, draw_data->DisplaySize.y * draw_data->FramebufferScale.y };
+
+    ImGui_ImplD2D_CommandBuffer* buffer = reuse != nullptr ? reuse : IM_NEW(ImGui_ImplD2D_CommandBuffer)();
+    buffer->Frame.OcclusionCulling = bd->FrameCommands.OcclusionCulling;
+    buffer->Build(draw_data, params, bd->ParallelFor, bd->ParallelForUserData);
+    return buffer;
+}
+
+void ImGui_ImplD2D_Submit(const ImGui_ImplD2D_CommandBuffer* buffer, ImGui_ImplD2D_RenderTarget* renderTarget) {
+    IMGUI_IMPL_D2D_ZONE("SubmitCommandBuffer");
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    IM_ASSERT(buffer != nullptr);
+    ImGui_ImplD2D_FrameStats stats;
+    memset(&stats, 0, sizeof(stats));
+    ImGui_ImplD2D_Direct2DDevice device(bd, renderTarget);
+    if (device.SolidColorBrush == nullptr) {
+        // target could not create its brush, nothing can be drawn
+        return;
+    }
+    for (int n = 0; n < buffer->Frame.Count; n++)
+    {
+        ImGui_ImplD2D_FactoryLock lock(bd);
+        ImGui_ImplD2D_SubmitCommandList(*buffer->Frame.Lists[n], &device, &stats);
+    }
+}
+
+void ImGui_ImplD2D_DestroyCommandBuffer(ImGui_ImplD2D_CommandBuffer* buffer) {
+    if (buffer != nullptr) {
+        IM_DELETE(buffer);
+    }
+}
+
+void ImGui_ImplD2D_EnableTextureAtlas(int pageSize, int maxImageSize) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    if (pageSize <= 0) {
+        // already packed textures stay valid
+        bd->TextureAtlasEnabled = false;
+        return;
+    }
+    IM_ASSERT((bd->TextureAtlasPages.empty() || bd->TextureAtlas.PageWidth == pageSize) && "Texture atlas page size cannot be changed once textures were packed");
+    if (bd->TextureAtlasPages.empty()) {
+        bd->TextureAtlas.Init(pageSize, maxImageSize);
+    }
+    bd->TextureAtlas.MaxImageSize = maxImageSize;
+    bd->TextureAtlasEnabled = true;
+}
+
+/** @brief Copy image into texture atlas page
+
+    Pixels are kept in memory, page bitmap is updated when it exists & created when first drawn otherwise.
+
+    @param source Image in 32bppPBGRA format
+
+    @returns
+        This function returns handle of packed texture or null when image could not be packed
+ */
+static ImTextureID ImGui_ImplD2D_AtlasTexture(ImGui_ImplD2D_Data* backendData, IWICBitmapSource* source, UINT width, UINT height) {
+    ImGui_ImplD2D_AtlasPacker& atlas = backendData->TextureAtlas;
+    ImGui_ImplD2D_AtlasRect rect;
+    if (!atlas.Pack((int)width, (int)height, &rect)) {
+        return nullptr;
+    }
+    const int pitch = atlas.PageWidth * 4;
+    const size_t pageBytes = (size_t)pitch * atlas.PageHeight;
+    if ((int)backendData->TextureAtlasPages.size() <= rect.Page) {
+        // new page is cleared (resize value-initializes) so padding around images stays transparent
+        backendData->TextureAtlasPages.resize((size_t)rect.Page + 1, nullptr);
+        backendData->TextureAtlasPixels.resize(backendData->TextureAtlasPages.size() * pageBytes);
+    }
+    BYTE* pixels = backendData->TextureAtlasPixels.data() + rect.Page * pageBytes + rect.Y * pitch + rect.X * 4;
+    // rows are written at page pitch, last one only as wide as image
+    HRESULT hr = source->CopyPixels(NULL, pitch, (UINT)((height - 1) * pitch + width * 4), pixels);
+    ID2D1Bitmap* page = backendData->TextureAtlasPages[rect.Page];
+    if (SUCCEEDED(hr) && page != nullptr) {
+        const D2D1_RECT_U dst = D2D1::RectU(rect.X, rect.Y, rect.X + width, rect.Y + height);
+        hr = page->CopyFromMemory(&dst, pixels, pitch);
+    }
+    if (FAILED(hr)) {
+        return nullptr;
+    }
+    ImGui_ImplD2D_AtlasImage* image = new ImGui_ImplD2D_AtlasImage();
+    image->Rect = rect;
+    backendData->TextureAtlasImages.insert(backendData->TextureAtlasImages.begin() + ImGui_ImplD2D_LowerBoundAtlasImage(backendData, (ImTextureID)image), image);
+    return (ImTextureID)image;
+}
+
+ImTextureID ImGui_Impl2D2_CreateTexture(ID2D1RenderTarget* renderTarget, IWICImagingFactory* WICFactory, IWICBitmapSource* source) {
+    IMGUI_IMPL_D2D_ZONE("UploadTexture");
     ImGui_ImplD2D_ComPtr<IWICFormatConverter> pConverter;
     HRESULT hr = S_OK;
     if (SUCCEEDED(hr))
@@ -1068,12 +1463,36 @@ ID2D1Bitmap* ImGui_Impl2D2_CreateTexture(ID2D1RenderTarget* renderTarget, IWICIm
             WICBitmapPaletteTypeMedianCut
         );
     }
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IWICBitmapSource* converted = pConverter.Get();
+    ImGui_ImplD2D_ComPtr<IWICBitmap> decoded;
+    if (SUCCEEDED(hr) && bd != nullptr && bd->Multithread != nullptr) {
+        // converter decodes lazily, decode before taking the lock so other threads are not blocked by it
+        hr = WICFactory->CreateBitmapFromSource(pConverter.Get(), WICBitmapCacheOnLoad, decoded.GetAddressOf());
+        converted = decoded.Get();
+    }
+    else {
+        // single threaded factory: render target must not be used by render thread meanwhile
+        ImGui_ImplD2D_WaitForRenderThread();
+    }
+    ImGui_ImplD2D_FactoryLock lock(bd);
+    if (SUCCEEDED(hr) && bd != nullptr && bd->TextureAtlasEnabled)
+    {
+        // small images are packed, the rest falls back to standalone bitmap
+        UINT width = 0, height = 0;
+        if (SUCCEEDED(converted->GetSize(&width, &height)) && bd->TextureAtlas.CanPack((int)width, (int)height)) {
+            ImTextureID packed = ImGui_ImplD2D_AtlasTexture(bd, converted, width, height);
+            if (packed != nullptr) {
+                return packed;
+            }
+        }
+    }
     ID2D1Bitmap* texture = nullptr;
     if (SUCCEEDED(hr))
     {
         //create a Direct2D bitmap from the WIC bitmap.
         hr = renderTarget->CreateBitmapFromWicBitmap(
-            pConverter.Get(),
+            converted,
             NULL,
             &texture
         );
@@ -1112,7 +1531,13 @@ ImTextureID ImGui_ImplD2D_LoadTextureRgb32(ID2D1RenderTarget* renderTarget, IWIC
     return ImGui_Impl2D2_CreateTexture(renderTarget, WICFactory, raw.Get());
 }
 
+/** @brief Largest encoded image accepted by ImGui_ImplD2D_LoadTexture(), size of WIC memory stream is a DWORD */
+static const size_t ImGui_ImplD2D_MaxImageDataSize = 0xFFFFFFFFu;
+
 ImTextureID ImGui_ImplD2D_LoadTexture(ID2D1RenderTarget* renderTarget, IWICImagingFactory* imagingFactory, const void* imageData, size_t imageDataSize) {
+    if (imageDataSize > ImGui_ImplD2D_MaxImageDataSize) {
+        return nullptr;
+    }
     ImGui_ImplD2D_ComPtr<IWICBitmapDecoder> pDecoder;
     ImGui_ImplD2D_ComPtr<IWICStream> stream;
     HRESULT hr = S_OK;
@@ -1126,7 +1551,7 @@ ImTextureID ImGui_ImplD2D_LoadTexture(ID2D1RenderTarget* renderTarget, IWICImagi
         // Initialize the stream with the memory pointer and size.
         hr = stream->InitializeFromMemory(
             (WICInProcPointer)imageData,
-            imageDataSize
+            (DWORD)imageDataSize
         );
     }
     if (SUCCEEDED(hr))
@@ -1139,5 +1564,115 @@ ImTextureID ImGui_ImplD2D_LoadTexture(ID2D1RenderTarget* renderTarget, IWICImagi
             pDecoder.GetAddressOf()
         );
     }
+    if (FAILED(hr)) {
+        // not an image (or unsupported format)
+        return nullptr;
+    }
     return ImGui_ImplD2D_CreateTexture(renderTarget, imagingFactory, pDecoder.Get());
 }
+
+ImTextureID ImGui_ImplD2D_LoadTexture(ID2D1RenderTarget* renderTarget, IWICImagingFactory* imagingFactory, const char* filename) {
+    ImGui_ImplD2D_MappedFile file;
+    if (!file.Open(filename, ImGui_ImplD2D_MaxImageDataSize)) {
+        return nullptr;
+    }
+    // decoder reads straight from the mapped view, bitmap is fully decoded before returning
+    ImTextureID texture = ImGui_ImplD2D_LoadTexture(renderTarget, imagingFactory, file.Data, file.Size);
+    file.Close();
+    return texture;
+}
+
+const ImGui_ImplD2D_FrameStats* ImGui_ImplD2D_GetFrameStats() {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    return &bd->FrameStats;
+}
+
+bool ImGui_ImplD2D_BeginCapture(const char* filename) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    ImGui_ImplD2D_EndCapture();
+    ImGui_ImplD2D_CaptureWriter* capture = IM_NEW(ImGui_ImplD2D_CaptureWriter)();
+    if (!capture->Open(filename)) {
+        IM_DELETE(capture);
+        return false;
+    }
+    bd->Capture = capture;
+    return true;
+}
+
+void ImGui_ImplD2D_EndCapture() {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    if (bd->Capture != nullptr) {
+        IM_DELETE(bd->Capture);
+        bd->Capture = nullptr;
+    }
+}
+
+void ImGui_ImplD2D_ShowMetricsWindow(bool* p_open) {
+    ImGui_ImplD2D_Data* bd = ImGui_ImplD2D_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplD2D_Init()?");
+    if (!ImGui::Begin("Direct2D Backend Metrics", p_open)) {
+        ImGui::End();
+        return;
+    }
+#ifdef IMGUI_IMPL_D2D_DISABLE_STATS
+    ImGui::TextUnformatted("Statistics are disabled (IMGUI_IMPL_D2D_DISABLE_STATS)");
+#else
+    const ImGui_ImplD2D_FrameHistory& history = bd->FrameHistory;
+    const ImGui_ImplD2D_FrameStats& stats = bd->FrameStats;
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "p50 %.3f ms  p95 %.3f ms  p99 %.3f ms",
+        history.GetTimePercentile(0.50f), history.GetTimePercentile(0.95f), history.GetTimePercentile(0.99f));
+    ImGui::Text("Backend frame time, last %d frames", history.Count);
+    ImGui::PlotHistogram("##times", history.Times, history.Count, history.GetOffset(), overlay, 0.0f, FLT_MAX, ImVec2(0, 80));
+    ImGui::PlotLines("Calls", history.Calls, history.Count, history.GetOffset(), nullptr, 0.0f, FLT_MAX, ImVec2(0, 40));
+
+    if (ImGui::CollapsingHeader("Direct2D calls (last frame)", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("Geometries created: %d", stats.GeometriesCreated);
+        if (bd->GeometryCache.IsEnabled()) {
+            ImGui::Text("Geometries reused:  %d (%d of %d cached)", stats.GeometriesReused, bd->GeometryCache.Entries.Size, bd->GeometryCache.MaxEntries);
+        }
+        ImGui::Text("Brushes created:    %d", stats.BrushesCreated);
+        ImGui::Text("FillGeometry:       %d", stats.FillGeometryCalls);
+        ImGui::Text("DrawText:           %d", stats.DrawTextCalls);
+        ImGui::Text("DrawBitmap:         %d", stats.DrawBitmapCalls);
+        ImGui::Text("Clip push & pop:    %d (%d skipped)", stats.ClipCalls, stats.ClipsSkipped);
+    }
+    if (ImGui::CollapsingHeader("Polygons (last frame)", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("Solid: %d, linear gradient: %d, radial gradient: %d, glyphs: %d",
+            stats.SolidPolygons, stats.LinearGradientPolygons, stats.RadialGradientPolygons, stats.Glyphs);
+        ImGui::Text("Culled outside of clip: %d, draw commands occluded: %d", stats.PrimitivesCulled, stats.DrawCommandsOccluded);
+        ImGui::Text("Time: classify %.3f ms, glyphs %.3f ms, submit %.3f ms",
+            stats.ClassifyTime / 1000000.0, stats.GlyphTime / 1000000.0, stats.SubmitTime / 1000000.0);
+        const int drawLists = stats.DrawListsTranslated + stats.DrawListsReused;
+        ImGui::Text("Draw lists: %d translated, %d reused (%.0f%%)", stats.DrawListsTranslated, stats.DrawListsReused,
+            drawLists > 0 ? 100.0 * stats.DrawListsReused / drawLists : 0.0);
+        if (bd->LayerCache.IsEnabled()) {
+            ImGui::Text("Window cache: %d drawn, %d reused, %.1f / %.1f MB", stats.LayersDrawn, stats.LayersReused,
+                bd->LayerCache.UsedBytes / (1024.0 * 1024.0), bd->LayerCache.Budget / (1024.0 * 1024.0));
+        }
+    }
+    if (ImGui::CollapsingHeader("Factory lock (last frame)")) {
+        if (bd->Multithread == nullptr) {
+            ImGui::TextUnformatted("Single threaded factory, no locking");
+        }
+        else {
+            ImGui::Text("Sections: %d, wait %.3f ms, hold %.3f ms", stats.FactoryLocks,
+                stats.FactoryLockWaitTime / 1000000.0, stats.FactoryLockHoldTime / 1000000.0);
+        }
+    }
+#endif
+    if (ImGui::CollapsingHeader("Textures", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const ImGui_ImplD2D_Fonts* fonts = bd->Fonts;
+        const ImU64 fontBytes = (ImU64)fonts->Version.Width * fonts->Version.Height * 4;
+        ImGui::Text("Font atlas: %d x %d, %.1f KB (+%.1f KB CPU copy)", fonts->Version.Width, fonts->Version.Height,
+            fontBytes / 1024.0, fonts->Pixels.size_in_bytes() / 1024.0);
+        ImGui::Text("Font atlas uploads: %d, %.1f KB total", fonts->UploadCount, fonts->UploadBytes / 1024.0);
+        const ImU64 pageBytes = (ImU64)bd->TextureAtlas.PageWidth * bd->TextureAtlas.PageHeight * 4;
+        ImGui::Text("Texture atlas: %d pages, %.1f KB, %d packed textures", (int)bd->TextureAtlasPages.size(),
+            bd->TextureAtlasPages.size() * pageBytes / 1024.0, (int)bd->TextureAtlasImages.size());
+    }
+    ImGui::End();
+}
@@ -3,11 +3,13 @@
 
 // Implemented features:
 //  [x] Init: Initialize/shutdown context
+//  [x] Font: Font atlas uploaded to bitmap, only when atlas changes
 //  [ ] Font: Custom font builder for Direct Write
 //  [ ] Renderer: Render fonts using Direct Write
 //  [x] Renderer: Render single color triangles
 //  [x] Renderer: Render triangles with gradient
 //  [ ] Renderer: Render triangles with texture
+//  [x] Renderer: Render axis aligned textured quads (ImGui::Image()) as bitmaps, tint color applies its alpha only
 
 // You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -24,6 +26,7 @@
 struct ID2D1RenderTarget;
 struct IDWriteFactory;
 struct IDWriteFactory5;
+struct IWICImagingFactory;
 
 using ImGui_ImplD2D_RenderTarget = ID2D1RenderTarget;
 using ImGui_ImplD2D_WriteFactory = IDWriteFactory5;
@@ -40,6 +43,7 @@ IMGUI_IMPL_API void     ImGui_ImplD2D_RenderDrawData(ImDrawData* draw_data);
 IMGUI_IMPL_API bool		ImGui_ImplD2D_FontBuilder_Build(ImFontAtlas* atlas);
 
 // Called by Init/NewFrame/Shutdown
+// Font atlas is uploaded once per atlas build, after fonts are added at runtime only the changed area is uploaded again
 IMGUI_IMPL_API bool     ImGui_ImplD2D_CreateFontsTexture();
 /** @brief Destroy texture fonts assets
  */
@@ -48,6 +52,233 @@ IMGUI_IMPL_API void     ImGui_ImplD2D_DestroyDeviceObjects();
 IMGUI_IMPL_API bool     ImGui_ImplD2D_CreateDeviceObjects(ImGui_ImplD2D_RenderTarget* renderTarget);
 
 /** @brief Utility for loading textures
+
+    Returned texture id can be passed directly to ImGui::Image(), texture is owned by the caller unless it was
+    packed into texture atlas (see @see ImGui_ImplD2D_EnableTextureAtlas).
+    When render target was created by multithreaded factory (D2D1_FACTORY_TYPE_MULTI_THREADED) textures can be loaded
+    on any thread: image is decoded without lock, only upload is done inside ID2D1Multithread lock.
+ */
+IMGUI_IMPL_API ImTextureID ImGui_ImplD2D_LoadTexture(ImGui_ImplD2D_RenderTarget* renderTarget, IWICImagingFactory* imagingFactory, const void* imageData, size_t imageDataSize);
+/** @brief Load texture from image file (UTF-8 path)
+
+    File is memory mapped and decoded in place, so it is never read into heap memory as a whole. Files larger
+    than 4 GiB are rejected (WIC memory stream size is 32 bit).
+ */
+IMGUI_IMPL_API ImTextureID ImGui_ImplD2D_LoadTexture(ImGui_ImplD2D_RenderTarget* renderTarget, IWICImagingFactory* imagingFactory, const char* filename);
+IMGUI_IMPL_API ImTextureID ImGui_ImplD2D_LoadTextureRgb32(ImGui_ImplD2D_RenderTarget* renderTarget, IWICImagingFactory* imagingFactory, const void* image, int width, int height, int stride, size_t size);
+
+/** @brief Pack small textures into shared bitmap pages (opt-in, requires ImGui_ImplD2D_Init())
+
+    Textures loaded after this call with both sides not larger than @p maxImageSize are copied into
+    @p pageSize x @p pageSize pages. Returned texture id is a handle to the sub-rectangle of a page, texture
+    coordinates are remapped by the renderer, so it can be used exactly like any other texture id.
+    Packed textures are released by ImGui_ImplD2D_Shutdown() & stay valid when device objects are recreated, pages
+    are rebuilt from pixels kept in memory. Pass zero @p pageSize to disable packing.
+ */
+IMGUI_IMPL_API void     ImGui_ImplD2D_EnableTextureAtlas(int pageSize = 1024, int maxImageSize = 64);
+
+/** @brief Job system hook, must call @p job once for each index in [0, @p count) and return when all calls finished
+
+    Calls can run in any order on any thread. @p userData is the pointer given to ImGui_ImplD2D_SetParallelFor().
+ */
+typedef void (*ImGui_ImplD2D_ParallelForFunc)(int count, void (*job)(int index, void* jobData), void* jobData, void* userData);
+
+/** @brief Translate draw lists of ImGui_ImplD2D_RenderDrawData() in parallel (opt-in, requires ImGui_ImplD2D_Init())
+
+    Each draw list is classified into its own command buffer by @p parallelFor jobs, Direct2D calls are still issued
+    serially from the calling thread afterwards. Jobs only read draw data & backend font table, command buffers are
+    grown to fit each draw list on the calling thread beforehand, so jobs never call ImGui allocator (default one counts
+    allocations in ImGui context without synchronization). Pass null to translate serially.
+ */
+IMGUI_IMPL_API void     ImGui_ImplD2D_SetParallelFor(ImGui_ImplD2D_ParallelForFunc parallelFor, void* userData = nullptr);
+
+/** @brief Keep commands of draw lists that did not change since previous frame (opt-in, requires ImGui_ImplD2D_Init())
+
+    Vertex, index & command buffers of each draw list are hashed, window whose draw list & translation parameters
+    (font scale, framebuffer size...) hash the same as in previous frame is not translated again. Draw lists with user
+    callbacks are always translated. Reused & translated lists are counted in ImGui_ImplD2D_FrameStats.
+ */
+IMGUI_IMPL_API void     ImGui_ImplD2D_SetDrawListReuse(bool enabled);
+
+/** @brief Render each draw list (window) into its own offscreen bitmap & composite bitmaps (opt-in, requires ImGui_ImplD2D_Init())
+
+    Bitmap of draw list is drawn again only when draw list hash changes (see ImGui_ImplD2D_SetDrawListReuse()), so
+    static windows cost single DrawBitmap() per frame. Bitmaps of all windows use at most @p memoryBudget bytes
+    (4 per pixel), least recently used bitmaps are released to make room, windows that do not fit are drawn directly.
+    Draw lists with user callbacks are always drawn directly. Pass zero to disable & release bitmaps.
+
+    Bitmaps are transparent, so text of cached windows is antialiased in grayscale, while text of windows drawn
+    directly keeps text antialias mode of render target (ClearType by default).
+ */
+IMGUI_IMPL_API void     ImGui_ImplD2D_EnableWindowCache(size_t memoryBudget = 64 * 1024 * 1024);
+
+/** @brief Draw data would draw the same pixels as frame last drawn by ImGui_ImplD2D_RenderDrawData()
+
+    Call after ImGui::Render() & before ImGui_ImplD2D_RenderDrawData() of the same frame. Fingerprint (hash of display
+    rectangle & all vertex, index & command buffers) is compared with the one of last drawn frame, application can
+    skip BeginDraw()/Clear()/ImGui_ImplD2D_RenderDrawData()/EndDraw()/Present() when it returns true. Frames with user
+    callbacks, first frame, frames after font atlas upload or device objects recreation & frames drawn without calling
+    this function first are never unchanged. Hashing costs a small fraction of translation (see benchmark --frame-skip).
+ */
+IMGUI_IMPL_API bool     ImGui_ImplD2D_IsFrameUnchanged(const ImDrawData* draw_data);
+
+/** @brief Framebuffer areas that changed since previous call, e.g. for IDXGISwapChain1::Present1() dirty rectangles
+
+    Call after ImGui::Render() & before ImGui_ImplD2D_RenderDrawData() of the same frame. Bounds of each draw
+    command within its clip rectangle (grown by largest font size for commands drawn with font atlas, as DirectWrite
+    glyphs reach past atlas quads) are compared with previous frame, areas of commands that appeared, disappeared
+    or changed are merged into at most @p max_rects non overlapping rectangles (x1, y1, x2, y2 in framebuffer pixels)
+    stored in @p out_rects until next call. Returns zero when nothing changed. Whole framebuffer is dirty on first
+    call, after framebuffer resize, font atlas upload or device objects recreation. User callbacks are always dirty.
+ */
+IMGUI_IMPL_API int      ImGui_ImplD2D_ComputeDirtyRects(const ImDrawData* draw_data, const ImVec4** out_rects, int max_rects = 8);
+/** @brief Restrict drawing of ImGui_ImplD2D_RenderDrawData() to rectangles of ImGui_ImplD2D_ComputeDirtyRects() (opt-in)
+
+    Only applies to frames ImGui_ImplD2D_ComputeDirtyRects() was called for, nothing is drawn when it returned zero.
+    Application must only clear dirty rectangles too & keep render target contents between frames (e.g. flip model
+    swap chain presented with dirty rectangles), since pixels outside of them are not drawn again.
+ */
+IMGUI_IMPL_API void     ImGui_ImplD2D_SetDirtyRectClipping(bool enabled);
+
+/** @brief Keep path geometries of polygons across frames, keyed by shape regardless of position (opt-in, requires ImGui_ImplD2D_Init())
+
+    Geometry is built from points relative to first point of polygon & drawn with transform moving it there, so
+    shapes of scrolled or moved windows are drawn from cache instead of creating geometry again. At most
+    @p maxGeometries are kept, geometries not drawn for 60 frames are released. Pass zero to disable & release them.
+ */
+IMGUI_IMPL_API void     ImGui_ImplD2D_EnableGeometryCache(int maxGeometries = 4096);
+
+/** @brief Skip draw commands of windows hidden behind opaque windows drawn later (opt-in, requires ImGui_ImplD2D_Init())
+
+    Opaque rectangles of one color (window backgrounds & title bars with opaque ImGuiCol_WindowBg, ImGuiCol_TitleBg*
+    & zero WindowRounding) are found in each draw list first, draw commands whose clip rectangle lies inside of one
+    drawn later are not translated. Occluders are rounded inwards to whole pixels, so drawn pixels do not change.
+    Frames with user callbacks are drawn whole. Skipped commands are counted in ImGui_ImplD2D_FrameStats.
+ */
+IMGUI_IMPL_API void     ImGui_ImplD2D_SetOcclusionCulling(bool enabled);
+
+/** @brief Called by render thread around each frame, e.g. BeginDraw() & Clear() before, EndDraw() after */
+typedef void (*ImGui_ImplD2D_RenderThreadFunc)(ImGui_ImplD2D_RenderTarget* renderTarget, void* userData);
+
+/** @brief Render on backend owned thread (opt-in, requires ImGui_ImplD2D_Init())
+
+    ImGui_ImplD2D_RenderDrawData() then only copies draw data into snapshot & returns, frame is translated & drawn
+    by render thread between @p beginFrame & @p endFrame calls, application must not call BeginDraw()/EndDraw()
+    itself. At most one frame waits for render thread. With @p doubleBuffer next frame is copied while previous
+    one is rendered, otherwise copy waits until previous frame is drawn. Statistics of ImGui_ImplD2D_GetFrameStats()
+    are those of the last frame render thread finished. User callbacks of draw lists run on render thread.
+    Render target & font atlas must not be used by application while frame is rendered, call
+    ImGui_ImplD2D_WaitForRenderThread() first (texture loading, adding fonts, resizing render target).
+    Render thread allocates command lists & cache entries with ImGui::MemAlloc() while UI thread runs ImGui frames:
+    allocator functions of ImGui::SetAllocatorFunctions() must be thread-safe (default malloc() & free() are) and
+    GImGui must be thread local (see imconfig.h), as ImGui::MemAlloc() records allocations in current context
+    without synchronization & render thread has none.
+ */
+IMGUI_IMPL_API bool     ImGui_ImplD2D_StartRenderThread(ImGui_ImplD2D_RenderThreadFunc beginFrame, ImGui_ImplD2D_RenderThreadFunc endFrame, void* userData = nullptr, bool doubleBuffer = true);
+/** @brief Render pending frames & stop render thread, called by ImGui_ImplD2D_Shutdown() */
+IMGUI_IMPL_API void     ImGui_ImplD2D_StopRenderThread();
+/** @brief Wait until render thread has drawn all frames handed to it, does nothing without render thread */
+IMGUI_IMPL_API void     ImGui_ImplD2D_WaitForRenderThread();
+
+/** @brief Draw data translated into Direct2D primitives, brush colors, glyph runs & clip operations */
+struct ImGui_ImplD2D_CommandBuffer;
+
+/** @brief Translate draw data into command buffer without touching render target (requires ImGui_ImplD2D_Init())
+
+    Buffer is self-contained: draw data can be released once this returns & buffer can be submitted any number of
+    times, to backend render target or render targets compatible with it (created by it or sharing its device), as
+    font bitmap & textures belong to that device. User callbacks are copied and get null parent list when submitted. Building reads
+    ImGui font atlas & backend font table, so it can run on other thread as long as ImGui_ImplD2D_NewFrame(),
+    ImGui_ImplD2D_RenderDrawData() or font changes do not run meanwhile. It allocates with ImGui::MemAlloc() of its
+    ImGui context, which is not synchronized: no other thread may use that context meanwhile and allocator functions
+    of ImGui::SetAllocatorFunctions() must be thread-safe. Pass previous buffer as @p reuse to keep its
+    memory, it is returned back. Draw lists are translated with ImGui_ImplD2D_SetParallelFor() jobs when set.
+ */
+IMGUI_IMPL_API ImGui_ImplD2D_CommandBuffer* ImGui_ImplD2D_BuildCommandBuffer(const ImDrawData* draw_data, ImGui_ImplD2D_CommandBuffer* reuse = nullptr);
+/** @brief Draw command buffer between BeginDraw() & EndDraw() of @p renderTarget, backend render target when null
+
+    @p renderTarget must be compatible with backend render target: created from it (CreateCompatibleRenderTarget())
+    or by the same device, so font bitmap & textures can be drawn on it. Other render targets get their own solid
+    color brush, statistics of ImGui_ImplD2D_GetFrameStats() are not changed.
+    Must not target render target of ImGui_ImplD2D_StartRenderThread() while render thread runs.
+ */
+IMGUI_IMPL_API void     ImGui_ImplD2D_Submit(const ImGui_ImplD2D_CommandBuffer* buffer, ImGui_ImplD2D_RenderTarget* renderTarget = nullptr);
+IMGUI_IMPL_API void     ImGui_ImplD2D_DestroyCommandBuffer(ImGui_ImplD2D_CommandBuffer* buffer);
+
+/** @brief Backend statistics of the last ImGui_ImplD2D_RenderDrawData() call
+
+    Collected unless IMGUI_IMPL_D2D_DISABLE_STATS is defined when building the backend (all fields stay zero then).
+ */
+struct ImGui_ImplD2D_FrameStats
+{
+    // Direct2D calls
+    int     GeometriesCreated;
+    /** @brief Geometries drawn from cache instead of created (see ImGui_ImplD2D_EnableGeometryCache()) */
+    int     GeometriesReused;
+    int     BrushesCreated;
+    int     FillGeometryCalls;
+    int     DrawTextCalls;
+    /** @brief Images drawn as bitmaps, packed textures included */
+    int     DrawBitmapCalls;
+    /** @brief Push & pop of axis aligned clip */
+    int     ClipCalls;
+    // Polygons by classification
+    int     SolidPolygons;
+    int     LinearGradientPolygons;
+    int     RadialGradientPolygons;
+    int     Glyphs;
+    /** @brief Polygons & glyph runs outside of their clip rectangle dropped by translation & draw commands translated
+        without clip as nothing crosses its edges (counted by translation, so not for reused draw lists) */
+    int     PrimitivesCulled;
+    int     ClipsSkipped;
+    /** @brief Draw commands not translated as opaque rectangles drawn later cover them (see ImGui_ImplD2D_SetOcclusionCulling()) */
+    int     DrawCommandsOccluded;
+    /** @brief Draw lists translated & reused unchanged from previous frame (see ImGui_ImplD2D_SetDrawListReuse()) */
+    int     DrawListsTranslated;
+    int     DrawListsReused;
+    /** @brief Draw lists drawn into their offscreen layer & composited from unchanged layer (see ImGui_ImplD2D_EnableWindowCache()) */
+    int     LayersDrawn;
+    int     LayersReused;
+    /** @brief Triangles scanned & glyph lookups made by classification, grows linearly with index count */
+    int     ClassifySteps;
+    /** @brief Font atlas uploads since previous frame */
+    int     FontAtlasUploads;
+    /** @brief ID2D1Multithread lock sections entered by backend on any thread since previous frame, zero for single threaded factory */
+    int     FactoryLocks;
+    // Time spent in nanoseconds, translation times are summed over threads when draw lists are translated in parallel
+    /** @brief Whole ImGui_ImplD2D_RenderDrawData() call */
+    ImU64   RenderTime;
+    ImU64   ClassifyTime;
+    ImU64   GlyphTime;
+    ImU64   SubmitTime;
+    /** @brief Time spent waiting for & holding ID2D1Multithread lock by backend on any thread since previous frame */
+    ImU64   FactoryLockWaitTime;
+    ImU64   FactoryLockHoldTime;
+};
+
+IMGUI_IMPL_API const ImGui_ImplD2D_FrameStats* ImGui_ImplD2D_GetFrameStats();
+
+/** @brief Window with backend frame time histogram & percentiles of last frames, Direct2D calls by type & texture memory
+
+    Fed from ImGui_ImplD2D_FrameStats of each rendered frame, so it is empty when IMGUI_IMPL_D2D_DISABLE_STATS is defined.
+ */
+IMGUI_IMPL_API void     ImGui_ImplD2D_ShowMetricsWindow(bool* p_open = nullptr);
+
+/** @brief Record draw data of every ImGui_ImplD2D_RenderDrawData() call to file
+
+    Capture holds vertices, indices & font glyph metadata, so frames can be replayed without Direct2D or ImGui
+    context (see tools/replay_draw_data). Textures & user callbacks are not stored. Returns false when file
+    cannot be created. Capture is closed by ImGui_ImplD2D_EndCapture() or ImGui_ImplD2D_Shutdown().
+ */
+IMGUI_IMPL_API bool     ImGui_ImplD2D_BeginCapture(const char* filename);
+IMGUI_IMPL_API void     ImGui_ImplD2D_EndCapture();
+
+/** @brief Write backend zones (draw list translation, brush creation, texture upload...) to Chrome trace JSON file
+
+    Only available when backend is built with IMGUI_IMPL_D2D_TRACE_CHROME, returns false otherwise or when file
+    cannot be created. With IMGUI_IMPL_D2D_TRACE_TRACY zones are sent to Tracy instead and no file is needed.
  */
+IMGUI_IMPL_API bool     ImGui_ImplD2D_BeginTrace(const char* filename);
+IMGUI_IMPL_API void     ImGui_ImplD2D_EndTrace();
 
 #endif // #ifndef IMGUI_DISABLE
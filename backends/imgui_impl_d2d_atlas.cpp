@@ -0,0 +1,82 @@
+// dear imgui: Renderer Backend for Direct2D - texture atlas packer
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+
+void ImGui_ImplD2D_AtlasPacker::Init(int pageSize, int maxImageSize, int padding) {
+    IM_ASSERT(pageSize > 0 && maxImageSize > 0 && padding >= 0);
+    Clear();
+    PageWidth = pageSize;
+    PageHeight = pageSize;
+    MaxImageSize = maxImageSize;
+    Padding = padding;
+}
+
+void ImGui_ImplD2D_AtlasPacker::Clear() {
+    Shelves.clear();
+    PageBottom.clear();
+}
+
+bool ImGui_ImplD2D_AtlasPacker::CanPack(int width, int height) const {
+    if (!IsEnabled() || width <= 0 || height <= 0) {
+        return false;
+    }
+    if (width > MaxImageSize || height > MaxImageSize) {
+        return false;
+    }
+    return width + Padding * 2 <= PageWidth && height + Padding * 2 <= PageHeight;
+}
+
+bool ImGui_ImplD2D_AtlasPacker::Pack(int width, int height, ImGui_ImplD2D_AtlasRect* out) {
+    IM_ASSERT(out != nullptr);
+    if (!CanPack(width, height)) {
+        return false;
+    }
+    const int paddedWidth = width + Padding * 2;
+    const int paddedHeight = height + Padding * 2;
+
+    // best fitting shelf, ignore shelves that would waste more than half of their height
+    ImGui_ImplD2D_AtlasShelf* best = nullptr;
+    for (size_t s = 0; s < Shelves.size(); s++) {
+        ImGui_ImplD2D_AtlasShelf& shelf = Shelves[s];
+        if (shelf.Height < paddedHeight || shelf.Height > paddedHeight * 2 || PageWidth - shelf.Used < paddedWidth) {
+            continue;
+        }
+        if (best == nullptr || shelf.Height < best->Height) {
+            best = &shelf;
+        }
+    }
+    if (best == nullptr) {
+        // open new shelf on first page with enough room
+        const int pageCount = GetPageCount();
+        int page = 0;
+        while (page < pageCount && PageHeight - PageBottom[page] < paddedHeight) {
+            page++;
+        }
+        if (page == pageCount) {
+            PageBottom.push_back(0);
+        }
+        ImGui_ImplD2D_AtlasShelf shelf;
+        shelf.Page = page;
+        shelf.Y = PageBottom[page];
+        shelf.Height = paddedHeight;
+        shelf.Used = 0;
+        PageBottom[page] += paddedHeight;
+        Shelves.push_back(shelf);
+        best = &Shelves.back();
+    }
+
+    out->Page = best->Page;
+    out->X = best->Used + Padding;
+    out->Y = best->Y + Padding;
+    out->Width = width;
+    out->Height = height;
+    out->Uv0 = ImVec2((float)out->X / (float)PageWidth, (float)out->Y / (float)PageHeight);
+    out->Uv1 = ImVec2((float)(out->X + width) / (float)PageWidth, (float)(out->Y + height) / (float)PageHeight);
+    best->Used += paddedWidth;
+    return true;
+}
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,315 @@
+// dear imgui: Renderer Backend for Direct2D - draw data capture
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+// File layout (little endian, no padding), repeated for each frame:
+//  u32 magic, u32 version, u32 sizeof(ImDrawIdx), u32 sizeof(ImDrawVert)
+//  f32 framebuffer width & height, f32 font global scale, f32 display pos x & y, f32 display size x & y, f32 framebuffer scale x & y
+//  u32 has font table, when non zero:
+//      u64 font atlas texture id, u32 font count, u32 glyph count
+//      per font: f32 font size, f32 scale, f32 ascent, u32 glyph count
+//      per glyph: u32 codepoint, f32 x0, y0, u0, v0, u1, v1
+//  u32 draw list count, per draw list:
+//      u32 command count, u32 vertex count, u32 index count
+//      per command: f32 clip rect x1, y1, x2, y2, u64 texture id, u32 vertex offset, u32 index offset, u32 element count
+//      vertices (ImDrawVert), indices (ImDrawIdx)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+
+#include <climits>     // INT_MAX
+#include <cstdint>
+
+static const ImU32 ImGui_ImplD2D_CaptureMagic = 0x43443249u; // "I2DC"
+static const ImU32 ImGui_ImplD2D_CaptureVersion = 1u;
+// Size of records in file, see file layout
+static const size_t ImGui_ImplD2D_CaptureFontSize = 4 * 4;
+static const size_t ImGui_ImplD2D_CaptureGlyphSize = 7 * 4;
+static const size_t ImGui_ImplD2D_CaptureListSize = 3 * 4;
+static const size_t ImGui_ImplD2D_CaptureCmdSize = 4 * 4 + 8 + 3 * 4;
+
+//-----------------------------------------------------------------------------
+// Writer
+//-----------------------------------------------------------------------------
+
+template <typename T>
+static inline bool ImGui_ImplD2D_Write(FILE* file, const T& value) {
+    return fwrite(&value, sizeof(T), 1, file) == 1;
+}
+
+static inline bool ImGui_ImplD2D_WriteArray(FILE* file, const void* data, size_t size) {
+    return size == 0 || fwrite(data, size, 1, file) == 1;
+}
+
+bool ImGui_ImplD2D_CaptureWriter::Open(const char* filename) {
+    Close();
+    File = fopen(filename, "wb");
+    FontTableVersion = -1;
+    FrameCount = 0;
+    return File != nullptr;
+}
+
+void ImGui_ImplD2D_CaptureWriter::Close() {
+    if (File != nullptr) {
+        fclose(File);
+        File = nullptr;
+    }
+}
+
+bool ImGui_ImplD2D_CaptureWriter::WriteFrame(const ImDrawData* drawData, const ImGui_ImplD2D_FontTable& fonts, float fontGlobalScale, const ImVec2& framebufferSize) {
+    if (File == nullptr) {
+        return false;
+    }
+    bool success = ImGui_ImplD2D_Write(File, ImGui_ImplD2D_CaptureMagic) &&
+        ImGui_ImplD2D_Write(File, ImGui_ImplD2D_CaptureVersion) &&
+        ImGui_ImplD2D_Write(File, (ImU32)sizeof(ImDrawIdx)) &&
+        ImGui_ImplD2D_Write(File, (ImU32)sizeof(ImDrawVert)) &&
+        ImGui_ImplD2D_Write(File, framebufferSize) &&
+        ImGui_ImplD2D_Write(File, fontGlobalScale) &&
+        ImGui_ImplD2D_Write(File, drawData->DisplayPos) &&
+        ImGui_ImplD2D_Write(File, drawData->DisplaySize) &&
+        ImGui_ImplD2D_Write(File, drawData->FramebufferScale);
+
+    // font table only when it changed since previous frame
+    const bool writeFonts = FontTableVersion != fonts.Version;
+    success = success && ImGui_ImplD2D_Write(File, (ImU32)(writeFonts ? 1 : 0));
+    if (success && writeFonts) {
+        success = ImGui_ImplD2D_Write(File, (ImU64)(uintptr_t)fonts.TexID) &&
+            ImGui_ImplD2D_Write(File, (ImU32)fonts.Fonts.Size) &&
+            ImGui_ImplD2D_Write(File, (ImU32)fonts.Glyphs.Size);
+        for (int f = 0; f < fonts.Fonts.Size && success; f++) {
+            const ImGui_ImplD2D_FontInfo& info = fonts.Fonts[f];
+            success = ImGui_ImplD2D_Write(File, info.FontSize) &&
+                ImGui_ImplD2D_Write(File, info.Scale) &&
+                ImGui_ImplD2D_Write(File, info.Ascent) &&
+                ImGui_ImplD2D_Write(File, (ImU32)info.GlyphCount);
+        }
+        success = success && ImGui_ImplD2D_WriteArray(File, fonts.Glyphs.Data, (size_t)fonts.Glyphs.size_in_bytes());
+        FontTableVersion = fonts.Version;
+    }
+
+    success = success && ImGui_ImplD2D_Write(File, (ImU32)drawData->CmdListsCount);
+    for (int n = 0; n < drawData->CmdListsCount && success; n++) {
+        const ImDrawList* drawList = drawData->CmdLists[n];
+        success = ImGui_ImplD2D_Write(File, (ImU32)drawList->CmdBuffer.Size) &&
+            ImGui_ImplD2D_Write(File, (ImU32)drawList->VtxBuffer.Size) &&
+            ImGui_ImplD2D_Write(File, (ImU32)drawList->IdxBuffer.Size);
+        for (int cmd_i = 0; cmd_i < drawList->CmdBuffer.Size && success; cmd_i++) {
+            const ImDrawCmd* pcmd = &drawList->CmdBuffer[cmd_i];
+            // user callbacks cannot be replayed
+            const ImU32 elemCount = pcmd->UserCallback != nullptr ? 0u : pcmd->ElemCount;
+            success = ImGui_ImplD2D_Write(File, pcmd->ClipRect) &&
+                ImGui_ImplD2D_Write(File, (ImU64)(uintptr_t)pcmd->GetTexID()) &&
+                ImGui_ImplD2D_Write(File, (ImU32)pcmd->VtxOffset) &&
+                ImGui_ImplD2D_Write(File, (ImU32)pcmd->IdxOffset) &&
+                ImGui_ImplD2D_Write(File, elemCount);
+        }
+        success = success &&
+            ImGui_ImplD2D_WriteArray(File, drawList->VtxBuffer.Data, (size_t)drawList->VtxBuffer.size_in_bytes()) &&
+            ImGui_ImplD2D_WriteArray(File, drawList->IdxBuffer.Data, (size_t)drawList->IdxBuffer.size_in_bytes());
+    }
+    if (success) {
+        FrameCount++;
+    }
+    return success;
+}
+
+//-----------------------------------------------------------------------------
+// Reader
+//-----------------------------------------------------------------------------
+
+template <typename T>
+static inline bool ImGui_ImplD2D_Read(FILE* file, T* value) {
+    return fread(value, sizeof(T), 1, file) == 1;
+}
+
+static inline bool ImGui_ImplD2D_ReadArray(FILE* file, void* data, size_t size) {
+    return size == 0 || fread(data, size, 1, file) == 1;
+}
+
+/** @brief File position, negative on failure (captures can be larger than 2 GB) */
+static inline long long ImGui_ImplD2D_Tell(FILE* file) {
+#if defined(_WIN32)
+    return _ftelli64(file);
+#else
+    return (long long)ftello(file);
+#endif
+}
+
+bool ImGui_ImplD2D_CaptureReader::Open(const char* filename) {
+    Close();
+    File = fopen(filename, "rb");
+    FrameCount = 0;
+    FileSize = 0;
+    if (File == nullptr) {
+        return false;
+    }
+    // counts are checked against file size, so corrupted file cannot request more memory than it holds
+    const long long size = fseek(File, 0, SEEK_END) == 0 ? ImGui_ImplD2D_Tell(File) : -1;
+    if (size < 0 || fseek(File, 0, SEEK_SET) != 0) {
+        Close();
+        return false;
+    }
+    FileSize = (ImU64)size;
+    return true;
+}
+
+bool ImGui_ImplD2D_CaptureReader::CanRead(ImU32 count, size_t memorySize, size_t fileSize) const {
+    const long long position = ImGui_ImplD2D_Tell(File);
+    if (position < 0 || (ImU64)position > FileSize) {
+        return false;
+    }
+    return count <= (ImU32)(INT_MAX / memorySize) && (ImU64)count * fileSize <= FileSize - (ImU64)position;
+}
+
+void ImGui_ImplD2D_CaptureReader::Close() {
+    ClearDrawData();
+    Fonts.Clear();
+    if (File != nullptr) {
+        fclose(File);
+        File = nullptr;
+    }
+    FileSize = 0;
+}
+
+bool ImGui_ImplD2D_CaptureReader::Rewind() {
+    if (File == nullptr) {
+        return false;
+    }
+    ClearDrawData();
+    Fonts.Clear();
+    FrameCount = 0;
+    return fseek(File, 0, SEEK_SET) == 0;
+}
+
+void ImGui_ImplD2D_CaptureReader::ClearDrawData() {
+    for (int n = 0; n < DrawData.CmdLists.Size; n++) {
+        IM_DELETE(DrawData.CmdLists[n]);
+    }
+    DrawData.CmdLists.resize(0);
+    DrawData.CmdListsCount = 0;
+    DrawData.TotalVtxCount = 0;
+    DrawData.TotalIdxCount = 0;
+    DrawData.Valid = false;
+}
+
+bool ImGui_ImplD2D_CaptureReader::ReadFrame() {
+    if (File == nullptr) {
+        return false;
+    }
+    ClearDrawData();
+    ImU32 magic = 0, version = 0, idxSize = 0, vtxSize = 0;
+    if (!ImGui_ImplD2D_Read(File, &magic) || magic != ImGui_ImplD2D_CaptureMagic) {
+        return false;
+    }
+    bool success = ImGui_ImplD2D_Read(File, &version) && version == ImGui_ImplD2D_CaptureVersion &&
+        ImGui_ImplD2D_Read(File, &idxSize) && (idxSize == 2 || idxSize == 4) &&
+        ImGui_ImplD2D_Read(File, &vtxSize) && vtxSize == sizeof(ImDrawVert) &&
+        ImGui_ImplD2D_Read(File, &FramebufferSize) &&
+        ImGui_ImplD2D_Read(File, &FontGlobalScale) &&
+        ImGui_ImplD2D_Read(File, &DrawData.DisplayPos) &&
+        ImGui_ImplD2D_Read(File, &DrawData.DisplaySize) &&
+        ImGui_ImplD2D_Read(File, &DrawData.FramebufferScale);
+
+    ImU32 hasFonts = 0;
+    success = success && ImGui_ImplD2D_Read(File, &hasFonts);
+    if (success && hasFonts != 0) {
+        ImU64 texID = 0;
+        ImU32 fontCount = 0, glyphCount = 0;
+        success = ImGui_ImplD2D_Read(File, &texID) && ImGui_ImplD2D_Read(File, &fontCount) && ImGui_ImplD2D_Read(File, &glyphCount) &&
+            CanRead(fontCount, sizeof(ImGui_ImplD2D_FontInfo), ImGui_ImplD2D_CaptureFontSize) &&
+            CanRead(glyphCount, sizeof(ImGui_ImplD2D_FontGlyph), ImGui_ImplD2D_CaptureGlyphSize);
+        if (success) {
+            const int version = Fonts.Version;
+            Fonts.Clear();
+            Fonts.Version = version + 1;
+            Fonts.TexID = (ImTextureID)(uintptr_t)texID;
+            Fonts.Fonts.resize((int)fontCount);
+            Fonts.Glyphs.resize((int)glyphCount);
+        }
+        int glyphOffset = 0;
+        for (int f = 0; f < Fonts.Fonts.Size && success; f++) {
+            ImGui_ImplD2D_FontInfo& info = Fonts.Fonts[f];
+            ImU32 count = 0;
+            success = ImGui_ImplD2D_Read(File, &info.FontSize) &&
+                ImGui_ImplD2D_Read(File, &info.Scale) &&
+                ImGui_ImplD2D_Read(File, &info.Ascent) &&
+                ImGui_ImplD2D_Read(File, &count) && count <= (ImU32)(Fonts.Glyphs.Size - glyphOffset);
+            info.GlyphOffset = glyphOffset;
+            info.GlyphCount = (int)count;
+            glyphOffset += (int)count;
+        }
+        success = success && ImGui_ImplD2D_ReadArray(File, Fonts.Glyphs.Data, (size_t)Fonts.Glyphs.size_in_bytes());
+        if (success) {
+            Fonts.BuildLookup();
+        }
+    }
+
+    ImU32 listCount = 0;
+    success = success && ImGui_ImplD2D_Read(File, &listCount) && CanRead(listCount, sizeof(ImDrawList*), ImGui_ImplD2D_CaptureListSize);
+    ImVector<ImU8> indices;
+    for (ImU32 n = 0; n < listCount && success; n++) {
+        ImU32 cmdCount = 0, vtxCount = 0, idxCount = 0;
+        success = ImGui_ImplD2D_Read(File, &cmdCount) && ImGui_ImplD2D_Read(File, &vtxCount) && ImGui_ImplD2D_Read(File, &idxCount) &&
+            CanRead(cmdCount, sizeof(ImDrawCmd), ImGui_ImplD2D_CaptureCmdSize) &&
+            CanRead(vtxCount, sizeof(ImDrawVert), vtxSize) &&
+            CanRead(idxCount, sizeof(ImDrawIdx) > idxSize ? sizeof(ImDrawIdx) : (size_t)idxSize, idxSize);
+        if (!success) {
+            break;
+        }
+        ImDrawList* drawList = IM_NEW(ImDrawList)(nullptr);
+        DrawData.CmdLists.push_back(drawList);
+        drawList->CmdBuffer.resize((int)cmdCount);
+        for (ImU32 cmd_i = 0; cmd_i < cmdCount && success; cmd_i++) {
+            ImDrawCmd* pcmd = &drawList->CmdBuffer[(int)cmd_i];
+            memset((void*)pcmd, 0, sizeof(*pcmd));
+            ImU64 texID = 0;
+            ImU32 vtxOffset = 0, idxOffset = 0, elemCount = 0;
+            success = ImGui_ImplD2D_Read(File, &pcmd->ClipRect) &&
+                ImGui_ImplD2D_Read(File, &texID) &&
+                ImGui_ImplD2D_Read(File, &vtxOffset) &&
+                ImGui_ImplD2D_Read(File, &idxOffset) &&
+                ImGui_ImplD2D_Read(File, &elemCount) &&
+                (ImU64)idxOffset + elemCount <= idxCount && vtxOffset <= vtxCount && elemCount % 3 == 0;
+            pcmd->TextureId = (ImTextureID)(uintptr_t)texID;
+            pcmd->VtxOffset = vtxOffset;
+            pcmd->IdxOffset = idxOffset;
+            pcmd->ElemCount = elemCount;
+        }
+        drawList->VtxBuffer.resize((int)vtxCount);
+        drawList->IdxBuffer.resize((int)idxCount);
+        success = success && ImGui_ImplD2D_ReadArray(File, drawList->VtxBuffer.Data, (size_t)drawList->VtxBuffer.size_in_bytes());
+        if (success && idxSize == sizeof(ImDrawIdx)) {
+            success = ImGui_ImplD2D_ReadArray(File, drawList->IdxBuffer.Data, (size_t)drawList->IdxBuffer.size_in_bytes());
+        }
+        else if (success) {
+            // captured with different index type
+            indices.resize((int)(idxCount * idxSize));
+            success = ImGui_ImplD2D_ReadArray(File, indices.Data, (size_t)indices.Size);
+            for (ImU32 i = 0; i < idxCount && success; i++) {
+                const ImU32 index = idxSize == 2 ? ((const ImU16*)indices.Data)[i] : ((const ImU32*)indices.Data)[i];
+                drawList->IdxBuffer[(int)i] = (ImDrawIdx)index;
+                success = (ImU32)drawList->IdxBuffer[(int)i] == index;
+            }
+        }
+        // indices must stay inside of vertex buffer
+        for (int i = 0; i < drawList->CmdBuffer.Size && success; i++) {
+            const ImDrawCmd& cmd = drawList->CmdBuffer[i];
+            for (unsigned int e = 0; e < cmd.ElemCount && success; e++) {
+                success = cmd.VtxOffset + drawList->IdxBuffer[(int)(cmd.IdxOffset + e)] < vtxCount;
+            }
+        }
+        DrawData.TotalVtxCount += (int)vtxCount;
+        DrawData.TotalIdxCount += (int)idxCount;
+    }
+    DrawData.CmdListsCount = DrawData.CmdLists.Size;
+    if (!success) {
+        ClearDrawData();
+        return false;
+    }
+    DrawData.Valid = true;
+    FrameCount++;
+    return true;
+}
+
+#endif // #ifndef IMGUI_DISABLE
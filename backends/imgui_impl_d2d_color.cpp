@@ -0,0 +1,10 @@
+// dear imgui: Renderer Backend for Direct2D - color conversion
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+
+constexpr ImGui_ImplD2D_ColorTable ImGui_ImplD2D_ColorMap;
+
+#endif // #ifndef IMGUI_DISABLE
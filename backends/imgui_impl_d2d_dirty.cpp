@@ -0,0 +1,237 @@
+// dear imgui: Renderer Backend for Direct2D - dirty rectangles between frames
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+#include <cfloat>       // FLT_MAX
+#include <cmath>        // floorf, ceilf
+#include <cstdlib>      // qsort
+
+// rectangles are grown by this many pixels, so antialiased edges of primitives are always inside (text has its own margin)
+static const float ImGui_ImplD2D_DirtyMargin = 1.0f;
+// beyond this many changed draw commands merging pairs is not worth it, their union is used
+static const int ImGui_ImplD2D_DirtyMaxMerged = 256;
+
+static inline float ImGui_ImplD2D_RectArea(const ImVec4& r) {
+    return (r.z - r.x) * (r.w - r.y);
+}
+
+static inline ImVec4 ImGui_ImplD2D_RectUnion(const ImVec4& a, const ImVec4& b) {
+    return ImVec4(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z > b.z ? a.z : b.z, a.w > b.w ? a.w : b.w);
+}
+
+/** @brief Rectangles overlap or touch */
+static inline bool ImGui_ImplD2D_RectsTouch(const ImVec4& a, const ImVec4& b) {
+    return a.x <= b.z && b.x <= a.z && a.y <= b.w && b.y <= a.w;
+}
+
+static int ImGui_ImplD2D_CompareDirtyItems(const void* a, const void* b) {
+    const ImU64 lhs = ((const ImGui_ImplD2D_DirtyItem*)a)->Hash;
+    const ImU64 rhs = ((const ImGui_ImplD2D_DirtyItem*)b)->Hash;
+    return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+
+float ImGui_ImplD2D_GetGlyphMargin(const ImGui_ImplD2D_FontTable* fonts, float fontGlobalScale) {
+    // the same margin as culling of glyph runs, outlines reach past quads (bearings, hinting) by font size at most
+    float margin = 0.0f;
+    for (int f = 0; fonts != nullptr && f < fonts->Fonts.Size; f++) {
+        const float size = fonts->Fonts[f].FontSize * fonts->Fonts[f].Scale * fontGlobalScale;
+        margin = size > margin ? size : margin;
+    }
+    return margin;
+}
+
+bool ImGui_ImplD2D_GetDrawCmdRect(const ImDrawData* drawData, const ImDrawList* drawList, const ImDrawCmd* cmd, const ImGui_ImplD2D_FontTable* fonts, float glyphMargin, ImVec4* out) {
+    const ImVec2 clipOffset = drawData->DisplayPos;
+    const ImVec2 clipScale = drawData->FramebufferScale;
+    const ImVec2 framebufferSize(drawData->DisplaySize.x * clipScale.x, drawData->DisplaySize.y * clipScale.y);
+    ImVec4 rect((cmd->ClipRect.x - clipOffset.x) * clipScale.x, (cmd->ClipRect.y - clipOffset.y) * clipScale.y,
+        (cmd->ClipRect.z - clipOffset.x) * clipScale.x, (cmd->ClipRect.w - clipOffset.y) * clipScale.y);
+    if (cmd->UserCallback == nullptr && fonts != nullptr) {
+        // vertices of command, user callbacks may draw anywhere inside clip rectangle
+        ImVec4 bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+        const ImDrawIdx* idx = drawList->IdxBuffer.Data + cmd->IdxOffset;
+        const ImDrawVert* vtx = drawList->VtxBuffer.Data + cmd->VtxOffset;
+        for (unsigned int i = 0; i < cmd->ElemCount; i++) {
+            const ImVec2 pos = vtx[idx[i]].pos;
+            if (pos.x < bounds.x) { bounds.x = pos.x; }
+            if (pos.y < bounds.y) { bounds.y = pos.y; }
+            if (pos.x > bounds.z) { bounds.z = pos.x; }
+            if (pos.y > bounds.w) { bounds.w = pos.y; }
+        }
+        if (cmd->GetTexID() == fonts->TexID) {
+            // may be text, drawn by DirectWrite instead of atlas quads
+            bounds = ImVec4(bounds.x - glyphMargin, bounds.y - glyphMargin, bounds.z + glyphMargin, bounds.w + glyphMargin);
+        }
+        bounds = ImVec4((bounds.x - clipOffset.x) * clipScale.x, (bounds.y - clipOffset.y) * clipScale.y,
+            (bounds.z - clipOffset.x) * clipScale.x, (bounds.w - clipOffset.y) * clipScale.y);
+        if (bounds.x > rect.x) { rect.x = bounds.x; }
+        if (bounds.y > rect.y) { rect.y = bounds.y; }
+        if (bounds.z < rect.z) { rect.z = bounds.z; }
+        if (bounds.w < rect.w) { rect.w = bounds.w; }
+    }
+    if (rect.x < 0.0f) { rect.x = 0.0f; }
+    if (rect.y < 0.0f) { rect.y = 0.0f; }
+    if (rect.z > framebufferSize.x) { rect.z = framebufferSize.x; }
+    if (rect.w > framebufferSize.y) { rect.w = framebufferSize.y; }
+    *out = rect;
+    return rect.z > rect.x && rect.w > rect.y;
+}
+
+void ImGui_ImplD2D_DirtyTracker::AddItems(const ImDrawData* drawData, const ImGui_ImplD2D_FontTable* fonts, float fontGlobalScale) {
+    Items.resize(0);
+    const float glyphMargin = ImGui_ImplD2D_GetGlyphMargin(fonts, fontGlobalScale);
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList* drawList = drawData->CmdLists[n];
+        for (int c = 0; c < drawList->CmdBuffer.Size; c++) {
+            const ImDrawCmd* cmd = &drawList->CmdBuffer[c];
+            if ((cmd->ElemCount == 0 && cmd->UserCallback == nullptr) || cmd->UserCallback == ImDrawCallback_ResetRenderState) {
+                continue;
+            }
+            ImGui_ImplD2D_DirtyItem item;
+            if (!ImGui_ImplD2D_GetDrawCmdRect(drawData, drawList, cmd, fonts, glyphMargin, &item.Rect)) {
+                continue;
+            }
+            // position in draw order is hashed too, so commands changing their stacking are dirty
+            const int order[2] = { n, c };
+            ImU64 hash = ImGui_ImplD2D_Hash(order, sizeof(order), 0);
+            hash = ImGui_ImplD2D_Hash(&item.Rect, sizeof(item.Rect), hash);
+            hash = ImGui_ImplD2D_Hash(&cmd->TextureId, sizeof(cmd->TextureId), hash);
+            if (cmd->UserCallback != nullptr) {
+                // callback output is unknown, its area is dirty every frame
+                hash = ImGui_ImplD2D_Hash(&Frame, sizeof(Frame), hash);
+            }
+            else {
+                // vertices referenced by command & indices relative to the first one, so commands keep their hash
+                // when vertex count of earlier commands changes
+                const ImDrawIdx* idx = drawList->IdxBuffer.Data + cmd->IdxOffset;
+                unsigned int first = idx[0];
+                unsigned int last = idx[0];
+                for (unsigned int i = 1; i < cmd->ElemCount; i++) {
+                    first = idx[i] < first ? idx[i] : first;
+                    last = idx[i] > last ? idx[i] : last;
+                }
+                Indices.resize((int)cmd->ElemCount);
+                for (unsigned int i = 0; i < cmd->ElemCount; i++) {
+                    Indices[(int)i] = idx[i] - first;
+                }
+                hash = ImGui_ImplD2D_Hash(Indices.Data, (size_t)Indices.size_in_bytes(), hash);
+                hash = ImGui_ImplD2D_Hash(drawList->VtxBuffer.Data + cmd->VtxOffset + first, (last - first + 1) * sizeof(ImDrawVert), hash);
+            }
+            item.Hash = hash;
+            Items.push_back(item);
+        }
+    }
+}
+
+/** @brief Merge touching rectangles until none touch */
+static void ImGui_ImplD2D_MergeTouchingRects(ImVector<ImVec4>& rects) {
+    for (bool merged = true; merged; ) {
+        merged = false;
+        for (int a = 0; a < rects.Size; a++) {
+            for (int b = rects.Size - 1; b > a; b--) {
+                if (ImGui_ImplD2D_RectsTouch(rects[a], rects[b])) {
+                    rects[a] = ImGui_ImplD2D_RectUnion(rects[a], rects[b]);
+                    rects.erase(rects.Data + b);
+                    merged = true;
+                }
+            }
+        }
+    }
+}
+
+void ImGui_ImplD2D_DirtyTracker::MergeRects(int maxRects) {
+    if (Rects.Size > ImGui_ImplD2D_DirtyMaxMerged) {
+        for (int n = 1; n < Rects.Size; n++) {
+            Rects[0] = ImGui_ImplD2D_RectUnion(Rects[0], Rects[n]);
+        }
+        Rects.resize(1);
+    }
+    // touching rectangles are always merged, so output rectangles never overlap
+    ImGui_ImplD2D_MergeTouchingRects(Rects);
+    // then pairs adding least area are merged until count fits, union may touch others so touching pass repeats
+    while (Rects.Size > maxRects) {
+        int bestA = 0;
+        int bestB = 1;
+        float bestGrowth = FLT_MAX;
+        for (int a = 0; a < Rects.Size; a++) {
+            for (int b = a + 1; b < Rects.Size; b++) {
+                const float growth = ImGui_ImplD2D_RectArea(ImGui_ImplD2D_RectUnion(Rects[a], Rects[b])) - ImGui_ImplD2D_RectArea(Rects[a]) - ImGui_ImplD2D_RectArea(Rects[b]);
+                if (growth < bestGrowth) {
+                    bestGrowth = growth;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+        Rects[bestA] = ImGui_ImplD2D_RectUnion(Rects[bestA], Rects[bestB]);
+        Rects.erase(Rects.Data + bestB);
+        ImGui_ImplD2D_MergeTouchingRects(Rects);
+    }
+}
+
+int ImGui_ImplD2D_DirtyTracker::Compute(const ImDrawData* drawData, const ImGui_ImplD2D_FontTable* fonts, float fontGlobalScale, int maxRects) {
+    IM_ASSERT(drawData != nullptr && maxRects > 0);
+    IMGUI_IMPL_D2D_ZONE("ComputeDirtyRects");
+    Frame++;
+    PreviousItems.swap(Items);
+    AddItems(drawData, fonts, fontGlobalScale);
+    qsort(Items.Data, (size_t)Items.Size, sizeof(ImGui_ImplD2D_DirtyItem), ImGui_ImplD2D_CompareDirtyItems);
+
+    const ImVec2 framebufferSize(drawData->DisplaySize.x * drawData->FramebufferScale.x, drawData->DisplaySize.y * drawData->FramebufferScale.y);
+    Rects.resize(0);
+    if (!HasPrevious || framebufferSize.x != FramebufferSize.x || framebufferSize.y != FramebufferSize.y) {
+        HasPrevious = true;
+        FramebufferSize = framebufferSize;
+        if (framebufferSize.x > 0.0f && framebufferSize.y > 0.0f) {
+            Rects.push_back(ImVec4(0.0f, 0.0f, ceilf(framebufferSize.x), ceilf(framebufferSize.y)));
+        }
+        return Rects.Size;
+    }
+
+    // commands present in only one of the frames are dirty where they were & where they are
+    int p = 0;
+    int c = 0;
+    while (p < PreviousItems.Size || c < Items.Size) {
+        if (p < PreviousItems.Size && c < Items.Size && PreviousItems[p].Hash == Items[c].Hash) {
+            p++;
+            c++;
+        }
+        else if (c == Items.Size || (p < PreviousItems.Size && PreviousItems[p].Hash < Items[c].Hash)) {
+            Rects.push_back(PreviousItems[p++].Rect);
+        }
+        else {
+            Rects.push_back(Items[c++].Rect);
+        }
+    }
+    if (Rects.Size == 0) {
+        return 0;
+    }
+    for (int n = 0; n < Rects.Size; n++) {
+        ImVec4& r = Rects[n];
+        r.x = floorf(r.x - ImGui_ImplD2D_DirtyMargin);
+        r.y = floorf(r.y - ImGui_ImplD2D_DirtyMargin);
+        r.z = ceilf(r.z + ImGui_ImplD2D_DirtyMargin);
+        r.w = ceilf(r.w + ImGui_ImplD2D_DirtyMargin);
+    }
+    MergeRects(maxRects);
+    for (int n = 0; n < Rects.Size; n++) {
+        ImVec4& r = Rects[n];
+        r.x = r.x < 0.0f ? 0.0f : r.x;
+        r.y = r.y < 0.0f ? 0.0f : r.y;
+        r.z = r.z > ceilf(framebufferSize.x) ? ceilf(framebufferSize.x) : r.z;
+        r.w = r.w > ceilf(framebufferSize.y) ? ceilf(framebufferSize.y) : r.w;
+    }
+    return Rects.Size;
+}
+
+void ImGui_ImplD2D_DirtyTracker::Clear() {
+    Items.clear();
+    PreviousItems.clear();
+    Indices.clear();
+    Rects.clear();
+    HasPrevious = false;
+}
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,1009 @@
+// dear imgui: Renderer Backend for Direct2D - translation of draw lists
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+// Direct2D has no way to draw indexed triangles with per-vertex colors, so triangles are grouped back into
+// the shapes Dear ImGui emitted them from: polygons filled with single color, quads & triangles with color
+// gradient and glyphs, which are drawn with DirectWrite.
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+#include <cmath>        // floorf, ceilf
+
+//-----------------------------------------------------------------------------
+// Font table
+//-----------------------------------------------------------------------------
+
+void ImGui_ImplD2D_FontTable::Build(const ImFontAtlas* atlas) {
+    Clear();
+    TexID = atlas->TexID;
+    Version++;
+    for (int f = 0; f < atlas->Fonts.Size; f++) {
+        const ImFont* font = atlas->Fonts.Data[f];
+        ImGui_ImplD2D_FontInfo info;
+        info.FontSize = font->FontSize;
+        info.Scale = font->Scale;
+        info.Ascent = font->Ascent;
+        info.GlyphOffset = Glyphs.Size;
+        info.GlyphCount = font->Glyphs.Size;
+        Fonts.push_back(info);
+        for (int c = 0; c < font->Glyphs.Size; c++) {
+            const ImFontGlyph& src = font->Glyphs[c];
+            ImGui_ImplD2D_FontGlyph glyph;
+            glyph.Codepoint = src.Codepoint;
+            glyph.X0 = src.X0;
+            glyph.Y0 = src.Y0;
+            glyph.U0 = src.U0;
+            glyph.V0 = src.V0;
+            glyph.U1 = src.U1;
+            glyph.V1 = src.V1;
+            Glyphs.push_back(glyph);
+        }
+    }
+    BuildLookup();
+}
+
+void ImGui_ImplD2D_FontTable::UpdateMetrics(const ImFontAtlas* atlas) {
+    if (atlas->Fonts.Size != Fonts.Size) {
+        return;
+    }
+    for (int f = 0; f < Fonts.Size; f++) {
+        const ImFont* font = atlas->Fonts.Data[f];
+        Fonts[f].FontSize = font->FontSize;
+        Fonts[f].Scale = font->Scale;
+        Fonts[f].Ascent = font->Ascent;
+    }
+}
+
+void ImGui_ImplD2D_FontTable::Clear() {
+    TexID = nullptr;
+    Fonts.clear();
+    Glyphs.clear();
+    Lookup.clear();
+    MaxProbes = 0;
+}
+
+static inline ImU32 ImGui_ImplD2D_HashUV(const ImVec2& uv) {
+    ImU32 u, v;
+    memcpy(&u, &uv.x, sizeof(u));
+    memcpy(&v, &uv.y, sizeof(v));
+    ImU32 hash = u * 0x9E3779B1u ^ (v + 0x7F4A7C15u) * 0x85EBCA77u;
+    hash ^= hash >> 15;
+    return hash;
+}
+
+static inline bool ImGui_ImplD2D_IsGlyphCorner(const ImGui_ImplD2D_FontGlyph& glyph, const ImVec2& uv) {
+    return (uv.x == glyph.U0 && uv.y == glyph.V0) || (uv.x == glyph.U1 && uv.y == glyph.V1);
+}
+
+void ImGui_ImplD2D_FontTable::BuildLookup() {
+    // two corners per glyph, at most quarter of slots used keeps probe sequences short
+    int size = 16;
+    while (size < Glyphs.Size * 8) {
+        size *= 2;
+    }
+    Lookup.resize(size);
+    memset(Lookup.Data, 0xFF, Lookup.size_in_bytes());
+    MaxProbes = 0;
+    const ImU32 mask = (ImU32)size - 1;
+    for (int c = 0; c < Glyphs.Size; c++) {
+        const ImGui_ImplD2D_FontGlyph& glyph = Glyphs[c];
+        const ImVec2 corners[2] = { ImVec2(glyph.U0, glyph.V0), ImVec2(glyph.U1, glyph.V1) };
+        for (int k = 0; k < 2; k++) {
+            if (k == 1 && corners[1].x == corners[0].x && corners[1].y == corners[0].y) {
+                break;
+            }
+            ImU32 slot = ImGui_ImplD2D_HashUV(corners[k]) & mask;
+            int probes = 1;
+            while (Lookup[slot] >= 0) {
+                slot = (slot + 1) & mask;
+                probes++;
+            }
+            Lookup[slot] = c;
+            if (probes > MaxProbes) {
+                MaxProbes = probes;
+            }
+        }
+    }
+}
+
+int ImGui_ImplD2D_FontTable::FindFont(const ImVec2& uv) const {
+    const int c = FindGlyph(-1, uv);
+    if (c < 0) {
+        return -1;
+    }
+    for (int f = 0; f < Fonts.Size; f++) {
+        if (c >= Fonts[f].GlyphOffset && c < Fonts[f].GlyphOffset + Fonts[f].GlyphCount) {
+            return f;
+        }
+    }
+    return -1;
+}
+
+int ImGui_ImplD2D_FontTable::FindGlyph(int font, const ImVec2& uv) const {
+    if (Lookup.Size == 0) {
+        return -1;
+    }
+    const int first = font >= 0 ? Fonts[font].GlyphOffset : 0;
+    const int last = font >= 0 ? first + Fonts[font].GlyphCount : Glyphs.Size;
+    const ImU32 mask = (ImU32)Lookup.Size - 1;
+    for (ImU32 slot = ImGui_ImplD2D_HashUV(uv) & mask; Lookup[slot] >= 0; slot = (slot + 1) & mask) {
+        const int c = Lookup[slot];
+        if (c >= first && c < last && ImGui_ImplD2D_IsGlyphCorner(Glyphs[c], uv)) {
+            return c;
+        }
+    }
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+// Translation
+//-----------------------------------------------------------------------------
+
+static ImGui_ImplD2D_Command* ImGui_ImplD2D_AddCommand(ImGui_ImplD2D_CommandList* out, ImGui_ImplD2D_CommandType type) {
+    out->Commands.resize(out->Commands.Size + 1);
+    ImGui_ImplD2D_Command* command = &out->Commands.back();
+    memset((void*)command, 0, sizeof(*command));
+    command->Type = type;
+    return command;
+}
+
+// Statistics of translation, compiled out of instantiations without ImGui_ImplD2D_TranslateFeatures_Stats
+#define IMGUI_IMPL_D2D_TRANSLATE_STATS                      ((Features & ImGui_ImplD2D_TranslateFeatures_Stats) != 0)
+#define IMGUI_IMPL_D2D_TRANSLATE_STAT_ADD(_FIELD, _VALUE)   do { if (IMGUI_IMPL_D2D_TRANSLATE_STATS) { IMGUI_IMPL_D2D_STAT_ADD(*stats, _FIELD, _VALUE); } } while (0)
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+#define IMGUI_IMPL_D2D_TRANSLATE_TIMER_BEGIN(_NAME)         const ImU64 _NAME = IMGUI_IMPL_D2D_TRANSLATE_STATS ? ImGui_ImplD2D_GetTicks() : 0
+#define IMGUI_IMPL_D2D_TRANSLATE_TIMER_END(_FIELD, _NAME)   do { if (IMGUI_IMPL_D2D_TRANSLATE_STATS) { stats->_FIELD += ImGui_ImplD2D_GetTicks() - (_NAME); } } while (0)
+#else
+#define IMGUI_IMPL_D2D_TRANSLATE_TIMER_BEGIN(_NAME)         ((void)0)
+#define IMGUI_IMPL_D2D_TRANSLATE_TIMER_END(_FIELD, _NAME)   ((void)0)
+#endif
+
+enum ImGui_ImplD2D_ClipTest_
+{
+    ImGui_ImplD2D_ClipTest_Outside,
+    ImGui_ImplD2D_ClipTest_Crossing,
+    ImGui_ImplD2D_ClipTest_Inside
+};
+
+/** @brief Where primitive with framebuffer space @p bounds lies relative to @p clip
+
+    Aliased clip keeps pixels with centers inside it & antialiasing stays within pixels touched by bounds, so clip is
+    rounded outwards to whole pixels for outside test & inwards for inside test. Result never changes drawn pixels.
+ */
+static inline int ImGui_ImplD2D_TestClip(const ImVec4& bounds, const ImVec4& clip) {
+    if (bounds.z <= floorf(clip.x) || bounds.w <= floorf(clip.y) || bounds.x >= ceilf(clip.z) || bounds.y >= ceilf(clip.w)) {
+        return ImGui_ImplD2D_ClipTest_Outside;
+    }
+    if (bounds.x >= ceilf(clip.x) && bounds.y >= ceilf(clip.y) && bounds.z <= floorf(clip.z) && bounds.w <= floorf(clip.w)) {
+        return ImGui_ImplD2D_ClipTest_Inside;
+    }
+    return ImGui_ImplD2D_ClipTest_Crossing;
+}
+
+static inline void ImGui_ImplD2D_AddBoundsPoint(ImVec4* bounds, const ImVec2& p) {
+    bounds->x = p.x < bounds->x ? p.x : bounds->x;
+    bounds->y = p.y < bounds->y ? p.y : bounds->y;
+    bounds->z = p.x > bounds->z ? p.x : bounds->z;
+    bounds->w = p.y > bounds->w ? p.y : bounds->w;
+}
+
+/** @brief Bounds in vertex space projected into framebuffer space, same as clip rectangles */
+static inline ImVec4 ImGui_ImplD2D_ProjectBounds(const ImVec4& bounds, const ImGui_ImplD2D_TranslateParams& params) {
+    return ImVec4((bounds.x - params.ClipOffset.x) * params.ClipScale.x, (bounds.y - params.ClipOffset.y) * params.ClipScale.y,
+        (bounds.z - params.ClipOffset.x) * params.ClipScale.x, (bounds.w - params.ClipOffset.y) * params.ClipScale.y);
+}
+
+/** @brief Clip rectangle lies inside of one of @see ImGui_ImplD2D_TranslateParams::Occluders */
+static inline bool ImGui_ImplD2D_IsOccluded(const ImVec4& clip, const ImGui_ImplD2D_TranslateParams& params) {
+    for (int n = 0; n < params.OccluderCount; n++) {
+        const ImVec4& occluder = params.Occluders[n];
+        if (clip.x >= occluder.x && clip.y >= occluder.y && clip.z <= occluder.z && clip.w <= occluder.w) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @brief Translate glyphs starting at @p offset into glyph run
+
+    With culling, run outside of @p clip is dropped (its indices are still consumed) & @p clipNeeded is set unless run
+    lies inside of @p clip.
+
+    @returns
+        This function returns number of indices used by glyph run, zero when triangles are not a glyph
+*/
+template<typename TIndex, int Features>
+static int ImGui_ImplD2D_TranslateGlyphRun(const ImGui_ImplD2D_TranslateParams& params,
+    const ImDrawCmd* pcmd,
+    const ImDrawVert* vert,
+    const TIndex* idx,
+    const int offset,
+    const ImVec4& clip,
+    bool* clipNeeded,
+    ImGui_ImplD2D_CommandList* out,
+    ImGui_ImplD2D_FrameStats* stats) {
+    IM_UNUSED(stats);
+    IMGUI_IMPL_D2D_ZONE("GlyphRun");
+    const ImGui_ImplD2D_FontTable* fonts = params.Fonts;
+    if (pcmd->GetTexID() != fonts->TexID || offset >= (int)pcmd->ElemCount) {
+        return 0;
+    }
+    const ImDrawVert* v0 = vert + idx[offset];
+    IMGUI_IMPL_D2D_TRANSLATE_STAT_ADD(ClassifySteps, 1);
+    const int font = fonts->FindFont(v0->uv);
+    // not a glpyh
+    if (font < 0) {
+        return 0;
+    }
+    const ImGui_ImplD2D_FontInfo& fontData = fonts->Fonts[font];
+    const float fontScale = params.FontGlobalScale * fontData.Scale;
+    const float top = (fontData.FontSize - fontData.Ascent) * fontScale;
+    const int glyphOffset = out->Glyphs.Size;
+    // Each letter is rendered as two polygons (4 vecticles/6 indicates)
+    constexpr int countPerLetter = 6;
+    // quads of glyphs, first & third index of quad are its opposite corners
+    ImVec4 bounds(v0->pos.x, v0->pos.y, v0->pos.x, v0->pos.y);
+    for (int i = offset; i < (int)pcmd->ElemCount; i += countPerLetter) {
+        const ImDrawVert* v = vert + idx[i];
+        IMGUI_IMPL_D2D_TRANSLATE_STAT_ADD(ClassifySteps, 1);
+        const int c = fonts->FindGlyph(font, v->uv);
+        if (c < 0) {
+            break;
+        }
+        const ImGui_ImplD2D_FontGlyph& glyph = fonts->Glyphs[c];
+        ImGui_ImplD2D_Glyph run;
+        run.Codepoint = glyph.Codepoint;
+        run.Pos = ImVec2(v->pos.x - glyph.X0 * fontScale, v->pos.y - glyph.Y0 * fontScale + top);
+        out->Glyphs.push_back(run);
+        if ((Features & ImGui_ImplD2D_TranslateFeatures_Cull) && i + 2 < (int)pcmd->ElemCount) {
+            ImGui_ImplD2D_AddBoundsPoint(&bounds, v->pos);
+            ImGui_ImplD2D_AddBoundsPoint(&bounds, vert[idx[i + 2]].pos);
+        }
+    }
+    const int glyphCount = out->Glyphs.Size - glyphOffset;
+    if (glyphCount == 0) {
+        return 0;
+    }
+    if (Features & ImGui_ImplD2D_TranslateFeatures_Cull) {
+        // DirectWrite outlines are not the atlas bitmaps, they may reach past quads (bearings, hinting), by font size at most
+        const float margin = fontData.FontSize * fontScale;
+        bounds = ImVec4(bounds.x - margin, bounds.y - margin, bounds.z + margin, bounds.w + margin);
+        const int test = ImGui_ImplD2D_TestClip(ImGui_ImplD2D_ProjectBounds(bounds, params), clip);
+        if (test == ImGui_ImplD2D_ClipTest_Outside) {
+            out->Glyphs.resize(glyphOffset);
+            IMGUI_IMPL_D2D_TRANSLATE_STAT_ADD(PrimitivesCulled, 1);
+            return glyphCount * countPerLetter;
+        }
+        *clipNeeded |= test != ImGui_ImplD2D_ClipTest_Inside;
+    }
+    ImGui_ImplD2D_Command* command = ImGui_ImplD2D_AddCommand(out, ImGui_ImplD2D_CommandType_GlyphRun);
+    command->Offset = glyphOffset;
+    command->Count = glyphCount;
+    command->Col[0] = v0->col;
+    command->Font = font;
+    command->FontSize = fontData.FontSize * fontScale;
+    return glyphCount * countPerLetter;
+}
+
+/** @brief Translate textured quad at @p offset into image
+
+    Quad must be axis aligned with texture coordinates following its corners & single color, like
+    ImDrawList::PrimRectUV() emits it. With culling, image outside of @p clip is dropped (its indices are still
+    consumed) & @p clipNeeded is set unless image lies inside of @p clip.
+
+    @returns
+        This function returns number of indices used by image, zero when triangles are not an image quad
+*/
+template<typename TIndex, int Features>
+static int ImGui_ImplD2D_TranslateImage(const ImGui_ImplD2D_TranslateParams& params,
+    const ImDrawCmd* pcmd,
+    const ImDrawVert* vert,
+    const TIndex* idx,
+    const int offset,
+    const ImVec4& clip,
+    bool* clipNeeded,
+    ImGui_ImplD2D_CommandList* out,
+    ImGui_ImplD2D_FrameStats* stats) {
+    IM_UNUSED(stats);
+    // triangles (a, b, c) & (a, c, d)
+    const TIndex* quad = idx + offset;
+    if (offset + 6 > (int)pcmd->ElemCount || quad[3] != quad[0] || quad[4] != quad[2]) {
+        return 0;
+    }
+    IMGUI_IMPL_D2D_TRANSLATE_STAT_ADD(ClassifySteps, 1);
+    const ImDrawVert& a = vert[quad[0]];
+    const ImDrawVert& b = vert[quad[1]];
+    const ImDrawVert& c = vert[quad[2]];
+    const ImDrawVert& d = vert[quad[5]];
+    if (b.col != a.col || c.col != a.col || d.col != a.col || a.pos.x >= c.pos.x || a.pos.y >= c.pos.y ||
+        a.uv.x > c.uv.x || a.uv.y > c.uv.y) {
+        return 0;
+    }
+    const bool corners =
+        b.pos.x == c.pos.x && b.pos.y == a.pos.y && d.pos.x == a.pos.x && d.pos.y == c.pos.y &&
+        b.uv.x == c.uv.x && b.uv.y == a.uv.y && d.uv.x == a.uv.x && d.uv.y == c.uv.y;
+    if (!corners) {
+        return 0;
+    }
+    if (Features & ImGui_ImplD2D_TranslateFeatures_Cull) {
+        const int test = ImGui_ImplD2D_TestClip(ImGui_ImplD2D_ProjectBounds(ImVec4(a.pos.x, a.pos.y, c.pos.x, c.pos.y), params), clip);
+        if (test == ImGui_ImplD2D_ClipTest_Outside) {
+            IMGUI_IMPL_D2D_TRANSLATE_STAT_ADD(PrimitivesCulled, 1);
+            return 6;
+        }
+        *clipNeeded |= test != ImGui_ImplD2D_ClipTest_Inside;
+    }
+    ImGui_ImplD2D_Command* command = ImGui_ImplD2D_AddCommand(out, ImGui_ImplD2D_CommandType_Image);
+    command->Pos[0] = a.pos;
+    command->Pos[1] = c.pos;
+    command->Pos[2] = a.uv;
+    command->Pos[3] = c.uv;
+    command->Col[0] = a.col;
+    command->Texture = pcmd->GetTexID();
+    return 6;
+}
+
+/** @brief Translation loop for one index type & feature set, checks of disabled features are removed at compile time */
+template<typename TIndex, int Features>
+static void ImGui_ImplD2D_TranslateIndexed(const ImDrawList* drawList, const TIndex* idx_buffer, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_CommandList* out, ImGui_ImplD2D_FrameStats* stats) {
+    IM_ASSERT(out != nullptr && stats != nullptr);
+    IM_ASSERT(((Features & ImGui_ImplD2D_TranslateFeatures_Text) == 0 || params.Fonts != nullptr) && "Text requires font table");
+    IM_UNUSED(stats);
+    IMGUI_IMPL_D2D_ZONE("TranslateDrawList");
+    IMGUI_IMPL_D2D_TRANSLATE_TIMER_BEGIN(translateStart);
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    const ImU64 glyphTimeStart = stats->GlyphTime;
+#endif
+    // block scanner counts its steps, discarded without statistics
+    ImGui_ImplD2D_FrameStats scanStatsIgnored;
+    memset(&scanStatsIgnored, 0, sizeof(scanStatsIgnored));
+    ImGui_ImplD2D_FrameStats* scanStats = IMGUI_IMPL_D2D_TRANSLATE_STATS ? stats : &scanStatsIgnored;
+    const ImVec2 clip_off = params.ClipOffset;
+    const ImVec2 clip_scale = params.ClipScale;
+    const float fb_width = params.FramebufferSize.x;
+    const float fb_height = params.FramebufferSize.y;
+    const ImDrawVert* vtx_buffer = drawList->VtxBuffer.Data;
+    for (int cmd_i = 0; cmd_i < drawList->CmdBuffer.Size; cmd_i++)
+    {
+        IMGUI_IMPL_D2D_ZONE("TranslateDrawCmd");
+        const ImDrawCmd* pcmd = &drawList->CmdBuffer[cmd_i];
+        if (pcmd->UserCallback)
+        {
+            ImGui_ImplD2D_Command* command = ImGui_ImplD2D_AddCommand(out, ImGui_ImplD2D_CommandType_Callback);
+            command->CallbackList = drawList;
+            command->CallbackCmd = pcmd;
+            continue;
+        }
+        // Project scissor/clipping rectangles into framebuffer space
+        ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+        ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+        if (clip_min.x < 0.0f) { clip_min.x = 0.0f; }
+        if (clip_min.y < 0.0f) { clip_min.y = 0.0f; }
+        if (clip_max.x > fb_width) { clip_max.x = fb_width; }
+        if (clip_max.y > fb_height) { clip_max.y = fb_height; }
+        if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+            continue;
+
+        const int indCount = (int)pcmd->ElemCount;
+        if (indCount == 0)
+        {
+            continue;
+        }
+        const ImVec4 clip(clip_min.x, clip_min.y, clip_max.x, clip_max.y);
+        // pixels command could draw are all replaced by opaque rectangle drawn later
+        if (params.OccluderCount > 0 && ImGui_ImplD2D_IsOccluded(clip, params)) {
+            IMGUI_IMPL_D2D_TRANSLATE_STAT_ADD(DrawCommandsOccluded, 1);
+            continue;
+        }
+        if (out->ClipBounds.z <= out->ClipBounds.x) {
+            out->ClipBounds = clip;
+        }
+        else {
+            ImGui_ImplD2D_AddBoundsPoint(&out->ClipBounds, clip_min);
+            ImGui_ImplD2D_AddBoundsPoint(&out->ClipBounds, clip_max);
+        }
+        const int clipCommand = out->Commands.Size;
+        ImGui_ImplD2D_AddCommand(out, ImGui_ImplD2D_CommandType_PushClip)->Rect = clip;
+        // stays false while every primitive lies inside of clip, which is then dropped
+        bool clipNeeded = (Features & ImGui_ImplD2D_TranslateFeatures_Cull) == 0;
+
+        const ImDrawVert* vert = vtx_buffer + pcmd->VtxOffset;
+        const TIndex* idx = idx_buffer + pcmd->IdxOffset;
+        // font atlas is only sampled by glyphs, quads of other textures are drawn as bitmaps
+        const bool image = params.Fonts != nullptr && pcmd->GetTexID() != params.Fonts->TexID;
+        int idxOffset = 0;
+        // trailing indices not forming whole triangle are ignored
+        while (idxOffset + 2 < indCount) {
+            const int prev = idxOffset;
+            if (Features & ImGui_ImplD2D_TranslateFeatures_Text) {
+                // text is drawn with DirectWrite, check for it before scanning triangles, so each index is
+                // either consumed by glyph run or scanned at most twice (cost stays linear in index count)
+                IMGUI_IMPL_D2D_TRANSLATE_TIMER_BEGIN(glyphStart);
+                const int skip = ImGui_ImplD2D_TranslateGlyphRun<TIndex, Features>(params, pcmd, vert, idx, prev, clip, &clipNeeded, out, stats);
+                IMGUI_IMPL_D2D_TRANSLATE_TIMER_END(GlyphTime, glyphStart);
+                if (skip != 0) {
+                    idxOffset = prev + skip;
+                    continue;
+                }
+            }
+            if (image) {
+                const int skip = ImGui_ImplD2D_TranslateImage<TIndex, Features>(params, pcmd, vert, idx, prev, clip, &clipNeeded, out, stats);
+                if (skip != 0) {
+                    idxOffset = prev + skip;
+                    continue;
+                }
+            }
+            int polygonIndicates = 0;
+            int polygonColorsCount = 1;
+            TIndex prevIdx[3] = { idx[idxOffset + 0], idx[idxOffset + 1], idx[idxOffset + 2] };
+            ImU32 polygonColors[6] = { (vert + prevIdx[0])->col, 0x0, 0x0, 0x0, 0x0, 0x0 };
+            {
+                IMGUI_IMPL_D2D_ZONE("DetectPolygon");
+                for (int i = idxOffset; i + 2 < indCount; i += 3) {
+                    if (polygonColorsCount == 1 && polygonIndicates >= 6) {
+                        // rest of long solid polygon (e.g. anti-aliased fill) is consumed by block scanner
+                        const int run = ImGui_ImplD2D_ScanSolidRun(idx, i, indCount, vert, polygonColors[0], scanStats);
+                        if (run > 0) {
+                            i += 3 * run;
+                            polygonIndicates += 3 * run;
+                            memcpy(&prevIdx, idx + i - 3, sizeof(prevIdx));
+                            if (i + 2 >= indCount) {
+                                break;
+                            }
+                        }
+                    }
+                    IMGUI_IMPL_D2D_TRANSLATE_STAT_ADD(ClassifySteps, 1);
+                    TIndex currIdx[3] = { idx[i], idx[i + 1], idx[i + 2] };
+                    const bool commonIndicateTest =
+                        prevIdx[0] == currIdx[0] || prevIdx[0] == currIdx[1] || prevIdx[0] == currIdx[2] ||
+                        prevIdx[1] == currIdx[0] || prevIdx[1] == currIdx[1] || prevIdx[1] == currIdx[2] ||
+                        prevIdx[2] == currIdx[0] || prevIdx[2] == currIdx[1] || prevIdx[2] == currIdx[2];
+                    if (commonIndicateTest == false) {
+                        break;
+                    }
+                    const ImU32 currCol[3] = { (vert + currIdx[0])->col, (vert + currIdx[1])->col, (vert + currIdx[2])->col };
+                    int nextPolygonColorsCount = polygonColorsCount;
+                    for (int c = 0; c < 3; c++) {
+                        bool nextColor = true;
+                        for (int p = 0; p < nextPolygonColorsCount; p++) {
+                            if (currCol[c] == polygonColors[p]) {
+                                nextColor = false;
+                                break;
+                            }
+                        }
+                        if (nextColor) {
+                            polygonColors[nextPolygonColorsCount] = currCol[c];
+                            nextPolygonColorsCount++;
+                        }
+                    }
+
+                    // only triangles & quads can be renderer with more than one color
+                    if (polygonIndicates > 6 && nextPolygonColorsCount > 1) {
+                        break;
+                    }
+                    polygonColorsCount = nextPolygonColorsCount;
+                    memcpy(&prevIdx, &currIdx, sizeof(currIdx));
+                    polygonIndicates += 3;
+                    if (polygonIndicates >= 3 && polygonColorsCount > 2) {
+                        break;
+                    }
+                    if (polygonIndicates == 6 && polygonColorsCount == 2) {
+                        break;
+                    }
+                }
+            }
+            const int idxStart = idxOffset;
+            idxOffset += polygonIndicates;
+            if (polygonColorsCount > 3) {
+                // not supported
+                continue;
+            }
+            static const ImGui_ImplD2D_CommandType types[] = { ImGui_ImplD2D_CommandType_Solid, ImGui_ImplD2D_CommandType_Solid, ImGui_ImplD2D_CommandType_LinearGradient, ImGui_ImplD2D_CommandType_RadialGradient };
+            const bool gradient = (Features & ImGui_ImplD2D_TranslateFeatures_Gradients) != 0 && polygonColorsCount > 1;
+            ImGui_ImplD2D_Command* command = ImGui_ImplD2D_AddCommand(out, gradient ? types[polygonColorsCount] : ImGui_ImplD2D_CommandType_Solid);
+            command->Offset = out->Points.Size;
+            command->Count = polygonIndicates / 3;
+            out->Points.resize(out->Points.Size + polygonIndicates);
+            ImVec2* points = out->Points.Data + command->Offset;
+            for (int i = idxStart; i < idxOffset; i++) {
+                *points++ = (vert + idx[i])->pos;
+            }
+            if (Features & ImGui_ImplD2D_TranslateFeatures_Cull) {
+                ImVec4 bounds;
+                ImGui_ImplD2D_GetPointsBounds(out->Points.Data + command->Offset, polygonIndicates, &bounds);
+                const int test = ImGui_ImplD2D_TestClip(ImGui_ImplD2D_ProjectBounds(bounds, params), clip);
+                if (test == ImGui_ImplD2D_ClipTest_Outside) {
+                    out->Points.resize(command->Offset);
+                    out->Commands.pop_back();
+                    IMGUI_IMPL_D2D_TRANSLATE_STAT_ADD(PrimitivesCulled, 1);
+                    continue;
+                }
+                clipNeeded |= test != ImGui_ImplD2D_ClipTest_Inside;
+            }
+            if (!gradient) {
+                command->Col[0] = polygonColors[0];
+                continue;
+            }
+            const ImDrawVert* verts[4] = {
+                vert + idx[idxStart],
+                vert + idx[idxStart + 1],
+                vert + idx[idxStart + 2],
+                vert + idx[idxOffset - 1],
+            };
+            if (polygonColorsCount == 2) {
+                const int a = verts[0]->col == verts[3]->col ? 0 : 1;
+                command->Pos[0] = verts[a]->pos;
+                command->Pos[1] = verts[a + 1]->pos;
+                command->Col[0] = verts[a]->col;
+                command->Col[1] = verts[a + 1]->col;
+            }
+            else {
+                for (int c = 0; c < 4; c++) {
+                    command->Pos[c] = verts[c]->pos;
+                    command->Col[c] = verts[c]->col;
+                }
+            }
+        }
+        if (!clipNeeded) {
+            // nothing crosses clip edges (or nothing is left at all), clip would not change any pixel
+            out->Commands.erase(out->Commands.Data + clipCommand);
+            IMGUI_IMPL_D2D_TRANSLATE_STAT_ADD(ClipsSkipped, 1);
+            continue;
+        }
+        ImGui_ImplD2D_AddCommand(out, ImGui_ImplD2D_CommandType_PopClip);
+    }
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    if (IMGUI_IMPL_D2D_TRANSLATE_STATS) {
+        // glyph time is reported on its own
+        stats->ClassifyTime += ImGui_ImplD2D_GetTicks() - translateStart - (stats->GlyphTime - glyphTimeStart);
+    }
+#endif
+}
+
+#undef IMGUI_IMPL_D2D_TRANSLATE_STATS
+#undef IMGUI_IMPL_D2D_TRANSLATE_STAT_ADD
+#undef IMGUI_IMPL_D2D_TRANSLATE_TIMER_BEGIN
+#undef IMGUI_IMPL_D2D_TRANSLATE_TIMER_END
+
+template<typename TIndex>
+static void ImGui_ImplD2D_TranslateDispatch(const ImDrawList* drawList, const TIndex* idxBuffer, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_CommandList* out, ImGui_ImplD2D_FrameStats* stats) {
+    ImGui_ImplD2D_TranslateFeatures features = params.Features & ImGui_ImplD2D_TranslateFeatures_All;
+    if (params.Fonts == nullptr) {
+        features &= ~ImGui_ImplD2D_TranslateFeatures_Text;
+    }
+    switch (features) {
+    case 0: ImGui_ImplD2D_TranslateIndexed<TIndex, 0>(drawList, idxBuffer, params, out, stats); break;
+    case 1: ImGui_ImplD2D_TranslateIndexed<TIndex, 1>(drawList, idxBuffer, params, out, stats); break;
+    case 2: ImGui_ImplD2D_TranslateIndexed<TIndex, 2>(drawList, idxBuffer, params, out, stats); break;
+    case 3: ImGui_ImplD2D_TranslateIndexed<TIndex, 3>(drawList, idxBuffer, params, out, stats); break;
+    case 4: ImGui_ImplD2D_TranslateIndexed<TIndex, 4>(drawList, idxBuffer, params, out, stats); break;
+    case 5: ImGui_ImplD2D_TranslateIndexed<TIndex, 5>(drawList, idxBuffer, params, out, stats); break;
+    case 6: ImGui_ImplD2D_TranslateIndexed<TIndex, 6>(drawList, idxBuffer, params, out, stats); break;
+    case 7: ImGui_ImplD2D_TranslateIndexed<TIndex, 7>(drawList, idxBuffer, params, out, stats); break;
+    case 8: ImGui_ImplD2D_TranslateIndexed<TIndex, 8>(drawList, idxBuffer, params, out, stats); break;
+    case 9: ImGui_ImplD2D_TranslateIndexed<TIndex, 9>(drawList, idxBuffer, params, out, stats); break;
+    case 10: ImGui_ImplD2D_TranslateIndexed<TIndex, 10>(drawList, idxBuffer, params, out, stats); break;
+    case 11: ImGui_ImplD2D_TranslateIndexed<TIndex, 11>(drawList, idxBuffer, params, out, stats); break;
+    case 12: ImGui_ImplD2D_TranslateIndexed<TIndex, 12>(drawList, idxBuffer, params, out, stats); break;
+    case 13: ImGui_ImplD2D_TranslateIndexed<TIndex, 13>(drawList, idxBuffer, params, out, stats); break;
+    case 14: ImGui_ImplD2D_TranslateIndexed<TIndex, 14>(drawList, idxBuffer, params, out, stats); break;
+    default: ImGui_ImplD2D_TranslateIndexed<TIndex, 15>(drawList, idxBuffer, params, out, stats); break;
+    }
+}
+
+void ImGui_ImplD2D_TranslateDrawList(const ImDrawList* drawList, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_CommandList* out, ImGui_ImplD2D_FrameStats* stats) {
+    ImGui_ImplD2D_TranslateDispatch(drawList, drawList->IdxBuffer.Data, params, out, stats);
+}
+
+void ImGui_ImplD2D_TranslateDrawList(const ImDrawList* drawList, const ImU16* idxBuffer, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_CommandList* out, ImGui_ImplD2D_FrameStats* stats) {
+    ImGui_ImplD2D_TranslateDispatch(drawList, idxBuffer, params, out, stats);
+}
+
+void ImGui_ImplD2D_TranslateDrawList(const ImDrawList* drawList, const ImU32* idxBuffer, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_CommandList* out, ImGui_ImplD2D_FrameStats* stats) {
+    ImGui_ImplD2D_TranslateDispatch(drawList, idxBuffer, params, out, stats);
+}
+
+void ImGui_ImplD2D_AddFrameStats(ImGui_ImplD2D_FrameStats* dst, const ImGui_ImplD2D_FrameStats& src) {
+    dst->GeometriesCreated += src.GeometriesCreated;
+    dst->GeometriesReused += src.GeometriesReused;
+    dst->BrushesCreated += src.BrushesCreated;
+    dst->FillGeometryCalls += src.FillGeometryCalls;
+    dst->DrawTextCalls += src.DrawTextCalls;
+    dst->DrawBitmapCalls += src.DrawBitmapCalls;
+    dst->ClipCalls += src.ClipCalls;
+    dst->SolidPolygons += src.SolidPolygons;
+    dst->LinearGradientPolygons += src.LinearGradientPolygons;
+    dst->RadialGradientPolygons += src.RadialGradientPolygons;
+    dst->Glyphs += src.Glyphs;
+    dst->PrimitivesCulled += src.PrimitivesCulled;
+    dst->ClipsSkipped += src.ClipsSkipped;
+    dst->DrawCommandsOccluded += src.DrawCommandsOccluded;
+    dst->DrawListsTranslated += src.DrawListsTranslated;
+    dst->DrawListsReused += src.DrawListsReused;
+    dst->LayersDrawn += src.LayersDrawn;
+    dst->LayersReused += src.LayersReused;
+    dst->ClassifySteps += src.ClassifySteps;
+    dst->FontAtlasUploads += src.FontAtlasUploads;
+    dst->FactoryLocks += src.FactoryLocks;
+    dst->RenderTime += src.RenderTime;
+    dst->ClassifyTime += src.ClassifyTime;
+    dst->GlyphTime += src.GlyphTime;
+    dst->SubmitTime += src.SubmitTime;
+    dst->FactoryLockWaitTime += src.FactoryLockWaitTime;
+    dst->FactoryLockHoldTime += src.FactoryLockHoldTime;
+}
+
+ImGuiID ImGui_ImplD2D_GetDrawListKey(const ImDrawList* drawList, int index) {
+    if (drawList->_OwnerName != nullptr) {
+        return (ImGuiID)ImGui_ImplD2D_Hash(drawList->_OwnerName, strlen(drawList->_OwnerName), 0);
+    }
+    return (ImGuiID)ImGui_ImplD2D_Hash(&index, sizeof(index), 1);
+}
+
+/** @brief Hash of everything translation reads besides draw list, font table pointer differs between snapshots so contents are hashed */
+static ImU64 ImGui_ImplD2D_HashParams(const ImGui_ImplD2D_TranslateParams& params) {
+    const float values[] = { params.FontGlobalScale, params.ClipOffset.x, params.ClipOffset.y, params.ClipScale.x, params.ClipScale.y,
+        params.FramebufferSize.x, params.FramebufferSize.y, (float)params.Features };
+    ImU64 h = ImGui_ImplD2D_Hash(values, sizeof(values), 0);
+    if (params.Fonts != nullptr) {
+        const ImGui_ImplD2D_FontTable& fonts = *params.Fonts;
+        h = ImGui_ImplD2D_Hash(&fonts.Version, sizeof(fonts.Version), h);
+        h = ImGui_ImplD2D_Hash(&fonts.TexID, sizeof(fonts.TexID), h);
+        h = ImGui_ImplD2D_Hash(fonts.Fonts.Data, (size_t)fonts.Fonts.size_in_bytes(), h);
+    }
+    return h;
+}
+
+/** @brief Shared by jobs translating draw lists of one frame */
+struct ImGui_ImplD2D_TranslateJobData
+{
+    const ImDrawData* DrawData;
+    const ImGui_ImplD2D_TranslateParams* Params;
+    ImGui_ImplD2D_FrameCommands* Frame;
+};
+
+static void ImGui_ImplD2D_TranslateJob(int index, void* jobData) {
+    const ImGui_ImplD2D_TranslateJobData* data = (const ImGui_ImplD2D_TranslateJobData*)jobData;
+    IM_ASSERT(index >= 0 && index < data->Frame->Count);
+    // each job writes only its own command list & statistics
+    const ImDrawList* drawList = data->DrawData->CmdLists[index];
+    ImGui_ImplD2D_CommandList* list = data->Frame->Lists[index];
+    ImGui_ImplD2D_FrameStats* stats = &data->Frame->ListStats[index];
+    memset(stats, 0, sizeof(*stats));
+    const bool reuse = data->Frame->ReuseUnchanged;
+    const bool hashed = reuse || data->Frame->HashLists;
+    const bool occlusion = data->Frame->OcclusionCulling;
+    // translation depends on occluders in front of draw list too
+    const ImU64 seed = occlusion ? ImGui_ImplD2D_Hash(&data->Frame->Occlusion.ListHashes[index], sizeof(ImU64), data->Frame->ParamsHash) : data->Frame->ParamsHash;
+    const ImU64 hash = hashed ? ImGui_ImplD2D_HashDrawList(drawList, seed) : 0;
+    if (reuse && list->Reusable && list->Hash == hash) {
+        IMGUI_IMPL_D2D_STAT_ADD(*stats, DrawListsReused, 1);
+        return;
+    }
+    list->Reset();
+    if (occlusion) {
+        ImGui_ImplD2D_TranslateParams params = *data->Params;
+        params.OccluderCount = data->Frame->Occlusion.GetOccludersInFront(index, &params.Occluders);
+        ImGui_ImplD2D_TranslateDrawList(drawList, params, list, stats);
+    }
+    else {
+        ImGui_ImplD2D_TranslateDrawList(drawList, *data->Params, list, stats);
+    }
+    IMGUI_IMPL_D2D_STAT_ADD(*stats, DrawListsTranslated, 1);
+    list->Hash = hash;
+    list->Reusable = hashed;
+    for (int c = 0; c < list->Commands.Size && list->Reusable; c++) {
+        list->Reusable = list->Commands[c].Type != ImGui_ImplD2D_CommandType_Callback;
+    }
+}
+
+/** @brief Grow buffers of @p list to the most translation of @p drawList can emit, so jobs never allocate
+
+    Every solid, gradient or image command consumes at least one triangle & glyph run at least one quad, points are
+    copied from at most every index, each draw command adds up to two clip commands (or one callback).
+ */
+static void ImGui_ImplD2D_ReserveCommandList(ImGui_ImplD2D_CommandList* list, const ImDrawList* drawList) {
+    const int indices = drawList->IdxBuffer.Size;
+    list->Commands.reserve(indices / 3 + drawList->CmdBuffer.Size * 2);
+    list->Points.reserve(indices);
+    list->Glyphs.reserve(indices / 6);
+}
+
+static ImGuiID ImGui_ImplD2D_GetListKey(const ImDrawData* drawData, const ImGuiID* listKeys, int index) {
+    return listKeys != nullptr ? listKeys[index] : ImGui_ImplD2D_GetDrawListKey(drawData->CmdLists[index], index);
+}
+
+void ImGui_ImplD2D_FrameCommands::Translate(const ImDrawData* drawData, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_ParallelForFunc parallelFor, void* parallelForUserData, ImGui_ImplD2D_FrameStats* stats, const ImGuiID* listKeys) {
+    IM_ASSERT(drawData != nullptr && stats != nullptr);
+    IMGUI_IMPL_D2D_ZONE("TranslateDrawData");
+    // lists are allocated here, so jobs never resize shared vectors
+    const int previousCount = Count;
+    Count = drawData->CmdListsCount;
+    if (ReuseUnchanged || HashLists) {
+        // command list of previous frame follows its draw list when windows are reordered, leftovers take free slots
+        ParamsHash = ImGui_ImplD2D_HashParams(params);
+        PreviousLists.resize(0);
+        PreviousKeys.Data.resize(0);
+        for (int n = 0; n < Lists.Size; n++) {
+            PreviousLists.push_back(Lists[n]);
+            if (n < previousCount) {
+                PreviousKeys.SetInt(Lists[n]->Key, n + 1);
+            }
+        }
+        Lists.resize(0);
+        for (int n = 0; n < Count; n++) {
+            const int previous = PreviousKeys.GetInt(ImGui_ImplD2D_GetListKey(drawData, listKeys, n), 0) - 1;
+            ImGui_ImplD2D_CommandList* list = nullptr;
+            if (previous >= 0 && PreviousLists[previous] != nullptr) {
+                list = PreviousLists[previous];
+                PreviousLists[previous] = nullptr;
+            }
+            Lists.push_back(list);
+        }
+        int free = 0;
+        for (int n = 0; n < Count; n++) {
+            while (Lists[n] == nullptr && free < PreviousLists.Size) {
+                Lists[n] = PreviousLists[free++];
+            }
+            if (Lists[n] == nullptr) {
+                Lists[n] = IM_NEW(ImGui_ImplD2D_CommandList)();
+            }
+            Lists[n]->Key = ImGui_ImplD2D_GetListKey(drawData, listKeys, n);
+        }
+        for (; free < PreviousLists.Size; free++) {
+            if (PreviousLists[free] != nullptr) {
+                Lists.push_back(PreviousLists[free]);
+            }
+        }
+    }
+    while (Lists.Size < Count) {
+        Lists.push_back(IM_NEW(ImGui_ImplD2D_CommandList)());
+    }
+    ListStats.resize(Count);
+    if (OcclusionCulling) {
+        Occlusion.Compute(drawData, params);
+    }
+
+    ImGui_ImplD2D_TranslateJobData data;
+    data.DrawData = drawData;
+    data.Params = &params;
+    data.Frame = this;
+    if (parallelFor != nullptr && Count > 1) {
+        // ImGui allocator counts allocations in GImGui without synchronization, jobs must not reach it
+        for (int n = 0; n < Count; n++) {
+            ImGui_ImplD2D_ReserveCommandList(Lists[n], drawData->CmdLists[n]);
+        }
+        parallelFor(Count, ImGui_ImplD2D_TranslateJob, &data, parallelForUserData);
+    }
+    else {
+        for (int n = 0; n < Count; n++) {
+            ImGui_ImplD2D_TranslateJob(n, &data);
+        }
+    }
+    for (int n = 0; n < Count; n++) {
+        ImGui_ImplD2D_AddFrameStats(stats, ListStats[n]);
+    }
+}
+
+void ImGui_ImplD2D_FrameCommands::Clear() {
+    for (int n = 0; n < Lists.Size; n++) {
+        IM_DELETE(Lists[n]);
+    }
+    Lists.clear();
+    ListStats.clear();
+    PreviousLists.clear();
+    PreviousKeys.Clear();
+    Occlusion.Clear();
+    Count = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Submission
+//-----------------------------------------------------------------------------
+
+void ImGui_ImplD2D_SubmitCommandList(const ImGui_ImplD2D_CommandList& list, ImGui_ImplD2D_Device* device, ImGui_ImplD2D_FrameStats* stats, ImGui_ImplD2D_GeometryCache* geometries) {
+    IM_ASSERT(device != nullptr && stats != nullptr);
+    IM_UNUSED(stats);
+    IMGUI_IMPL_D2D_ZONE("SubmitCommandList");
+    IMGUI_IMPL_D2D_STAT_TIMER_BEGIN(submitStart);
+    if (geometries != nullptr && !geometries->IsEnabled()) {
+        geometries = nullptr;
+    }
+    // cached geometries are drawn with transform to their origin, clips, callbacks, images, following lists & layer
+    // list is drawn into (see ImGui_ImplD2D_LayerCache::Submit()) expect none
+    bool transformed = false;
+    for (int n = 0; n < list.Commands.Size; n++) {
+        const ImGui_ImplD2D_Command& command = list.Commands[n];
+        switch (command.Type) {
+        case ImGui_ImplD2D_CommandType_PushClip:
+            // clip rectangles are in framebuffer space, device transforms them too
+            if (transformed) {
+                device->SetTransform(ImVec2(0, 0));
+                transformed = false;
+            }
+            device->PushAxisAlignedClip(command.Rect);
+            IMGUI_IMPL_D2D_STAT_ADD(*stats, ClipCalls, 1);
+            break;
+        case ImGui_ImplD2D_CommandType_PopClip:
+            if (transformed) {
+                device->SetTransform(ImVec2(0, 0));
+                transformed = false;
+            }
+            device->PopAxisAlignedClip();
+            IMGUI_IMPL_D2D_STAT_ADD(*stats, ClipCalls, 1);
+            break;
+        case ImGui_ImplD2D_CommandType_Callback:
+            // User callback, registered via ImDrawList::AddCallback()
+            // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+            if (transformed) {
+                device->SetTransform(ImVec2(0, 0));
+                transformed = false;
+            }
+            if (command.CallbackCmd->UserCallback != ImDrawCallback_ResetRenderState) {
+                command.CallbackCmd->UserCallback(command.CallbackList, command.CallbackCmd);
+            }
+            break;
+        case ImGui_ImplD2D_CommandType_GlyphRun: {
+            void* format = device->CreateTextFormat(command.Font, command.FontSize);
+            if (format == nullptr) {
+                break;
+            }
+            device->SetSolidColor(command.Col[0]);
+            device->SetTransform(ImVec2(0, 0));
+            transformed = false;
+            for (int g = command.Offset; g < command.Offset + command.Count; g++) {
+                device->DrawGlyph(format, list.Glyphs[g].Codepoint, list.Glyphs[g].Pos);
+            }
+            device->ReleaseTextFormat(format);
+            IMGUI_IMPL_D2D_STAT_ADD(*stats, Glyphs, command.Count);
+            IMGUI_IMPL_D2D_STAT_ADD(*stats, DrawTextCalls, command.Count);
+            break;
+        }
+        case ImGui_ImplD2D_CommandType_Image:
+            if (transformed) {
+                device->SetTransform(ImVec2(0, 0));
+                transformed = false;
+            }
+            device->DrawImage(command.Texture, ImVec4(command.Pos[0].x, command.Pos[0].y, command.Pos[1].x, command.Pos[1].y), command.Pos[2], command.Pos[3], command.Col[0]);
+            IMGUI_IMPL_D2D_STAT_ADD(*stats, DrawBitmapCalls, 1);
+            break;
+        case ImGui_ImplD2D_CommandType_Solid:
+        case ImGui_ImplD2D_CommandType_LinearGradient:
+        case ImGui_ImplD2D_CommandType_RadialGradient: {
+            // geometry & gradients are relative to origin when geometry comes from cache
+            ImVec2 origin(0, 0);
+            bool cached = false;
+            void* geometry = nullptr;
+            if (geometries != nullptr) {
+                geometry = geometries->Acquire(list.Points.Data + command.Offset, command.Count, device, &origin, &cached, stats);
+                if (geometry != nullptr) {
+                    device->SetTransform(origin);
+                    transformed = true;
+                }
+            }
+            else {
+                geometry = device->CreateGeometry(list.Points.Data + command.Offset, command.Count);
+                IMGUI_IMPL_D2D_STAT_ADD(*stats, GeometriesCreated, geometry != nullptr ? 1 : 0);
+            }
+            if (geometry == nullptr) {
+                break;
+            }
+            ImVec2 pos[4];
+            for (int p = 0; p < 4; p++) {
+                pos[p] = ImVec2(command.Pos[p].x - origin.x, command.Pos[p].y - origin.y);
+            }
+            device->SetAntialiasMode(false);
+            if (command.Type == ImGui_ImplD2D_CommandType_Solid) {
+                device->SetSolidColor(command.Col[0]);
+                device->FillGeometry(geometry, nullptr);
+                IMGUI_IMPL_D2D_STAT_ADD(*stats, SolidPolygons, 1);
+                IMGUI_IMPL_D2D_STAT_ADD(*stats, FillGeometryCalls, 1);
+            }
+            else if (command.Type == ImGui_ImplD2D_CommandType_LinearGradient) {
+                IMGUI_IMPL_D2D_STAT_ADD(*stats, LinearGradientPolygons, 1);
+                void* brush = device->CreateLinearGradientBrush(pos[0], pos[1], command.Col[0], command.Col[1]);
+                if (brush != nullptr) {
+                    IMGUI_IMPL_D2D_STAT_ADD(*stats, BrushesCreated, 1);
+                    device->SetAntialiasMode(true);
+                    device->FillGeometry(geometry, brush);
+                    IMGUI_IMPL_D2D_STAT_ADD(*stats, FillGeometryCalls, 1);
+                    device->ReleaseBrush(brush);
+                }
+            }
+            else {
+                IMGUI_IMPL_D2D_STAT_ADD(*stats, RadialGradientPolygons, 1);
+                device->SetAntialiasMode(true);
+                // gradient from each corner towards the opposite one, fourth corner only for quads
+                static const int corners[4][2] = { { 0, 2 }, { 2, 0 }, { 1, 3 }, { 3, 1 } };
+                const int cornerCount = command.Count > 1 ? 4 : 3;
+                for (int c = 0; c < cornerCount; c++) {
+                    const int a = corners[c][0];
+                    const int b = corners[c][1];
+                    void* brush = device->CreateRadialGradientBrush(pos[a], pos[b], command.Col[a], command.Col[a] & 0x00FFFFFFu);
+                    if (brush == nullptr) {
+                        continue;
+                    }
+                    IMGUI_IMPL_D2D_STAT_ADD(*stats, BrushesCreated, 1);
+                    device->FillGeometry(geometry, brush);
+                    IMGUI_IMPL_D2D_STAT_ADD(*stats, FillGeometryCalls, 1);
+                    device->ReleaseBrush(brush);
+                }
+            }
+            if (!cached) {
+                device->ReleaseGeometry(geometry);
+            }
+            break;
+        }
+        }
+    }
+    if (transformed) {
+        device->SetTransform(ImVec2(0, 0));
+    }
+    IMGUI_IMPL_D2D_STAT_TIMER_END(*stats, SubmitTime, submitStart);
+}
+
+void ImGui_ImplD2D_CommandBuffer::Build(const ImDrawData* drawData, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_ParallelForFunc parallelFor, void* parallelForUserData) {
+    IMGUI_IMPL_D2D_ZONE("BuildCommandBuffer");
+    memset(&BuildStats, 0, sizeof(BuildStats));
+    Frame.Translate(drawData, params, parallelFor, parallelForUserData, &BuildStats);
+
+    // copy callbacks first, commands are pointed at copies once vector no longer grows
+    Callbacks.resize(0);
+    for (int n = 0; n < Frame.Count; n++) {
+        const ImGui_ImplD2D_CommandList& list = *Frame.Lists[n];
+        for (int c = 0; c < list.Commands.Size; c++) {
+            if (list.Commands[c].Type == ImGui_ImplD2D_CommandType_Callback) {
+                Callbacks.push_back(*list.Commands[c].CallbackCmd);
+            }
+        }
+    }
+    int callback = 0;
+    for (int n = 0; n < Frame.Count; n++) {
+        ImGui_ImplD2D_CommandList& list = *Frame.Lists[n];
+        for (int c = 0; c < list.Commands.Size; c++) {
+            if (list.Commands[c].Type == ImGui_ImplD2D_CommandType_Callback) {
+                list.Commands[c].CallbackList = nullptr;
+                list.Commands[c].CallbackCmd = &Callbacks[callback++];
+            }
+        }
+    }
+}
+
+void ImGui_ImplD2D_CommandBuffer::Submit(ImGui_ImplD2D_Device* device, ImGui_ImplD2D_FrameStats* stats) const {
+    for (int n = 0; n < Frame.Count; n++) {
+        ImGui_ImplD2D_SubmitCommandList(*Frame.Lists[n], device, stats);
+    }
+}
+
+int ImGui_ImplD2D_RecordingDevice::GetTotalCalls() const {
+    int total = 0;
+    for (int n = 0; n < Call_COUNT; n++) {
+        total += Calls[n];
+    }
+    return total;
+}
+
+const char* ImGui_ImplD2D_RecordingDevice::GetCallName(int call) {
+    static const char* const names[Call_COUNT] = {
+        "PushAxisAlignedClip",
+        "PopAxisAlignedClip",
+        "SetAntialiasMode",
+        "SetTransform",
+        "CreateGeometry",
+        "SetSolidColor",
+        "CreateLinearGradientBrush",
+        "CreateRadialGradientBrush",
+        "FillGeometry",
+        "CreateTextFormat",
+        "DrawGlyph",
+        "DrawImage",
+        "CreateLayer",
+        "BeginLayer",
+        "DrawLayer",
+    };
+    IM_ASSERT(call >= 0 && call < Call_COUNT);
+    return names[call];
+}
+
+#endif // #ifndef IMGUI_DISABLE
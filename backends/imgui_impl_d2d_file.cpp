@@ -0,0 +1,96 @@
+// dear imgui: Renderer Backend for Direct2D - memory mapped files
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+
+#include <cstdint>     // SIZE_MAX
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+
+bool ImGui_ImplD2D_MappedFile::Open(const char* filename, size_t maxSize) {
+    IM_ASSERT(filename != nullptr);
+    Close();
+    const int length = ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, NULL, 0);
+    if (length <= 0) {
+        return false;
+    }
+    // files are opened on texture loading threads, ImGui allocator is not synchronized
+    std::vector<wchar_t> path((size_t)length);
+    ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, path.data(), length);
+
+    HANDLE file = ::CreateFileW(path.data(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (::GetFileSizeEx(file, &size) && size.QuadPart > 0 && (ULONGLONG)size.QuadPart <= (ULONGLONG)maxSize) {
+        mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    if (mapping != NULL) {
+        Data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        Size = Data != nullptr ? (size_t)size.QuadPart : 0;
+    }
+    // view keeps mapping alive, handles are not needed anymore
+    if (mapping != NULL) {
+        ::CloseHandle(mapping);
+    }
+    ::CloseHandle(file);
+    return Data != nullptr;
+}
+
+void ImGui_ImplD2D_MappedFile::Close() {
+    if (Data != nullptr) {
+        ::UnmapViewOfFile(Data);
+    }
+    Data = nullptr;
+    Size = 0;
+}
+
+#else
+
+bool ImGui_ImplD2D_MappedFile::Open(const char* filename, size_t maxSize) {
+    IM_ASSERT(filename != nullptr);
+    Close();
+    const int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0 && (unsigned long long)info.st_size <= (unsigned long long)maxSize) {
+        void* view = ::mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED) {
+            Data = view;
+            Size = (size_t)info.st_size;
+        }
+    }
+    // mapping stays valid after descriptor is closed
+    ::close(fd);
+    return Data != nullptr;
+}
+
+void ImGui_ImplD2D_MappedFile::Close() {
+    if (Data != nullptr) {
+        ::munmap((void*)Data, Size);
+    }
+    Data = nullptr;
+    Size = 0;
+}
+
+#endif
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,86 @@
+// dear imgui: Renderer Backend for Direct2D - geometries cached by shape
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+
+static inline ImGuiID ImGui_ImplD2D_FoldKey(ImU64 key) {
+    return (ImGuiID)(key ^ (key >> 32));
+}
+
+void* ImGui_ImplD2D_GeometryCache::Acquire(const ImVec2* points, int triangleCount, ImGui_ImplD2D_Device* device, ImVec2* origin, bool* cached, ImGui_ImplD2D_FrameStats* stats) {
+    IM_ASSERT(points != nullptr && triangleCount > 0 && device != nullptr && origin != nullptr && cached != nullptr && stats != nullptr);
+    IM_UNUSED(stats);
+    *origin = points[0];
+    *cached = false;
+    const int pointCount = triangleCount * 3;
+    Relative.resize(pointCount);
+    for (int n = 0; n < pointCount; n++) {
+        Relative[n] = ImVec2(points[n].x - origin->x, points[n].y - origin->y);
+    }
+    const ImU64 key = ImGui_ImplD2D_Hash(Relative.Data, (size_t)Relative.size_in_bytes(), (ImU64)triangleCount);
+    const ImGuiID folded = ImGui_ImplD2D_FoldKey(key);
+    const int index = Lookup.GetInt(folded) - 1;
+    if (index >= 0 && Entries[index].Key == key) {
+        Entries[index].LastFrame = Frame;
+        IMGUI_IMPL_D2D_STAT_ADD(*stats, GeometriesReused, 1);
+        *cached = true;
+        return Entries[index].Geometry;
+    }
+    void* geometry = device->CreateGeometry(Relative.Data, triangleCount);
+    if (geometry == nullptr) {
+        return nullptr;
+    }
+    IMGUI_IMPL_D2D_STAT_ADD(*stats, GeometriesCreated, 1);
+    // other shape with the same folded key keeps its place, this one is drawn through temporary geometry
+    if (index < 0 && Entries.Size < MaxEntries) {
+        ImGui_ImplD2D_CachedGeometry entry;
+        entry.Key = key;
+        entry.Geometry = geometry;
+        entry.LastFrame = Frame;
+        Entries.push_back(entry);
+        Lookup.SetInt(folded, Entries.Size);
+        *cached = true;
+    }
+    return geometry;
+}
+
+void ImGui_ImplD2D_GeometryCache::RebuildLookup() {
+    Lookup.Data.resize(0);
+    Lookup.Data.reserve(Entries.Size);
+    for (int n = 0; n < Entries.Size; n++) {
+        Lookup.Data.push_back(ImGuiStorage::ImGuiStoragePair(ImGui_ImplD2D_FoldKey(Entries[n].Key), n + 1));
+    }
+    Lookup.BuildSortByKey();
+}
+
+void ImGui_ImplD2D_GeometryCache::EndFrame(ImGui_ImplD2D_Device* device) {
+    IMGUI_IMPL_D2D_ZONE("GeometryCacheEndFrame");
+    // full cache makes room for shapes of next frame
+    const bool full = Entries.Size >= MaxEntries;
+    int kept = 0;
+    for (int n = 0; n < Entries.Size; n++) {
+        const ImGui_ImplD2D_CachedGeometry& entry = Entries[n];
+        if (Frame - entry.LastFrame > RetainFrames || (full && entry.LastFrame != Frame)) {
+            device->ReleaseGeometry(entry.Geometry);
+            continue;
+        }
+        Entries[kept++] = entry;
+    }
+    if (kept != Entries.Size) {
+        Entries.resize(kept);
+        RebuildLookup();
+    }
+}
+
+void ImGui_ImplD2D_GeometryCache::Clear(ImGui_ImplD2D_Device* device) {
+    for (int n = 0; n < Entries.Size; n++) {
+        device->ReleaseGeometry(Entries[n].Geometry);
+    }
+    Entries.clear();
+    Lookup.Clear();
+    Relative.clear();
+}
+
+#endif // #ifndef IMGUI_DISABLE
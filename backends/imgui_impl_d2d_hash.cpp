@@ -0,0 +1,208 @@
+// dear imgui: Renderer Backend for Direct2D - draw list hashing
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+#if defined(IMGUI_IMPL_D2D_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(IMGUI_IMPL_D2D_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(IMGUI_IMPL_D2D_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+// Stripes of 32 bytes are accumulated into four 64-bit lanes (multiply of keyed 32-bit halves plus input), key
+// depends on stripe position within block of 8 stripes, lanes are scrambled after each block, so reordered data
+// hashes differently. All paths compute the same lanes, vectorized ones just do several lanes at once.
+enum { ImGui_ImplD2D_HashStripe = 32, ImGui_ImplD2D_HashBlock = 8 };
+
+/** @brief Stripe keys, stripe n of block uses Keys[n .. n + 3], scramble uses Keys[8 .. 11] */
+static const ImU64 ImGui_ImplD2D_HashKeys[ImGui_ImplD2D_HashBlock + 4] = {
+    0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull, 0x1f67b3b7a4a44072ull,
+    0x78e5c0cc4ee679cbull, 0x2172ffcc7dd05a82ull, 0x8e2443f7744608b8ull, 0x4c263a81e69035e0ull,
+    0xcb00c391bb52283cull, 0xa32e531b8b65d088ull, 0x4ef90da297486471ull, 0xd8acdea946ef1938ull,
+};
+static const ImU64 ImGui_ImplD2D_HashPrime32 = 0x9E3779B1ull;
+static const ImU64 ImGui_ImplD2D_HashPrime64 = 0x9E3779B185EBCA87ull;
+
+static inline ImU64 ImGui_ImplD2D_HashMix(ImU64 h) {
+    h ^= h >> 33;
+    h *= 0xC2B2AE3D27D4EB4Full;
+    h ^= h >> 29;
+    h *= 0x165667B19E3779F9ull;
+    h ^= h >> 32;
+    return h;
+}
+
+static inline ImU64 ImGui_ImplD2D_HashRead64(const unsigned char* p) {
+    ImU64 value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static void ImGui_ImplD2D_HashStripeScalar(ImU64 acc[4], const unsigned char* p, const ImU64* keys) {
+    for (int lane = 0; lane < 4; lane++) {
+        const ImU64 data = ImGui_ImplD2D_HashRead64(p + lane * 8);
+        const ImU64 keyed = data ^ keys[lane];
+        acc[lane] += (keyed & 0xFFFFFFFFull) * (keyed >> 32) + data;
+    }
+}
+
+static void ImGui_ImplD2D_HashScrambleScalar(ImU64 acc[4]) {
+    const ImU64* keys = ImGui_ImplD2D_HashKeys + ImGui_ImplD2D_HashBlock;
+    for (int lane = 0; lane < 4; lane++) {
+        acc[lane] = ((acc[lane] ^ (acc[lane] >> 47)) ^ keys[lane]) * ImGui_ImplD2D_HashPrime32;
+    }
+}
+
+/** @brief Accumulate stripes of partial block & tail, then fold lanes, shared by all paths */
+static ImU64 ImGui_ImplD2D_HashFinish(ImU64 acc[4], const unsigned char* p, size_t remaining, int stripe, size_t size, ImU64 seed) {
+    for (; remaining >= ImGui_ImplD2D_HashStripe; remaining -= ImGui_ImplD2D_HashStripe, p += ImGui_ImplD2D_HashStripe) {
+        ImGui_ImplD2D_HashStripeScalar(acc, p, ImGui_ImplD2D_HashKeys + stripe);
+        if (++stripe == ImGui_ImplD2D_HashBlock) {
+            ImGui_ImplD2D_HashScrambleScalar(acc);
+            stripe = 0;
+        }
+    }
+    if (remaining > 0) {
+        unsigned char last[ImGui_ImplD2D_HashStripe] = {};
+        memcpy(last, p, remaining);
+        ImGui_ImplD2D_HashStripeScalar(acc, last, ImGui_ImplD2D_HashKeys + stripe);
+    }
+    ImU64 h = (ImU64)size * ImGui_ImplD2D_HashPrime64 ^ seed;
+    for (int lane = 0; lane < 4; lane++) {
+        h = ImGui_ImplD2D_HashMix(h ^ acc[lane]) + ImGui_ImplD2D_HashKeys[lane];
+    }
+    return ImGui_ImplD2D_HashMix(h);
+}
+
+static void ImGui_ImplD2D_HashInit(ImU64 acc[4], ImU64 seed) {
+    acc[0] = seed ^ ImGui_ImplD2D_HashPrime64;
+    acc[1] = seed + ImGui_ImplD2D_HashPrime32;
+    acc[2] = seed ^ ImGui_ImplD2D_HashKeys[ImGui_ImplD2D_HashBlock];
+    acc[3] = seed - ImGui_ImplD2D_HashPrime64;
+}
+
+ImU64 ImGui_ImplD2D_HashScalar(const void* data, size_t size, ImU64 seed) {
+    ImU64 acc[4];
+    ImGui_ImplD2D_HashInit(acc, seed);
+    return ImGui_ImplD2D_HashFinish(acc, (const unsigned char*)data, size, 0, size, seed);
+}
+
+ImU64 ImGui_ImplD2D_Hash(const void* data, size_t size, ImU64 seed) {
+    ImU64 acc[4];
+    ImGui_ImplD2D_HashInit(acc, seed);
+    const unsigned char* p = (const unsigned char*)data;
+    const size_t blockSize = ImGui_ImplD2D_HashStripe * ImGui_ImplD2D_HashBlock;
+    size_t remaining = size;
+#if defined(IMGUI_IMPL_D2D_SIMD_AVX2)
+    __m256i acc4 = _mm256_loadu_si256((const __m256i*)acc);
+    const __m256i scrambleKey = _mm256_loadu_si256((const __m256i*)(ImGui_ImplD2D_HashKeys + ImGui_ImplD2D_HashBlock));
+    const __m256i prime = _mm256_set1_epi64x((long long)ImGui_ImplD2D_HashPrime32);
+    for (; remaining >= blockSize; remaining -= blockSize) {
+        for (int stripe = 0; stripe < ImGui_ImplD2D_HashBlock; stripe++, p += ImGui_ImplD2D_HashStripe) {
+            const __m256i in = _mm256_loadu_si256((const __m256i*)p);
+            const __m256i keyed = _mm256_xor_si256(in, _mm256_loadu_si256((const __m256i*)(ImGui_ImplD2D_HashKeys + stripe)));
+            const __m256i product = _mm256_mul_epu32(keyed, _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(2, 3, 0, 1)));
+            acc4 = _mm256_add_epi64(acc4, _mm256_add_epi64(product, in));
+        }
+        const __m256i mixed = _mm256_xor_si256(_mm256_xor_si256(acc4, _mm256_srli_epi64(acc4, 47)), scrambleKey);
+        const __m256i lo = _mm256_mul_epu32(mixed, prime);
+        const __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(mixed, 32), prime);
+        acc4 = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+    }
+    _mm256_storeu_si256((__m256i*)acc, acc4);
+#elif defined(IMGUI_IMPL_D2D_SIMD_SSE2)
+    __m128i acc2[2] = { _mm_loadu_si128((const __m128i*)acc), _mm_loadu_si128((const __m128i*)(acc + 2)) };
+    const __m128i prime = _mm_set1_epi32((int)ImGui_ImplD2D_HashPrime32);
+    for (; remaining >= blockSize; remaining -= blockSize) {
+        for (int stripe = 0; stripe < ImGui_ImplD2D_HashBlock; stripe++, p += ImGui_ImplD2D_HashStripe) {
+            for (int half = 0; half < 2; half++) {
+                const __m128i in = _mm_loadu_si128((const __m128i*)(p + half * 16));
+                const __m128i keyed = _mm_xor_si128(in, _mm_loadu_si128((const __m128i*)(ImGui_ImplD2D_HashKeys + stripe + half * 2)));
+                const __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(2, 3, 0, 1)));
+                acc2[half] = _mm_add_epi64(acc2[half], _mm_add_epi64(product, in));
+            }
+        }
+        for (int half = 0; half < 2; half++) {
+            const __m128i scrambleKey = _mm_loadu_si128((const __m128i*)(ImGui_ImplD2D_HashKeys + ImGui_ImplD2D_HashBlock + half * 2));
+            const __m128i mixed = _mm_xor_si128(_mm_xor_si128(acc2[half], _mm_srli_epi64(acc2[half], 47)), scrambleKey);
+            const __m128i lo = _mm_mul_epu32(mixed, prime);
+            const __m128i hi = _mm_mul_epu32(_mm_srli_epi64(mixed, 32), prime);
+            acc2[half] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+        }
+    }
+    _mm_storeu_si128((__m128i*)acc, acc2[0]);
+    _mm_storeu_si128((__m128i*)(acc + 2), acc2[1]);
+#elif defined(IMGUI_IMPL_D2D_SIMD_NEON)
+    uint64x2_t acc2[2] = { vld1q_u64(acc), vld1q_u64(acc + 2) };
+    for (; remaining >= blockSize; remaining -= blockSize) {
+        for (int stripe = 0; stripe < ImGui_ImplD2D_HashBlock; stripe++, p += ImGui_ImplD2D_HashStripe) {
+            for (int half = 0; half < 2; half++) {
+                const uint64x2_t in = vreinterpretq_u64_u8(vld1q_u8(p + half * 16));
+                const uint64x2_t keyed = veorq_u64(in, vld1q_u64(ImGui_ImplD2D_HashKeys + stripe + half * 2));
+                const uint64x2_t product = vmull_u32(vmovn_u64(keyed), vshrn_n_u64(keyed, 32));
+                acc2[half] = vaddq_u64(acc2[half], vaddq_u64(product, in));
+            }
+        }
+        for (int half = 0; half < 2; half++) {
+            const uint64x2_t scrambleKey = vld1q_u64(ImGui_ImplD2D_HashKeys + ImGui_ImplD2D_HashBlock + half * 2);
+            const uint64x2_t mixed = veorq_u64(veorq_u64(acc2[half], vshrq_n_u64(acc2[half], 47)), scrambleKey);
+            const uint64x2_t lo = vmull_n_u32(vmovn_u64(mixed), (uint32_t)ImGui_ImplD2D_HashPrime32);
+            const uint64x2_t hi = vmull_n_u32(vshrn_n_u64(mixed, 32), (uint32_t)ImGui_ImplD2D_HashPrime32);
+            acc2[half] = vaddq_u64(lo, vshlq_n_u64(hi, 32));
+        }
+    }
+    vst1q_u64(acc, acc2[0]);
+    vst1q_u64(acc + 2, acc2[1]);
+#endif
+    IM_UNUSED(blockSize);
+    // whole blocks left to scalar code only without SIMD, so stripe index restarts at block boundary
+    return ImGui_ImplD2D_HashFinish(acc, p, remaining, 0, size, seed);
+}
+
+ImU64 ImGui_ImplD2D_HashDrawList(const ImDrawList* drawList, ImU64 seed) {
+    IM_ASSERT(drawList != nullptr);
+    IMGUI_IMPL_D2D_ZONE("HashDrawList");
+    // ImDrawCmd is zero initialized before fields are set (padding included), so commands can be hashed as bytes
+    ImU64 h = ImGui_ImplD2D_Hash(drawList->VtxBuffer.Data, (size_t)drawList->VtxBuffer.size_in_bytes(), seed);
+    h = ImGui_ImplD2D_Hash(drawList->IdxBuffer.Data, (size_t)drawList->IdxBuffer.size_in_bytes(), h);
+    h = ImGui_ImplD2D_Hash(drawList->CmdBuffer.Data, (size_t)drawList->CmdBuffer.size_in_bytes(), h);
+    return ImGui_ImplD2D_Hash(&drawList->Flags, sizeof(drawList->Flags), h);
+}
+
+bool ImGui_ImplD2D_HashDrawData(const ImDrawData* drawData, ImU64 seed, ImU64* out) {
+    IM_ASSERT(drawData != nullptr && out != nullptr);
+    IMGUI_IMPL_D2D_ZONE("HashDrawData");
+    const float display[6] = { drawData->DisplayPos.x, drawData->DisplayPos.y, drawData->DisplaySize.x, drawData->DisplaySize.y,
+        drawData->FramebufferScale.x, drawData->FramebufferScale.y };
+    ImU64 h = ImGui_ImplD2D_Hash(display, sizeof(display), seed);
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList* drawList = drawData->CmdLists[n];
+        for (int c = 0; c < drawList->CmdBuffer.Size; c++) {
+            const ImDrawCallback callback = drawList->CmdBuffer.Data[c].UserCallback;
+            if (callback != nullptr && callback != ImDrawCallback_ResetRenderState) {
+                return false;
+            }
+        }
+        // lists are chained, so moving draw list to other position changes hash
+        h = ImGui_ImplD2D_HashDrawList(drawList, h);
+    }
+    *out = h;
+    return true;
+}
+
+const char* ImGui_ImplD2D_GetHashPath() {
+#if defined(IMGUI_IMPL_D2D_SIMD_AVX2)
+    return "AVX2";
+#elif defined(IMGUI_IMPL_D2D_SIMD_SSE2)
+    return "SSE2";
+#elif defined(IMGUI_IMPL_D2D_SIMD_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,969 @@
+// dear imgui: Renderer Backend for Direct2D - portable internals
+// This header must not include any Windows header: everything declared here is used by imgui_impl_d2d.cpp
+// but is also built on other platforms (tools, benchmarks) where Direct2D is not available.
+
+// You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// Learn about Dear ImGui:
+// - FAQ                  https://dearimgui.com/faq
+// - Getting Started      https://dearimgui.com/getting-started
+// - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
+// - Introduction, links and more at the top of imgui.cpp
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d.h"
+
+#include <cstdio>      // FILE
+#include <cstdint>     // SIZE_MAX
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Texture atlas packer
+//-----------------------------------------------------------------------------
+
+/** @brief Sub-rectangle allocated inside texture atlas page */
+struct ImGui_ImplD2D_AtlasRect
+{
+    /** @brief Index of the page the image was packed into */
+    int Page;
+    /** @brief Position & size of the image inside the page in pixels (padding excluded) */
+    int X, Y, Width, Height;
+    /** @brief Normalized texture coordinates of the image inside the page */
+    ImVec2 Uv0, Uv1;
+};
+
+/** @brief Horizontal strip of a page, images are placed left to right */
+struct ImGui_ImplD2D_AtlasShelf
+{
+    int Page;
+    int Y;
+    int Height;
+    /** @brief Used width of the shelf in pixels */
+    int Used;
+};
+
+/** @brief Shelf packer for small images
+
+    Images are packed at runtime one by one (no batch sorting), each image is placed on the shelf that wastes the
+    least height. When no shelf fits, a new shelf is opened on the first page with enough room left, and when no
+    page has room left a new page is added. Page contents (bitmaps) are owned by the renderer.
+    Textures are packed on threads loading them, so packer memory does not come from ImGui allocator.
+ */
+struct ImGui_ImplD2D_AtlasPacker
+{
+    /** @brief Page size in pixels, packer is disabled when zero */
+    int PageWidth, PageHeight;
+    /** @brief Images with any side larger than this are not packed */
+    int MaxImageSize;
+    /** @brief Empty pixels kept around each image so bilinear sampling does not bleed into neighbours */
+    int Padding;
+    std::vector<ImGui_ImplD2D_AtlasShelf> Shelves;
+    /** @brief First row not used by any shelf, one entry per page */
+    std::vector<int> PageBottom;
+
+    ImGui_ImplD2D_AtlasPacker() { PageWidth = PageHeight = MaxImageSize = Padding = 0; }
+
+    void    Init(int pageSize, int maxImageSize, int padding = 1);
+    void    Clear();
+    bool    IsEnabled() const { return PageWidth > 0 && PageHeight > 0; }
+    bool    CanPack(int width, int height) const;
+    /** @brief Allocate place for image
+
+        @returns
+            This method returns false when image cannot be packed, on success @p out describes the allocated area.
+            When @p out->Page is equal to number of pages before the call, a new page was added.
+     */
+    bool    Pack(int width, int height, ImGui_ImplD2D_AtlasRect* out);
+    int     GetPageCount() const { return (int)PageBottom.size(); }
+};
+
+/** @brief Convert texture coordinates of packed image to texture coordinates of its page */
+inline ImVec2 ImGui_ImplD2D_AtlasRemapUV(const ImGui_ImplD2D_AtlasRect& rect, const ImVec2& uv)
+{
+    return ImVec2(rect.Uv0.x + uv.x * (rect.Uv1.x - rect.Uv0.x), rect.Uv0.y + uv.y * (rect.Uv1.y - rect.Uv0.y));
+}
+
+//-----------------------------------------------------------------------------
+// Memory mapped file
+//-----------------------------------------------------------------------------
+
+/** @brief Read-only view of whole file
+
+    Uses MapViewOfFile on Windows and mmap elsewhere, so file contents can be handed to decoder
+    without reading it into heap memory first. Mapping is released by @see Close or destructor.
+ */
+struct ImGui_ImplD2D_MappedFile
+{
+    const void* Data;
+    size_t      Size;
+
+    ImGui_ImplD2D_MappedFile() { Data = nullptr; Size = 0; }
+    ~ImGui_ImplD2D_MappedFile() { Close(); }
+    // view is unmapped once, by its only owner
+    ImGui_ImplD2D_MappedFile(const ImGui_ImplD2D_MappedFile&) = delete;
+    ImGui_ImplD2D_MappedFile& operator=(const ImGui_ImplD2D_MappedFile&) = delete;
+
+    /** @brief Map file
+
+        @param filename UTF-8 encoded path
+        @param maxSize Larger files are rejected before mapping
+
+        @returns
+            This method returns false when file cannot be opened, is empty, larger than @p maxSize or cannot be mapped
+     */
+    bool    Open(const char* filename, size_t maxSize = SIZE_MAX);
+    void    Close();
+    bool    IsOpen() const { return Data != nullptr; }
+};
+
+//-----------------------------------------------------------------------------
+// Font table
+//-----------------------------------------------------------------------------
+
+/** @brief Glyph of font atlas, only fields required to recognize text in draw lists */
+struct ImGui_ImplD2D_FontGlyph
+{
+    unsigned int Codepoint;
+    float X0, Y0;
+    float U0, V0, U1, V1;
+};
+
+struct ImGui_ImplD2D_FontInfo
+{
+    float FontSize;
+    float Scale;
+    float Ascent;
+    /** @brief Glyphs of the font in @see ImGui_ImplD2D_FontTable::Glyphs */
+    int GlyphOffset, GlyphCount;
+};
+
+/** @brief Copy of font atlas glyph metadata
+
+    Built from ImFontAtlas every time atlas is uploaded, or read from capture file, so text can be
+    recognized without access to live ImGui context.
+ */
+struct ImGui_ImplD2D_FontTable
+{
+    ImTextureID TexID;
+    /** @brief Incremented by @see Build */
+    int Version;
+    ImVector<ImGui_ImplD2D_FontInfo> Fonts;
+    ImVector<ImGui_ImplD2D_FontGlyph> Glyphs;
+    /** @brief Open addressing hash of glyph corners (top-left & bottom-right uv) to index in @see Glyphs, -1 marks empty slot
+
+        Glyphs sharing corner are stored in order of @see Glyphs, so lookups return the same glyph as linear search would.
+     */
+    ImVector<int> Lookup;
+    /** @brief Longest probe sequence of @see Lookup, bounds cost of single lookup */
+    int     MaxProbes;
+
+    ImGui_ImplD2D_FontTable() { TexID = nullptr; Version = 0; MaxProbes = 0; }
+
+    void    Build(const ImFontAtlas* atlas);
+    /** @brief Rebuild @see Lookup from @see Glyphs, called by @see Build (and by capture reader after reading glyphs) */
+    void    BuildLookup();
+    /** @brief Refresh font metrics that can change without rebuilding the atlas (e.g. ImFont::Scale) */
+    void    UpdateMetrics(const ImFontAtlas* atlas);
+    void    Clear();
+    /** @brief Find first font with glyph having top-left or bottom-right corner at @p uv, returns -1 when not found */
+    int     FindFont(const ImVec2& uv) const;
+    /** @brief Find glyph of @p font having top-left or bottom-right corner at @p uv, returns index in @see Glyphs or -1 */
+    int     FindGlyph(int font, const ImVec2& uv) const;
+};
+
+//-----------------------------------------------------------------------------
+// Color conversion
+//-----------------------------------------------------------------------------
+
+// Instruction set of vectorized kernels is chosen at compile time, define IMGUI_IMPL_D2D_DISABLE_SIMD to use scalar code
+#if !defined(IMGUI_IMPL_D2D_DISABLE_SIMD) && defined(__AVX2__)
+#define IMGUI_IMPL_D2D_SIMD_AVX2
+#endif
+#if !defined(IMGUI_IMPL_D2D_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define IMGUI_IMPL_D2D_SIMD_SSE2
+#elif !defined(IMGUI_IMPL_D2D_DISABLE_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+#define IMGUI_IMPL_D2D_SIMD_NEON
+#endif
+
+/** @brief Color with float channels in [0, 1], same layout as D2D1_COLOR_F */
+struct ImGui_ImplD2D_ColorF
+{
+    float   r, g, b, a;
+};
+
+/** @brief Channel value to float, generated at compile time */
+struct ImGui_ImplD2D_ColorTable
+{
+    float   Values[256];
+
+    constexpr ImGui_ImplD2D_ColorTable() : Values() {
+        for (int n = 0; n < 256; n++) {
+            Values[n] = (float)n / 255.0f;
+        }
+    }
+};
+extern const ImGui_ImplD2D_ColorTable ImGui_ImplD2D_ColorMap;
+
+inline ImGui_ImplD2D_ColorF ImGui_ImplD2D_ConvertColor(ImU32 col) {
+    const float* map = ImGui_ImplD2D_ColorMap.Values;
+    return ImGui_ImplD2D_ColorF{ map[(col >> IM_COL32_R_SHIFT) & 0xFFu], map[(col >> IM_COL32_G_SHIFT) & 0xFFu], map[(col >> IM_COL32_B_SHIFT) & 0xFFu], map[(col >> IM_COL32_A_SHIFT) & 0xFFu] };
+}
+
+//-----------------------------------------------------------------------------
+// Draw list hashing
+//-----------------------------------------------------------------------------
+
+/** @brief Fast non-cryptographic 64-bit hash, 32 byte stripes are processed with SSE2/AVX2/NEON when available
+
+    Only used to detect changes between frames, results equal @see ImGui_ImplD2D_HashScalar (on little endian).
+ */
+ImU64 ImGui_ImplD2D_Hash(const void* data, size_t size, ImU64 seed);
+/** @brief One stripe at a time, reference of @see ImGui_ImplD2D_Hash */
+ImU64 ImGui_ImplD2D_HashScalar(const void* data, size_t size, ImU64 seed);
+/** @brief Hash of vertex, index & command buffers & flags of draw list */
+ImU64 ImGui_ImplD2D_HashDrawList(const ImDrawList* drawList, ImU64 seed);
+/** @brief Fingerprint of whole frame: display rectangle, framebuffer scale & every draw list
+
+    Returns false when draw data has user callbacks, their output is unknown so frame cannot be fingerprinted.
+ */
+bool ImGui_ImplD2D_HashDrawData(const ImDrawData* drawData, ImU64 seed, ImU64* out);
+/** @brief Instruction set used by @see ImGui_ImplD2D_Hash: "AVX2", "SSE2", "NEON" or "scalar" */
+const char* ImGui_ImplD2D_GetHashPath();
+
+//-----------------------------------------------------------------------------
+// Dirty rectangles
+//-----------------------------------------------------------------------------
+
+/** @brief Framebuffer area of draw command: bounds of its vertices within its clip rectangle, in pixels
+
+    Commands drawn with font atlas of @p fonts may draw text, whose DirectWrite outlines reach past atlas quads, so
+    their vertex bounds are grown by @p glyphMargin (see @see ImGui_ImplD2D_GetGlyphMargin). Without font table text
+    cannot be told apart & user callbacks may draw anywhere, both cover whole clip rectangle. Returns false when area
+    is empty.
+ */
+bool ImGui_ImplD2D_GetDrawCmdRect(const ImDrawData* drawData, const ImDrawList* drawList, const ImDrawCmd* cmd, const ImGui_ImplD2D_FontTable* fonts, float glyphMargin, ImVec4* out);
+/** @brief Farthest DirectWrite glyph outlines of @p fonts may reach past their atlas quads: largest scaled font size */
+float ImGui_ImplD2D_GetGlyphMargin(const ImGui_ImplD2D_FontTable* fonts, float fontGlobalScale);
+
+/** @brief Draw command of frame seen by @see ImGui_ImplD2D_DirtyTracker */
+struct ImGui_ImplD2D_DirtyItem
+{
+    /** @brief Hash of position in draw order, area, texture, vertices & indices relative to first vertex */
+    ImU64   Hash;
+    /** @brief @see ImGui_ImplD2D_GetDrawCmdRect */
+    ImVec4  Rect;
+};
+
+/** @brief Framebuffer areas that changed since previous frame, for partial presents
+
+    Draw commands of both frames are sorted by hash & matched, area of each command present in only one of the
+    frames is dirty (where it was & where it is, see @see ImGui_ImplD2D_GetDrawCmdRect). Areas are grown by a pixel for
+    antialiased edges, rounded to whole pixels, touching ones are merged, then pairs adding least area are merged until
+    count fits. Whole framebuffer is dirty on first frame & when framebuffer size changes. User callbacks are dirty
+    every frame.
+ */
+struct ImGui_ImplD2D_DirtyTracker
+{
+    ImVector<ImGui_ImplD2D_DirtyItem> Items;
+    ImVector<ImGui_ImplD2D_DirtyItem> PreviousItems;
+    /** @brief Dirty rectangles (x1, y1, x2, y2) of last @see Compute, they do not overlap */
+    ImVector<ImVec4> Rects;
+    ImVec2  FramebufferSize;
+    int     Frame;
+    bool    HasPrevious;
+
+    ImGui_ImplD2D_DirtyTracker() { Frame = 0; HasPrevious = false; }
+
+    /** @brief Diff frame against previous one, returns count of @see Rects (at most @p maxRects), zero when nothing changed
+
+        Text is recognized by font atlas of @p fonts, null marks whole clip rectangle of every command.
+     */
+    int     Compute(const ImDrawData* drawData, const ImGui_ImplD2D_FontTable* fonts, float fontGlobalScale, int maxRects);
+    /** @brief Forget previous frame, next @see Compute marks whole framebuffer dirty */
+    void    Invalidate() { HasPrevious = false; }
+    void    Clear();
+
+private:
+    void    AddItems(const ImDrawData* drawData, const ImGui_ImplD2D_FontTable* fonts, float fontGlobalScale);
+    void    MergeRects(int maxRects);
+    /** @brief Scratch indices relative to first vertex of command */
+    ImVector<ImU32> Indices;
+};
+
+//-----------------------------------------------------------------------------
+// Translation of draw lists to commands
+//-----------------------------------------------------------------------------
+
+enum ImGui_ImplD2D_CommandType_
+{
+    ImGui_ImplD2D_CommandType_PushClip,
+    ImGui_ImplD2D_CommandType_PopClip,
+    /** @brief Triangles filled with single color */
+    ImGui_ImplD2D_CommandType_Solid,
+    /** @brief Triangle or quad with two colors */
+    ImGui_ImplD2D_CommandType_LinearGradient,
+    /** @brief Triangle or quad with three colors, drawn as radial gradient from each corner */
+    ImGui_ImplD2D_CommandType_RadialGradient,
+    /** @brief Consecutive glyphs of one font & color */
+    ImGui_ImplD2D_CommandType_GlyphRun,
+    /** @brief Axis aligned quad of texture other than font atlas (ImDrawList::AddImage()) with single color */
+    ImGui_ImplD2D_CommandType_Image,
+    /** @brief ImDrawCmd::UserCallback */
+    ImGui_ImplD2D_CommandType_Callback,
+    ImGui_ImplD2D_CommandType_COUNT
+};
+typedef int ImGui_ImplD2D_CommandType;
+
+/** @brief Single resolved primitive */
+struct ImGui_ImplD2D_Command
+{
+    ImGui_ImplD2D_CommandType Type;
+    /** @brief Triangles (three points each) in @see ImGui_ImplD2D_CommandList::Points, glyphs for glyph run */
+    int     Offset, Count;
+    /** @brief Clip rectangle in framebuffer space (x1, y1, x2, y2) */
+    ImVec4  Rect;
+    /** @brief Gradient points & colors: linear uses start & end, radial uses one brush per corner
+
+        Image uses corners (min, max) followed by their texture coordinates (uv0, uv1) & its color.
+     */
+    ImVec2  Pos[4];
+    ImU32   Col[4];
+    /** @brief Texture of image */
+    ImTextureID Texture;
+    /** @brief Glyph run font (index in @see ImGui_ImplD2D_FontTable::Fonts) & size in pixels */
+    int     Font;
+    float   FontSize;
+    /** @brief User callback source */
+    const ImDrawList* CallbackList;
+    const ImDrawCmd*  CallbackCmd;
+};
+
+struct ImGui_ImplD2D_Glyph
+{
+    unsigned int Codepoint;
+    /** @brief Top-left corner of the character cell */
+    ImVec2  Pos;
+};
+
+/** @brief Commands translated from one ImDrawList
+
+    Points & glyphs are copied, so commands do not reference draw list buffers (except for user callbacks).
+ */
+struct ImGui_ImplD2D_CommandList
+{
+    ImVector<ImGui_ImplD2D_Command> Commands;
+    ImVector<ImVec2>                Points;
+    ImVector<ImGui_ImplD2D_Glyph>   Glyphs;
+    /** @brief Draw list (@see ImGui_ImplD2D_GetDrawListKey) & hash of its contents & translation parameters commands were
+        translated from, set by @see ImGui_ImplD2D_FrameCommands when unchanged lists are reused */
+    ImGuiID Key;
+    ImU64   Hash;
+    /** @brief Commands (and their cached layer) can be kept while hash matches, false when lists were not hashed or
+        commands reference draw list (user callbacks) */
+    bool    Reusable;
+    /** @brief Union of clip rectangles of translated draw commands, including ones translated without clip (see
+        @see ImGui_ImplD2D_TranslateFeatures_Cull), empty (zero) without commands */
+    ImVec4  ClipBounds;
+
+    ImGui_ImplD2D_CommandList() { Key = 0; Hash = 0; Reusable = false; ClipBounds = ImVec4(0, 0, 0, 0); }
+
+    /** @brief Remove all commands, memory is kept for next frame */
+    void    Reset() { Commands.resize(0); Points.resize(0); Glyphs.resize(0); ClipBounds = ImVec4(0, 0, 0, 0); }
+};
+
+/** @brief Features of translation, each combination is its own instantiation of translation loop */
+enum ImGui_ImplD2D_TranslateFeatures_
+{
+    ImGui_ImplD2D_TranslateFeatures_None        = 0,
+    /** @brief Recognize glyphs & emit glyph runs (also requires @see ImGui_ImplD2D_TranslateParams::Fonts) */
+    ImGui_ImplD2D_TranslateFeatures_Text        = 1 << 0,
+    /** @brief Emit gradients for triangles & quads with more than one color, otherwise color of first vertex is used */
+    ImGui_ImplD2D_TranslateFeatures_Gradients   = 1 << 1,
+    /** @brief Update ClassifySteps & translation times (nothing is counted when IMGUI_IMPL_D2D_DISABLE_STATS is defined) */
+    ImGui_ImplD2D_TranslateFeatures_Stats       = 1 << 2,
+    /** @brief Drop polygons & glyph runs outside of clip rectangle, skip clip of draw commands drawn entirely inside it */
+    ImGui_ImplD2D_TranslateFeatures_Cull        = 1 << 3,
+    ImGui_ImplD2D_TranslateFeatures_All         = (1 << 4) - 1
+};
+typedef int ImGui_ImplD2D_TranslateFeatures;
+
+struct ImGui_ImplD2D_TranslateParams
+{
+    /** @brief Used to recognize text, text is drawn as triangles when null */
+    const ImGui_ImplD2D_FontTable* Fonts;
+    float   FontGlobalScale;
+    /** @brief Project clip rectangles into framebuffer space */
+    ImVec2  ClipOffset;
+    ImVec2  ClipScale;
+    ImVec2  FramebufferSize;
+    ImGui_ImplD2D_TranslateFeatures Features;
+    /** @brief Framebuffer pixels covered by opaque rectangles drawn later (see @see ImGui_ImplD2D_Occlusion), draw
+        commands with clip rectangle inside of one of them are skipped */
+    const ImVec4* Occluders;
+    int     OccluderCount;
+
+    ImGui_ImplD2D_TranslateParams() { Fonts = nullptr; FontGlobalScale = 1.0f; ClipOffset = ImVec2(0, 0); ClipScale = ImVec2(1, 1); Features = ImGui_ImplD2D_TranslateFeatures_All; Occluders = nullptr; OccluderCount = 0; }
+};
+
+/** @brief Count triangles from @p offset which continue solid polygon of color @p col
+
+    Triangle continues polygon when it shares vertex with previous triangle & all its vertices have color @p col.
+    Blocks of 16 / sizeof(T) triangles are compared at once with SSE2/NEON (see IMGUI_IMPL_D2D_SIMD_*), shared vertex
+    breaks of block become bitmask, so scan jumps straight to the first boundary. @p offset must be a multiple of 3
+    not smaller than 6, as indices of two previous triangles are read. Specialized for 16 & 32 bit indices.
+ */
+template<typename T>
+int ImGui_ImplD2D_ScanSolidRun(const T* idx, int offset, int count, const ImDrawVert* vert, ImU32 col, ImGui_ImplD2D_FrameStats* stats);
+/** @brief Reference of @see ImGui_ImplD2D_ScanSolidRun checking one triangle at a time */
+template<typename T>
+int ImGui_ImplD2D_ScanSolidRunScalar(const T* idx, int offset, int count, const ImDrawVert* vert, ImU32 col, ImGui_ImplD2D_FrameStats* stats);
+
+/** @brief Bounding box (x1, y1, x2, y2) of @p count points, two points at once with SSE2/NEON (see IMGUI_IMPL_D2D_SIMD_*) */
+void ImGui_ImplD2D_GetPointsBounds(const ImVec2* points, int count, ImVec4* out);
+/** @brief One point at a time, reference of @see ImGui_ImplD2D_GetPointsBounds */
+void ImGui_ImplD2D_GetPointsBoundsScalar(const ImVec2* points, int count, ImVec4* out);
+
+/** @brief Classify triangles of draw list into commands, commands are appended to @p out
+
+    Dispatches to translation loop instantiated for ImDrawIdx & @see ImGui_ImplD2D_TranslateParams::Features.
+ */
+void ImGui_ImplD2D_TranslateDrawList(const ImDrawList* drawList, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_CommandList* out, ImGui_ImplD2D_FrameStats* stats);
+/** @brief Same with indices read from @p idxBuffer laid out like ImDrawList::IdxBuffer, for other index width than ImDrawIdx */
+void ImGui_ImplD2D_TranslateDrawList(const ImDrawList* drawList, const ImU16* idxBuffer, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_CommandList* out, ImGui_ImplD2D_FrameStats* stats);
+void ImGui_ImplD2D_TranslateDrawList(const ImDrawList* drawList, const ImU32* idxBuffer, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_CommandList* out, ImGui_ImplD2D_FrameStats* stats);
+
+/** @brief Add counters & times of @p src to @p dst */
+void ImGui_ImplD2D_AddFrameStats(ImGui_ImplD2D_FrameStats* dst, const ImGui_ImplD2D_FrameStats& src);
+
+/** @brief Identity of draw list across frames: hash of window name (ImDrawList::_OwnerName), of @p index when unnamed */
+ImGuiID ImGui_ImplD2D_GetDrawListKey(const ImDrawList* drawList, int index);
+
+//-----------------------------------------------------------------------------
+// Occlusion of draw lists
+//-----------------------------------------------------------------------------
+
+/** @brief Framebuffer areas covered by opaque rectangles of each draw list, e.g. window backgrounds
+
+    Occluder is a quad (two triangles sharing diagonal) forming axis aligned rectangle of one opaque color, sharing no
+    vertex with neighbouring triangles & with no glyph corner UV, so translation makes it a solid polygon of its own,
+    drawn aliased. It replaces pixels with centers inside of it & its clip rectangle, so that area rounded inwards to
+    whole pixels hides everything drawn before. Frames with user callbacks have no occluders, as callbacks may change
+    how later primitives blend.
+ */
+struct ImGui_ImplD2D_Occlusion
+{
+    /** @brief Occluders (x1, y1, x2, y2 in framebuffer pixels) of all draw lists, in draw order */
+    ImVector<ImVec4> Occluders;
+    /** @brief First occluder of each draw list, followed by count of all occluders */
+    ImVector<int>   ListOccluders;
+    /** @brief Hash of occluders of draw lists drawn after each draw list, translation of draw list depends on them */
+    ImVector<ImU64> ListHashes;
+
+    /** @brief Find occluders of every draw list, clip rectangles are projected with @p params same as by translation */
+    void    Compute(const ImDrawData* drawData, const ImGui_ImplD2D_TranslateParams& params);
+    /** @brief Occluders of draw lists drawn after draw list @p index, returns their count */
+    int     GetOccludersInFront(int index, const ImVec4** out) const;
+    void    Clear();
+
+private:
+    void    AddOccluders(const ImDrawList* drawList, const ImGui_ImplD2D_TranslateParams& params);
+};
+
+/** @brief Command lists of every draw list of frame
+
+    Each draw list is translated into its own command list with its own statistics, so draw lists can be translated
+    by parallel jobs. Command lists are kept between frames to reuse their memory. With @see ReuseUnchanged command
+    list of previous frame follows its draw list (by key) and is kept as is when draw list & translation parameters
+    hash the same, so only changed windows are translated again.
+ */
+struct ImGui_ImplD2D_FrameCommands
+{
+    /** @brief Command list of each draw list, only first @see Count are used by current frame */
+    ImVector<ImGui_ImplD2D_CommandList*> Lists;
+    ImVector<ImGui_ImplD2D_FrameStats>   ListStats;
+    int     Count;
+    bool    ReuseUnchanged;
+    /** @brief Hash & key command lists even without @see ReuseUnchanged (for @see ImGui_ImplD2D_LayerCache) */
+    bool    HashLists;
+    /** @brief Skip draw commands hidden by opaque rectangles of later draw lists, see @see Occlusion */
+    bool    OcclusionCulling;
+    ImGui_ImplD2D_Occlusion Occlusion;
+    /** @brief Hash of translation parameters of current frame, seed of draw list hashes */
+    ImU64   ParamsHash;
+    /** @brief Scratch of matching lists to keys, kept to reuse memory */
+    ImVector<ImGui_ImplD2D_CommandList*> PreviousLists;
+    ImGuiStorage PreviousKeys;
+
+    ImGui_ImplD2D_FrameCommands() { Count = 0; ReuseUnchanged = false; HashLists = false; OcclusionCulling = false; ParamsHash = 0; }
+    ~ImGui_ImplD2D_FrameCommands() { Clear(); }
+
+    /** @brief Translate all draw lists, with @p parallelFor jobs when not null, statistics are added to @p stats
+
+        @p listKeys gives key of each draw list for reuse, when null keys are computed from draw lists.
+     */
+    void    Translate(const ImDrawData* drawData, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_ParallelForFunc parallelFor, void* parallelForUserData, ImGui_ImplD2D_FrameStats* stats, const ImGuiID* listKeys = nullptr);
+    /** @brief Release memory of all command lists */
+    void    Clear();
+};
+
+//-----------------------------------------------------------------------------
+// Submission of commands
+//-----------------------------------------------------------------------------
+
+/** @brief Direct2D calls issued by the renderer
+
+    Implemented over ID2D1RenderTarget & ID2D1Factory by imgui_impl_d2d.cpp, stand-in implementations
+    make it possible to run the renderer where Direct2D is not available. Objects are returned as opaque
+    pointers and must be released by the matching Release* method.
+ */
+struct ImGui_ImplD2D_Device
+{
+    virtual ~ImGui_ImplD2D_Device() {}
+    virtual void    PushAxisAlignedClip(const ImVec4& rect) = 0;
+    virtual void    PopAxisAlignedClip() = 0;
+    virtual void    SetAntialiasMode(bool aliased) = 0;
+    virtual void    SetTransform(const ImVec2& offset) = 0;
+    /** @brief Create path geometry with one closed figure per triangle */
+    virtual void*   CreateGeometry(const ImVec2* points, int triangleCount) = 0;
+    virtual void    ReleaseGeometry(void* geometry) = 0;
+    /** @brief Set color of the shared solid color brush */
+    virtual void    SetSolidColor(ImU32 col) = 0;
+    virtual void*   CreateLinearGradientBrush(const ImVec2& start, const ImVec2& end, ImU32 startCol, ImU32 endCol) = 0;
+    /** @brief Create radial gradient brush, radius is distance from @p center to @p edge on each axis */
+    virtual void*   CreateRadialGradientBrush(const ImVec2& center, const ImVec2& edge, ImU32 centerCol, ImU32 edgeCol) = 0;
+    virtual void    ReleaseBrush(void* brush) = 0;
+    /** @brief Fill geometry, shared solid color brush is used when @p brush is null */
+    virtual void    FillGeometry(void* geometry, void* brush) = 0;
+    virtual void*   CreateTextFormat(int font, float fontSize) = 0;
+    virtual void    ReleaseTextFormat(void* format) = 0;
+    /** @brief Draw single character with shared solid color brush */
+    virtual void    DrawGlyph(void* format, unsigned int codepoint, const ImVec2& pos) = 0;
+    /** @brief Draw @p uv0 - @p uv1 part of @p texture stretched over @p rect (x1, y1, x2, y2), modulated by @p col */
+    virtual void    DrawImage(ImTextureID texture, const ImVec4& rect, const ImVec2& uv0, const ImVec2& uv1, ImU32 col) = 0;
+    /** @brief Create offscreen bitmap of @p width x @p height pixels sharing resources with device, null on failure */
+    virtual void*   CreateLayer(int width, int height) = 0;
+    virtual void    ReleaseLayer(void* layer) = 0;
+    /** @brief Redirect following calls into cleared @p layer, @p origin is framebuffer position of its top-left corner */
+    virtual void    BeginLayer(void* layer, const ImVec2& origin) = 0;
+    /** @brief Return to drawing into framebuffer, false when layer contents were lost */
+    virtual bool    EndLayer() = 0;
+    /** @brief Draw layer contents with top-left corner at @p origin */
+    virtual void    DrawLayer(void* layer, const ImVec2& origin) = 0;
+};
+
+struct ImGui_ImplD2D_GeometryCache;
+
+/** @brief Issue device calls for commands, polygons are drawn through @p geometries when given */
+void ImGui_ImplD2D_SubmitCommandList(const ImGui_ImplD2D_CommandList& list, ImGui_ImplD2D_Device* device, ImGui_ImplD2D_FrameStats* stats, ImGui_ImplD2D_GeometryCache* geometries = nullptr);
+
+/** @brief Submit frames of ImGui_ImplD2D_RenderDrawData() to @p device instead of render target, null restores it
+
+    Defined by Direct2D backend (imgui_impl_d2d.cpp) for tests comparing call streams of the same frame rendered
+    different ways. Render thread submits to @p device too, window & geometry caches must stay disabled.
+ */
+void ImGui_ImplD2D_SetSubmitDevice(ImGui_ImplD2D_Device* device);
+
+/** @brief Self-contained commands of whole frame, see ImGui_ImplD2D_BuildCommandBuffer()
+
+    User callback commands are copied into the buffer and callbacks get null parent list, so buffer does not reference
+    draw data it was built from and can be submitted any number of times, to any device.
+ */
+struct ImGui_ImplD2D_CommandBuffer
+{
+    ImGui_ImplD2D_FrameCommands Frame;
+    /** @brief Copy of each ImDrawCmd with user callback, callback commands point here */
+    ImVector<ImDrawCmd> Callbacks;
+    /** @brief Statistics of last @see Build */
+    ImGui_ImplD2D_FrameStats BuildStats;
+
+    ImGui_ImplD2D_CommandBuffer() { memset(&BuildStats, 0, sizeof(BuildStats)); }
+
+    /** @brief Translate draw data replacing previous contents, memory is kept */
+    void    Build(const ImDrawData* drawData, const ImGui_ImplD2D_TranslateParams& params, ImGui_ImplD2D_ParallelForFunc parallelFor, void* parallelForUserData);
+    /** @brief Issue device calls for all command lists, statistics are added to @p stats */
+    void    Submit(ImGui_ImplD2D_Device* device, ImGui_ImplD2D_FrameStats* stats) const;
+    void    Clear() { Frame.Clear(); Callbacks.clear(); }
+};
+
+/** @brief Offscreen bitmap holding pixels of one draw list */
+struct ImGui_ImplD2D_Layer
+{
+    /** @brief Key & hash of command list drawn into layer, see @see ImGui_ImplD2D_CommandList */
+    ImGuiID Key;
+    ImU64   Hash;
+    /** @brief Framebuffer area covered by layer in pixels */
+    int     X, Y, Width, Height;
+    void*   Bitmap;
+    /** @brief Last frame layer was drawn or composited */
+    int     LastFrame;
+};
+
+/** @brief Draw lists rendered into offscreen layers, composited as bitmaps while their contents do not change
+
+    Layer covers union of clip rectangles of its command list (clamped to framebuffer). Command list is drawn into its
+    layer again only when its hash or area changes. Layers of all draw lists together use at most @see Budget bytes,
+    least recently used layers not needed by current frame are released to make room, draw list that still does not
+    fit (or that was not hashed, or has user callbacks) is drawn directly. Layers not drawn by frame are released by
+    @see EndFrame. Layers belong to device, owner releases them with @see Clear before device goes away.
+ */
+struct ImGui_ImplD2D_LayerCache
+{
+    ImVector<ImGui_ImplD2D_Layer> Layers;
+    /** @brief Bytes of all layers (4 per pixel), cache is disabled when zero */
+    ImU64   Budget;
+    ImU64   UsedBytes;
+    int     Frame;
+
+    ImGui_ImplD2D_LayerCache() { Budget = 0; UsedBytes = 0; Frame = 0; }
+
+    bool    IsEnabled() const { return Budget > 0; }
+    void    BeginFrame() { Frame++; }
+    /** @brief Draw command list through its layer, redrawing layer when contents changed, or directly when it cannot be cached */
+    void    Submit(const ImGui_ImplD2D_CommandList& list, const ImVec2& framebufferSize, ImGui_ImplD2D_Device* device, ImGui_ImplD2D_FrameStats* stats, ImGui_ImplD2D_GeometryCache* geometries = nullptr);
+    /** @brief Release layers of draw lists that were not drawn by current frame */
+    void    EndFrame(ImGui_ImplD2D_Device* device);
+    /** @brief Release all layers */
+    void    Clear(ImGui_ImplD2D_Device* device);
+
+private:
+    void    Release(int index, ImGui_ImplD2D_Device* device);
+    /** @brief Release least recently used layers not drawn by current frame until @p bytes fit budget */
+    bool    MakeRoom(ImU64 bytes, ImGui_ImplD2D_Device* device);
+};
+
+/** @brief Device geometry of triangles moved so their first point is at origin */
+struct ImGui_ImplD2D_CachedGeometry
+{
+    /** @brief Hash of triangle count & points relative to first point */
+    ImU64   Key;
+    void*   Geometry;
+    /** @brief Last frame geometry was drawn */
+    int     LastFrame;
+};
+
+/** @brief Geometries of polygons keyed by their shape regardless of position, kept across frames
+
+    Key is computed from points relative to first point of polygon, geometry is created from those relative points &
+    drawn with transform moving it back to first point. Shapes of scrolled content (or moved windows) keep their key,
+    so their geometry is reused instead of created again. When cache is full, new shapes are drawn through temporary
+    geometry. @see EndFrame releases geometries not drawn for @see RetainFrames frames, and when cache is full also
+    those not drawn by current frame. Geometries belong to device, owner releases them with @see Clear before device
+    goes away.
+ */
+struct ImGui_ImplD2D_GeometryCache
+{
+    ImVector<ImGui_ImplD2D_CachedGeometry> Entries;
+    /** @brief Folded key to index in @see Entries plus one */
+    ImGuiStorage Lookup;
+    /** @brief Most geometries kept, cache is disabled when zero */
+    int     MaxEntries;
+    int     RetainFrames;
+    int     Frame;
+
+    ImGui_ImplD2D_GeometryCache() { MaxEntries = 0; RetainFrames = 60; Frame = 0; }
+
+    bool    IsEnabled() const { return MaxEntries > 0; }
+    void    BeginFrame() { Frame++; }
+    /** @brief Geometry of @p triangleCount triangles relative to first point, which is stored to @p origin
+
+        @returns
+            This method returns null when device cannot create geometry. Geometry is owned by cache when @p cached
+            is set, otherwise caller releases it.
+     */
+    void*   Acquire(const ImVec2* points, int triangleCount, ImGui_ImplD2D_Device* device, ImVec2* origin, bool* cached, ImGui_ImplD2D_FrameStats* stats);
+    /** @brief Release geometries not drawn recently */
+    void    EndFrame(ImGui_ImplD2D_Device* device);
+    /** @brief Release all geometries */
+    void    Clear(ImGui_ImplD2D_Device* device);
+
+private:
+    void    RebuildLookup();
+    /** @brief Scratch points relative to origin */
+    ImVector<ImVec2> Relative;
+};
+
+/** @brief Device that only counts calls, stands in for Direct2D on platforms without it */
+struct ImGui_ImplD2D_RecordingDevice : ImGui_ImplD2D_Device
+{
+    enum Call
+    {
+        Call_PushAxisAlignedClip,
+        Call_PopAxisAlignedClip,
+        Call_SetAntialiasMode,
+        Call_SetTransform,
+        Call_CreateGeometry,
+        Call_SetSolidColor,
+        Call_CreateLinearGradientBrush,
+        Call_CreateRadialGradientBrush,
+        Call_FillGeometry,
+        Call_CreateTextFormat,
+        Call_DrawGlyph,
+        Call_DrawImage,
+        Call_CreateLayer,
+        Call_BeginLayer,
+        Call_DrawLayer,
+        Call_COUNT
+    };
+    int     Calls[Call_COUNT];
+    /** @brief Objects created but not released yet & clip depth, both should be zero after each frame */
+    int     LiveObjects;
+    int     ClipDepth;
+    /** @brief Layers created but not released yet, they live across frames so @see Reset keeps them */
+    int     LiveLayers;
+    /** @brief Set between BeginLayer() & EndLayer() */
+    bool    InLayer;
+
+    ImGui_ImplD2D_RecordingDevice() { Reset(); LiveLayers = 0; }
+    void    Reset() { memset(Calls, 0, sizeof(Calls)); LiveObjects = 0; ClipDepth = 0; InLayer = false; }
+    int     GetTotalCalls() const;
+    static const char* GetCallName(int call);
+
+    void    PushAxisAlignedClip(const ImVec4&) override { Calls[Call_PushAxisAlignedClip]++; ClipDepth++; }
+    void    PopAxisAlignedClip() override { Calls[Call_PopAxisAlignedClip]++; ClipDepth--; }
+    void    SetAntialiasMode(bool) override { Calls[Call_SetAntialiasMode]++; }
+    void    SetTransform(const ImVec2&) override { Calls[Call_SetTransform]++; }
+    void*   CreateGeometry(const ImVec2*, int) override { Calls[Call_CreateGeometry]++; return Acquire(); }
+    void    ReleaseGeometry(void*) override { LiveObjects--; }
+    void    SetSolidColor(ImU32) override { Calls[Call_SetSolidColor]++; }
+    void*   CreateLinearGradientBrush(const ImVec2&, const ImVec2&, ImU32, ImU32) override { Calls[Call_CreateLinearGradientBrush]++; return Acquire(); }
+    void*   CreateRadialGradientBrush(const ImVec2&, const ImVec2&, ImU32, ImU32) override { Calls[Call_CreateRadialGradientBrush]++; return Acquire(); }
+    void    ReleaseBrush(void*) override { LiveObjects--; }
+    void    FillGeometry(void*, void*) override { Calls[Call_FillGeometry]++; }
+    void*   CreateTextFormat(int, float) override { Calls[Call_CreateTextFormat]++; return Acquire(); }
+    void    ReleaseTextFormat(void*) override { LiveObjects--; }
+    void    DrawGlyph(void*, unsigned int, const ImVec2&) override { Calls[Call_DrawGlyph]++; }
+    void    DrawImage(ImTextureID, const ImVec4&, const ImVec2&, const ImVec2&, ImU32) override { Calls[Call_DrawImage]++; }
+    void*   CreateLayer(int, int) override { Calls[Call_CreateLayer]++; LiveLayers++; return (void*)this; }
+    void    ReleaseLayer(void*) override { LiveLayers--; }
+    void    BeginLayer(void*, const ImVec2&) override { IM_ASSERT(!InLayer); Calls[Call_BeginLayer]++; InLayer = true; }
+    bool    EndLayer() override { IM_ASSERT(InLayer); InLayer = false; return true; }
+    void    DrawLayer(void*, const ImVec2&) override { IM_ASSERT(!InLayer); Calls[Call_DrawLayer]++; }
+
+private:
+    void*   Acquire() { LiveObjects++; return (void*)this; }
+};
+
+//-----------------------------------------------------------------------------
+// Draw data capture
+//-----------------------------------------------------------------------------
+
+/** @brief Appends frames to capture file
+
+    File is a sequence of frame records, each holding draw lists (commands, vertices, indices) & render target
+    size. Font table is stored with the first frame & again after each atlas rebuild. Texture ids are stored
+    as numbers, they are only compared against font atlas texture id on replay. User callbacks cannot be stored,
+    they are replaced by empty commands.
+ */
+struct ImGui_ImplD2D_CaptureWriter
+{
+    FILE*   File;
+    /** @brief Version of the last stored font table, -1 when none stored yet */
+    int     FontTableVersion;
+    int     FrameCount;
+
+    ImGui_ImplD2D_CaptureWriter() { File = nullptr; FontTableVersion = -1; FrameCount = 0; }
+    ~ImGui_ImplD2D_CaptureWriter() { Close(); }
+
+    bool    Open(const char* filename);
+    void    Close();
+    bool    WriteFrame(const ImDrawData* drawData, const ImGui_ImplD2D_FontTable& fonts, float fontGlobalScale, const ImVec2& framebufferSize);
+};
+
+/** @brief Reads frames written by @see ImGui_ImplD2D_CaptureWriter */
+struct ImGui_ImplD2D_CaptureReader
+{
+    FILE*   File;
+    ImGui_ImplD2D_FontTable Fonts;
+    float   FontGlobalScale;
+    ImVec2  FramebufferSize;
+    /** @brief Frame read by the last @see ReadFrame call, draw lists are owned by reader */
+    ImDrawData DrawData;
+    int     FrameCount;
+
+    ImGui_ImplD2D_CaptureReader() { File = nullptr; FontGlobalScale = 1.0f; FrameCount = 0; FileSize = 0; }
+    ~ImGui_ImplD2D_CaptureReader() { Close(); }
+
+    bool    Open(const char* filename);
+    void    Close();
+    /** @brief Read next frame, returns false at end of file or when file is corrupted */
+    bool    ReadFrame();
+    /** @brief Go back to the first frame */
+    bool    Rewind();
+
+private:
+    void    ClearDrawData();
+    /** @brief Count read from file is valid when that many elements fit into ImVector & into rest of the file */
+    bool    CanRead(ImU32 count, size_t memorySize, size_t fileSize) const;
+
+    ImU64   FileSize;
+};
+
+//-----------------------------------------------------------------------------
+// Render thread
+//-----------------------------------------------------------------------------
+
+/** @brief Frame handed to render thread: deep copy of draw data, font table & translation parameters
+
+    Draw lists & font table are owned by snapshot, their memory is reused by following frames, so copying frame
+    does not allocate once buffers grew to their final size.
+ */
+struct ImGui_ImplD2D_DrawDataSnapshot
+{
+    /** @brief Copy of draw data, CmdLists point to @see Lists */
+    ImDrawData DrawData;
+    /** @brief Owned draw lists, only first DrawData.CmdListsCount are used by current frame */
+    ImVector<ImDrawList*> Lists;
+    /** @brief Key of each draw list (see ImGui_ImplD2D_GetDrawListKey()), owner names are not copied */
+    ImVector<ImGuiID> ListKeys;
+    /** @brief Copy of backend font table, glyphs are copied only when table version changes */
+    ImGui_ImplD2D_FontTable Fonts;
+    /** @brief Translation parameters, Fonts points to @see Fonts */
+    ImGui_ImplD2D_TranslateParams Params;
+    /** @brief Copy of rectangles of ImGui_ImplD2D_ComputeDirtyRects(), drawing is clipped to them when set */
+    ImVector<ImVec4> DirtyRects;
+    bool    ClipToDirtyRects;
+    /** @brief Statistics of rendering this snapshot, filled by render thread */
+    ImGui_ImplD2D_FrameStats Stats;
+    /** @brief Set by render thread when @see Stats are complete, cleared by producer once they were read */
+    bool    Rendered;
+
+    ImGui_ImplD2D_DrawDataSnapshot() { memset(&Stats, 0, sizeof(Stats)); ClipToDirtyRects = false; Rendered = false; }
+    ~ImGui_ImplD2D_DrawDataSnapshot() { Clear(); }
+
+    void    Copy(const ImDrawData* drawData, const ImGui_ImplD2D_FontTable& fonts, const ImGui_ImplD2D_TranslateParams& params);
+    /** @brief Release memory of draw lists & font table */
+    void    Clear();
+};
+
+/** @brief Thread rendering snapshots published by single producer (thread calling ImGui_ImplD2D_RenderDrawData())
+
+    Handoff is lock-free: snapshot is passed through atomic single slot mailbox & returned by clearing its busy flag,
+    mutex & condition variable are only used to sleep when the other side is not ready. At most one frame waits in
+    mailbox. With one snapshot producer waits for previous frame to be rendered before copying next one, with two
+    snapshots copy of next frame overlaps rendering of previous one.
+ */
+struct ImGui_ImplD2D_RenderThread
+{
+    typedef void (*RenderFunc)(ImGui_ImplD2D_DrawDataSnapshot* snapshot, void* userData);
+    enum { MaxSnapshots = 2 };
+
+    ImGui_ImplD2D_DrawDataSnapshot Snapshots[MaxSnapshots];
+    int     SnapshotCount;
+
+    ImGui_ImplD2D_RenderThread() : SnapshotCount(1), NextSnapshot(0), Pending(nullptr), Stopping(false), Render(nullptr), UserData(nullptr) { Busy[0] = false; Busy[1] = false; }
+    ~ImGui_ImplD2D_RenderThread() { Stop(); }
+
+    /** @brief Start thread calling @p render for each published snapshot, @p doubleBuffer selects two snapshots */
+    void    Start(RenderFunc render, void* userData, bool doubleBuffer);
+    /** @brief Render published frames & join thread */
+    void    Stop();
+    bool    IsRunning() const { return Thread.joinable(); }
+    bool    IsRenderThread() const { return std::this_thread::get_id() == Thread.get_id(); }
+    /** @brief Snapshot to fill with next frame, waits while render thread still uses it (producer only) */
+    ImGui_ImplD2D_DrawDataSnapshot* Acquire();
+    /** @brief Hand snapshot returned by @see Acquire to render thread, waits while previous frame is still in mailbox */
+    void    Publish(ImGui_ImplD2D_DrawDataSnapshot* snapshot);
+    /** @brief Wait until all published frames were rendered, does nothing when called from render thread */
+    void    WaitIdle();
+
+private:
+    void    ThreadMain();
+    template<typename T> void Wait(T condition);
+    void    Wake();
+
+    int     NextSnapshot;
+    /** @brief Snapshot is published & not rendered yet */
+    std::atomic<bool> Busy[MaxSnapshots];
+    /** @brief Mailbox, published snapshot not taken by render thread yet */
+    std::atomic<ImGui_ImplD2D_DrawDataSnapshot*> Pending;
+    std::atomic<bool> Stopping;
+    std::thread Thread;
+    std::mutex WaitMutex;
+    std::condition_variable WaitCondition;
+    RenderFunc Render;
+    void*   UserData;
+};
+
+//-----------------------------------------------------------------------------
+// Statistics
+//-----------------------------------------------------------------------------
+
+/** @brief Monotonic time in nanoseconds */
+inline ImU64 ImGui_ImplD2D_GetTicks()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Update ImGui_ImplD2D_FrameStats, expand to nothing when IMGUI_IMPL_D2D_DISABLE_STATS is defined
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+#define IMGUI_IMPL_D2D_STAT_ADD(_STATS, _FIELD, _VALUE)     ((_STATS)._FIELD += (_VALUE))
+#define IMGUI_IMPL_D2D_STAT_TIMER_BEGIN(_NAME)              const ImU64 _NAME = ImGui_ImplD2D_GetTicks()
+#define IMGUI_IMPL_D2D_STAT_TIMER_END(_STATS, _FIELD, _NAME) ((_STATS)._FIELD += ImGui_ImplD2D_GetTicks() - (_NAME))
+#else
+#define IMGUI_IMPL_D2D_STAT_ADD(_STATS, _FIELD, _VALUE)     ((void)0)
+#define IMGUI_IMPL_D2D_STAT_TIMER_BEGIN(_NAME)              ((void)0)
+#define IMGUI_IMPL_D2D_STAT_TIMER_END(_STATS, _FIELD, _NAME) ((void)0)
+#endif
+
+//-----------------------------------------------------------------------------
+// Frame history
+//-----------------------------------------------------------------------------
+
+/** @brief Fixed size ring buffer of per-frame backend statistics, never allocates */
+struct ImGui_ImplD2D_FrameHistory
+{
+    enum { Capacity = 240 };
+    /** @brief Backend time of frame in milliseconds */
+    float   Times[Capacity];
+    /** @brief Direct2D calls of frame */
+    float   Calls[Capacity];
+    /** @brief Index of slot written by next @see Add */
+    int     Head;
+    int     Count;
+
+    ImGui_ImplD2D_FrameHistory() { memset((void*)this, 0, sizeof(*this)); }
+
+    void    Add(const ImGui_ImplD2D_FrameStats& stats);
+    /** @brief Index of the oldest frame, values starting there are in chronological order (for ImGui::PlotHistogram values_offset) */
+    int     GetOffset() const { return Count < Capacity ? 0 : Head; }
+    /** @brief Frame time percentile in milliseconds, @p percentile in range [0, 1] */
+    float   GetTimePercentile(float percentile) const;
+};
+
+//-----------------------------------------------------------------------------
+// Trace zones
+//-----------------------------------------------------------------------------
+
+// IMGUI_IMPL_D2D_ZONE(name) marks scope of hot region, name must be string literal. Sink is chosen at compile time:
+//  - IMGUI_IMPL_D2D_TRACE_TRACY (or TRACY_ENABLE): Tracy zones, shown next to application zones
+//  - IMGUI_IMPL_D2D_TRACE_CHROME: built-in writer of Chrome trace JSON (chrome://tracing, Perfetto),
+//    enabled by ImGui_ImplD2D_BeginTrace()
+//  - otherwise zones expand to nothing
+#define IMGUI_IMPL_D2D_ZONE_CONCAT_(_A, _B)   _A##_B
+#define IMGUI_IMPL_D2D_ZONE_CONCAT(_A, _B)    IMGUI_IMPL_D2D_ZONE_CONCAT_(_A, _B)
+
+#if defined(IMGUI_IMPL_D2D_TRACE_TRACY) || (defined(TRACY_ENABLE) && !defined(IMGUI_IMPL_D2D_TRACE_CHROME))
+#include <tracy/Tracy.hpp>
+#define IMGUI_IMPL_D2D_ZONE(_NAME)          ZoneScopedN(_NAME)
+#elif defined(IMGUI_IMPL_D2D_TRACE_CHROME)
+/** @brief Scope recorded as Chrome trace complete event, does nothing unless trace is open */
+struct ImGui_ImplD2D_TraceZone
+{
+    const char* Name;
+    ImU64   Start;
+
+    ImGui_ImplD2D_TraceZone(const char* name);
+    ~ImGui_ImplD2D_TraceZone();
+};
+#define IMGUI_IMPL_D2D_ZONE(_NAME)          ImGui_ImplD2D_TraceZone IMGUI_IMPL_D2D_ZONE_CONCAT(traceZone, __LINE__)(_NAME)
+#else
+#define IMGUI_IMPL_D2D_ZONE(_NAME)          ((void)0)
+#endif
+
+#endif // #ifndef IMGUI_DISABLE
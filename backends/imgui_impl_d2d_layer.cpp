@@ -0,0 +1,133 @@
+// dear imgui: Renderer Backend for Direct2D - offscreen layers of draw lists
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+#include <cmath>        // floorf, ceilf
+
+/** @brief Union of clip rectangles of command list in whole pixels, false when empty */
+static bool ImGui_ImplD2D_GetLayerRect(const ImGui_ImplD2D_CommandList& list, const ImVec2& framebufferSize, int* x, int* y, int* width, int* height) {
+    // draw commands translated without clip command count too, translation clamps clip rectangles to its framebuffer
+    ImVec4 bounds = list.ClipBounds;
+    if (bounds.z > framebufferSize.x) { bounds.z = framebufferSize.x; }
+    if (bounds.w > framebufferSize.y) { bounds.w = framebufferSize.y; }
+    const int x1 = (int)floorf(bounds.x);
+    const int y1 = (int)floorf(bounds.y);
+    const int x2 = (int)ceilf(bounds.z);
+    const int y2 = (int)ceilf(bounds.w);
+    if (x2 <= x1 || y2 <= y1) {
+        return false;
+    }
+    *x = x1;
+    *y = y1;
+    *width = x2 - x1;
+    *height = y2 - y1;
+    return true;
+}
+
+void ImGui_ImplD2D_LayerCache::Release(int index, ImGui_ImplD2D_Device* device) {
+    ImGui_ImplD2D_Layer& layer = Layers[index];
+    device->ReleaseLayer(layer.Bitmap);
+    UsedBytes -= (ImU64)layer.Width * layer.Height * 4;
+    Layers.erase(Layers.Data + index);
+}
+
+bool ImGui_ImplD2D_LayerCache::MakeRoom(ImU64 bytes, ImGui_ImplD2D_Device* device) {
+    while (UsedBytes + bytes > Budget) {
+        int oldest = -1;
+        for (int n = 0; n < Layers.Size; n++) {
+            if (Layers[n].LastFrame != Frame && (oldest < 0 || Layers[n].LastFrame < Layers[oldest].LastFrame)) {
+                oldest = n;
+            }
+        }
+        if (oldest < 0) {
+            return false;
+        }
+        Release(oldest, device);
+    }
+    return true;
+}
+
+void ImGui_ImplD2D_LayerCache::Submit(const ImGui_ImplD2D_CommandList& list, const ImVec2& framebufferSize, ImGui_ImplD2D_Device* device, ImGui_ImplD2D_FrameStats* stats, ImGui_ImplD2D_GeometryCache* geometries) {
+    IM_ASSERT(device != nullptr && stats != nullptr);
+    IMGUI_IMPL_D2D_ZONE("SubmitLayer");
+    int x, y, width, height;
+    if (!IsEnabled() || !list.Reusable || !ImGui_ImplD2D_GetLayerRect(list, framebufferSize, &x, &y, &width, &height)) {
+        ImGui_ImplD2D_SubmitCommandList(list, device, stats, geometries);
+        return;
+    }
+    int index = -1;
+    for (int n = 0; n < Layers.Size && index < 0; n++) {
+        if (Layers[n].Key == list.Key && Layers[n].LastFrame != Frame) {
+            index = n;
+        }
+    }
+    const ImVec2 origin((float)x, (float)y);
+    if (index >= 0) {
+        ImGui_ImplD2D_Layer& layer = Layers[index];
+        if (layer.Hash == list.Hash && layer.X == x && layer.Y == y && layer.Width == width && layer.Height == height) {
+            layer.LastFrame = Frame;
+            device->DrawLayer(layer.Bitmap, origin);
+            IMGUI_IMPL_D2D_STAT_ADD(*stats, LayersReused, 1);
+            return;
+        }
+        if (layer.Width != width || layer.Height != height) {
+            Release(index, device);
+            index = -1;
+        }
+    }
+    if (index < 0) {
+        const ImU64 bytes = (ImU64)width * height * 4;
+        void* bitmap = nullptr;
+        if (bytes <= Budget && MakeRoom(bytes, device)) {
+            bitmap = device->CreateLayer(width, height);
+        }
+        if (bitmap == nullptr) {
+            ImGui_ImplD2D_SubmitCommandList(list, device, stats, geometries);
+            return;
+        }
+        ImGui_ImplD2D_Layer layer;
+        layer.Key = list.Key;
+        layer.Width = width;
+        layer.Height = height;
+        layer.Bitmap = bitmap;
+        Layers.push_back(layer);
+        UsedBytes += bytes;
+        index = Layers.Size - 1;
+    }
+    ImGui_ImplD2D_Layer& layer = Layers[index];
+    layer.Hash = list.Hash;
+    layer.X = x;
+    layer.Y = y;
+    layer.LastFrame = Frame;
+    device->BeginLayer(layer.Bitmap, origin);
+    // leaves no transform of cached geometries behind, so layer is closed & drawn at origin
+    ImGui_ImplD2D_SubmitCommandList(list, device, stats, geometries);
+    if (!device->EndLayer()) {
+        // contents were lost (device removed), list is still drawn this frame
+        Release(index, device);
+        ImGui_ImplD2D_SubmitCommandList(list, device, stats, geometries);
+        return;
+    }
+    device->DrawLayer(layer.Bitmap, origin);
+    IMGUI_IMPL_D2D_STAT_ADD(*stats, LayersDrawn, 1);
+}
+
+void ImGui_ImplD2D_LayerCache::EndFrame(ImGui_ImplD2D_Device* device) {
+    for (int n = Layers.Size - 1; n >= 0; n--) {
+        if (Layers[n].LastFrame != Frame) {
+            Release(n, device);
+        }
+    }
+}
+
+void ImGui_ImplD2D_LayerCache::Clear(ImGui_ImplD2D_Device* device) {
+    for (int n = Layers.Size - 1; n >= 0; n--) {
+        Release(n, device);
+    }
+    Layers.clear();
+    UsedBytes = 0;
+}
+
+#endif // #ifndef IMGUI_DISABLE
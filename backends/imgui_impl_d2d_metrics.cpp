@@ -0,0 +1,41 @@
+// dear imgui: Renderer Backend for Direct2D - frame history
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+#include <cstdlib>      // qsort
+
+void ImGui_ImplD2D_FrameHistory::Add(const ImGui_ImplD2D_FrameStats& stats) {
+    Times[Head] = (float)((double)stats.RenderTime / 1000000.0);
+    Calls[Head] = (float)(stats.GeometriesCreated + stats.BrushesCreated + stats.FillGeometryCalls + stats.DrawTextCalls + stats.DrawBitmapCalls + stats.ClipCalls);
+    Head = (Head + 1) % Capacity;
+    if (Count < Capacity) {
+        Count++;
+    }
+}
+
+static int ImGui_ImplD2D_CompareFloat(const void* a, const void* b) {
+    const float lhs = *(const float*)a;
+    const float rhs = *(const float*)b;
+    return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+
+float ImGui_ImplD2D_FrameHistory::GetTimePercentile(float percentile) const {
+    if (Count == 0) {
+        return 0.0f;
+    }
+    // sorted copy lives on stack, history itself keeps chronological order
+    float sorted[Capacity];
+    memcpy(sorted, Times, Count * sizeof(float));
+    qsort(sorted, Count, sizeof(float), ImGui_ImplD2D_CompareFloat);
+    if (percentile < 0.0f) {
+        percentile = 0.0f;
+    }
+    if (percentile > 1.0f) {
+        percentile = 1.0f;
+    }
+    return sorted[(int)(percentile * (Count - 1) + 0.5f)];
+}
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,157 @@
+// dear imgui: Renderer Backend for Direct2D - occlusion of draw lists by opaque rectangles drawn later
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+#include <cmath>        // floorf, ceilf
+
+// largest occluders kept per draw list (window background & title bar), commands are tested against each one in front
+static const int ImGui_ImplD2D_MaxOccludersPerList = 4;
+
+static inline float ImGui_ImplD2D_OccluderArea(const ImVec4& r) {
+    return (r.z - r.x) * (r.w - r.y);
+}
+
+/** @brief Triangle at @p idx shares no index with quad @p quad */
+static inline bool ImGui_ImplD2D_SharesNoIndex(const ImDrawIdx* idx, const ImDrawIdx* quad) {
+    for (int k = 0; k < 3; k++) {
+        if (idx[k] == quad[0] || idx[k] == quad[1] || idx[k] == quad[2] || idx[k] == quad[5]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** @brief Vertex may start or continue glyph run of translation */
+static inline bool ImGui_ImplD2D_MayBeGlyph(const ImDrawVert& vert, const ImDrawCmd* pcmd, const ImGui_ImplD2D_TranslateParams& params) {
+    const bool text = (params.Features & ImGui_ImplD2D_TranslateFeatures_Text) != 0 && params.Fonts != nullptr;
+    return text && pcmd->GetTexID() == params.Fonts->TexID && params.Fonts->FindFont(vert.uv) >= 0;
+}
+
+void ImGui_ImplD2D_Occlusion::AddOccluders(const ImDrawList* drawList, const ImGui_ImplD2D_TranslateParams& params) {
+    const int first = Occluders.Size;
+    const ImVec2 clip_off = params.ClipOffset;
+    const ImVec2 clip_scale = params.ClipScale;
+    for (int cmd_i = 0; cmd_i < drawList->CmdBuffer.Size; cmd_i++) {
+        const ImDrawCmd* pcmd = &drawList->CmdBuffer[cmd_i];
+        if (pcmd->UserCallback != nullptr) {
+            continue;
+        }
+        // quads of other textures than font atlas are drawn as images, their pixels may be transparent
+        if (params.Fonts != nullptr && pcmd->GetTexID() != params.Fonts->TexID) {
+            continue;
+        }
+        // clip rectangle same as translation makes it
+        ImVec4 clip((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y,
+            (pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+        if (clip.x < 0.0f) { clip.x = 0.0f; }
+        if (clip.y < 0.0f) { clip.y = 0.0f; }
+        if (clip.z > params.FramebufferSize.x) { clip.z = params.FramebufferSize.x; }
+        if (clip.w > params.FramebufferSize.y) { clip.w = params.FramebufferSize.y; }
+        if (clip.z <= clip.x || clip.w <= clip.y) {
+            continue;
+        }
+        const ImDrawVert* vert = drawList->VtxBuffer.Data + pcmd->VtxOffset;
+        const ImDrawIdx* idx = drawList->IdxBuffer.Data + pcmd->IdxOffset;
+        const int indCount = (int)pcmd->ElemCount;
+        for (int i = 0; i + 5 < indCount; i += 3) {
+            // triangles (a, b, c) & (a, c, d), as emitted by ImDrawList::PrimRect()
+            const ImDrawIdx* quad = idx + i;
+            if (quad[3] != quad[0] || quad[4] != quad[2] || quad[5] == quad[1]) {
+                continue;
+            }
+            const ImDrawVert& a = vert[quad[0]];
+            const ImDrawVert& b = vert[quad[1]];
+            const ImDrawVert& c = vert[quad[2]];
+            const ImDrawVert& d = vert[quad[5]];
+            if (((a.col >> IM_COL32_A_SHIFT) & 0xFF) != 0xFF || b.col != a.col || c.col != a.col || d.col != a.col) {
+                continue;
+            }
+            // a & c are opposite corners, b & d the other two
+            const bool diagonal = a.pos.x != c.pos.x && a.pos.y != c.pos.y;
+            const bool corners =
+                (b.pos.x == a.pos.x && b.pos.y == c.pos.y && d.pos.x == c.pos.x && d.pos.y == a.pos.y) ||
+                (b.pos.x == c.pos.x && b.pos.y == a.pos.y && d.pos.x == a.pos.x && d.pos.y == c.pos.y);
+            if (!diagonal || !corners) {
+                continue;
+            }
+            // translation must make the quad its own polygon: neighbours share no vertex, no glyph run reaches into it
+            if ((i >= 3 && !ImGui_ImplD2D_SharesNoIndex(idx + i - 3, quad)) || (i + 8 < indCount && !ImGui_ImplD2D_SharesNoIndex(idx + i + 6, quad))) {
+                continue;
+            }
+            if (ImGui_ImplD2D_MayBeGlyph(a, pcmd, params) || ImGui_ImplD2D_MayBeGlyph(b, pcmd, params) ||
+                ImGui_ImplD2D_MayBeGlyph(c, pcmd, params) || ImGui_ImplD2D_MayBeGlyph(d, pcmd, params) ||
+                (i >= 3 && ImGui_ImplD2D_MayBeGlyph(vert[idx[i - 3]], pcmd, params))) {
+                continue;
+            }
+            const float x1 = ((a.pos.x < c.pos.x ? a.pos.x : c.pos.x) - clip_off.x) * clip_scale.x;
+            const float y1 = ((a.pos.y < c.pos.y ? a.pos.y : c.pos.y) - clip_off.y) * clip_scale.y;
+            const float x2 = ((a.pos.x > c.pos.x ? a.pos.x : c.pos.x) - clip_off.x) * clip_scale.x;
+            const float y2 = ((a.pos.y > c.pos.y ? a.pos.y : c.pos.y) - clip_off.y) * clip_scale.y;
+            // aliased fill & clip replace pixels with centers inside, pixels entirely inside of both certainly are
+            const ImVec4 occluder(ceilf(x1 > clip.x ? x1 : clip.x), ceilf(y1 > clip.y ? y1 : clip.y),
+                floorf(x2 < clip.z ? x2 : clip.z), floorf(y2 < clip.w ? y2 : clip.w));
+            if (occluder.z <= occluder.x || occluder.w <= occluder.y) {
+                continue;
+            }
+            // smallest occluder of list makes room
+            if (Occluders.Size - first == ImGui_ImplD2D_MaxOccludersPerList) {
+                int smallest = first;
+                for (int n = first + 1; n < Occluders.Size; n++) {
+                    smallest = ImGui_ImplD2D_OccluderArea(Occluders[n]) < ImGui_ImplD2D_OccluderArea(Occluders[smallest]) ? n : smallest;
+                }
+                if (ImGui_ImplD2D_OccluderArea(Occluders[smallest]) >= ImGui_ImplD2D_OccluderArea(occluder)) {
+                    continue;
+                }
+                Occluders[smallest] = occluder;
+            }
+            else {
+                Occluders.push_back(occluder);
+            }
+        }
+    }
+}
+
+void ImGui_ImplD2D_Occlusion::Compute(const ImDrawData* drawData, const ImGui_ImplD2D_TranslateParams& params) {
+    IMGUI_IMPL_D2D_ZONE("ComputeOcclusion");
+    Occluders.resize(0);
+    ListOccluders.resize(0);
+    ListHashes.resize(drawData->CmdListsCount);
+    // callbacks may change blending of following primitives, so nothing is known to be opaque
+    bool callbacks = false;
+    for (int n = 0; n < drawData->CmdListsCount && !callbacks; n++) {
+        const ImDrawList* drawList = drawData->CmdLists[n];
+        for (int c = 0; c < drawList->CmdBuffer.Size && !callbacks; c++) {
+            const ImDrawCallback callback = drawList->CmdBuffer[c].UserCallback;
+            callbacks = callback != nullptr && callback != ImDrawCallback_ResetRenderState;
+        }
+    }
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        ListOccluders.push_back(Occluders.Size);
+        if (!callbacks) {
+            AddOccluders(drawData->CmdLists[n], params);
+        }
+    }
+    ListOccluders.push_back(Occluders.Size);
+    // front to back, each list gets hash of occluders of lists in front of it
+    ImU64 hash = 0;
+    for (int n = drawData->CmdListsCount - 1; n >= 0; n--) {
+        ListHashes[n] = hash;
+        hash = ImGui_ImplD2D_Hash(Occluders.Data + ListOccluders[n], (size_t)(ListOccluders[n + 1] - ListOccluders[n]) * sizeof(ImVec4), hash);
+    }
+}
+
+int ImGui_ImplD2D_Occlusion::GetOccludersInFront(int index, const ImVec4** out) const {
+    IM_ASSERT(index >= 0 && index + 1 < ListOccluders.Size);
+    *out = Occluders.Data + ListOccluders[index + 1];
+    return Occluders.Size - ListOccluders[index + 1];
+}
+
+void ImGui_ImplD2D_Occlusion::Clear() {
+    Occluders.clear();
+    ListOccluders.clear();
+    ListHashes.clear();
+}
+
+#endif // #ifndef IMGUI_DISABLE
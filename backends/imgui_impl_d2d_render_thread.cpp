@@ -0,0 +1,158 @@
+// dear imgui: Renderer Backend for Direct2D - draw data snapshots & render thread
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+
+/** @brief Copy vector contents keeping its memory, ImVector assignment frees memory first */
+template<typename T>
+static void ImGui_ImplD2D_CopyVector(ImVector<T>& dst, const ImVector<T>& src) {
+    dst.resize(src.Size);
+    if (src.Size > 0) {
+        memcpy(dst.Data, src.Data, (size_t)src.size_in_bytes());
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Draw data snapshot
+//-----------------------------------------------------------------------------
+
+void ImGui_ImplD2D_DrawDataSnapshot::Copy(const ImDrawData* drawData, const ImGui_ImplD2D_FontTable& fonts, const ImGui_ImplD2D_TranslateParams& params) {
+    IM_ASSERT(drawData != nullptr);
+    IMGUI_IMPL_D2D_ZONE("CopyDrawData");
+    while (Lists.Size < drawData->CmdListsCount) {
+        Lists.push_back(IM_NEW(ImDrawList)(nullptr));
+    }
+    DrawData.CmdLists.resize(0);
+    ListKeys.resize(drawData->CmdListsCount);
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList* src = drawData->CmdLists[n];
+        ImDrawList* dst = Lists[n];
+        ImGui_ImplD2D_CopyVector(dst->CmdBuffer, src->CmdBuffer);
+        ImGui_ImplD2D_CopyVector(dst->IdxBuffer, src->IdxBuffer);
+        ImGui_ImplD2D_CopyVector(dst->VtxBuffer, src->VtxBuffer);
+        dst->Flags = src->Flags;
+        ListKeys[n] = ImGui_ImplD2D_GetDrawListKey(src, n);
+        DrawData.CmdLists.push_back(dst);
+    }
+    DrawData.Valid = drawData->Valid;
+    DrawData.CmdListsCount = drawData->CmdListsCount;
+    DrawData.TotalIdxCount = drawData->TotalIdxCount;
+    DrawData.TotalVtxCount = drawData->TotalVtxCount;
+    DrawData.DisplayPos = drawData->DisplayPos;
+    DrawData.DisplaySize = drawData->DisplaySize;
+    DrawData.FramebufferScale = drawData->FramebufferScale;
+    DrawData.OwnerViewport = nullptr;
+
+    // glyphs only change with atlas, metrics (font scale) can change every frame
+    if (Fonts.Version != fonts.Version || Fonts.TexID != fonts.TexID || Fonts.Glyphs.Size != fonts.Glyphs.Size) {
+        Fonts.TexID = fonts.TexID;
+        Fonts.Version = fonts.Version;
+        Fonts.MaxProbes = fonts.MaxProbes;
+        ImGui_ImplD2D_CopyVector(Fonts.Glyphs, fonts.Glyphs);
+        ImGui_ImplD2D_CopyVector(Fonts.Lookup, fonts.Lookup);
+    }
+    ImGui_ImplD2D_CopyVector(Fonts.Fonts, fonts.Fonts);
+    Params = params;
+    Params.Fonts = params.Fonts != nullptr ? &Fonts : nullptr;
+}
+
+void ImGui_ImplD2D_DrawDataSnapshot::Clear() {
+    for (int n = 0; n < Lists.Size; n++) {
+        IM_DELETE(Lists[n]);
+    }
+    Lists.clear();
+    ListKeys.clear();
+    DirtyRects.clear();
+    DrawData.Clear();
+    Fonts.Clear();
+}
+
+//-----------------------------------------------------------------------------
+// Render thread
+//-----------------------------------------------------------------------------
+
+template<typename T>
+void ImGui_ImplD2D_RenderThread::Wait(T condition) {
+    if (condition()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(WaitMutex);
+    WaitCondition.wait(lock, condition);
+}
+
+void ImGui_ImplD2D_RenderThread::Wake() {
+    // empty critical section orders state change before waiter checks its condition, so wake up is never lost
+    {
+        std::lock_guard<std::mutex> lock(WaitMutex);
+    }
+    WaitCondition.notify_all();
+}
+
+void ImGui_ImplD2D_RenderThread::Start(RenderFunc render, void* userData, bool doubleBuffer) {
+    IM_ASSERT(render != nullptr && !IsRunning());
+    Render = render;
+    UserData = userData;
+    SnapshotCount = doubleBuffer ? 2 : 1;
+    NextSnapshot = 0;
+    Busy[0] = false;
+    Busy[1] = false;
+    Pending = nullptr;
+    Stopping = false;
+    Thread = std::thread(&ImGui_ImplD2D_RenderThread::ThreadMain, this);
+}
+
+void ImGui_ImplD2D_RenderThread::Stop() {
+    if (!IsRunning()) {
+        return;
+    }
+    IM_ASSERT(!IsRenderThread() && "Render thread cannot stop itself");
+    WaitIdle();
+    Stopping = true;
+    Wake();
+    Thread.join();
+}
+
+ImGui_ImplD2D_DrawDataSnapshot* ImGui_ImplD2D_RenderThread::Acquire() {
+    IM_ASSERT(IsRunning() && !IsRenderThread());
+    const int index = NextSnapshot;
+    std::atomic<bool>& busy = Busy[index];
+    Wait([&] { return !busy.load(std::memory_order_acquire); });
+    NextSnapshot = (NextSnapshot + 1) % SnapshotCount;
+    return &Snapshots[index];
+}
+
+void ImGui_ImplD2D_RenderThread::Publish(ImGui_ImplD2D_DrawDataSnapshot* snapshot) {
+    IM_ASSERT(snapshot >= Snapshots && snapshot < Snapshots + SnapshotCount);
+    Busy[snapshot - Snapshots].store(true, std::memory_order_relaxed);
+    Wait([&] { return Pending.load(std::memory_order_acquire) == nullptr; });
+    Pending.store(snapshot, std::memory_order_release);
+    Wake();
+}
+
+void ImGui_ImplD2D_RenderThread::WaitIdle() {
+    if (!IsRunning() || IsRenderThread()) {
+        return;
+    }
+    Wait([&] { return !Busy[0].load(std::memory_order_acquire) && !Busy[1].load(std::memory_order_acquire); });
+}
+
+void ImGui_ImplD2D_RenderThread::ThreadMain() {
+    for (;;) {
+        Wait([&] { return Pending.load(std::memory_order_acquire) != nullptr || Stopping.load(); });
+        ImGui_ImplD2D_DrawDataSnapshot* snapshot = Pending.exchange(nullptr, std::memory_order_acq_rel);
+        if (snapshot == nullptr) {
+            // stop is requested only when nothing is pending
+            return;
+        }
+        // mailbox is free, producer can publish next frame while this one renders
+        Wake();
+        Render(snapshot, UserData);
+        snapshot->Rendered = true;
+        Busy[snapshot - Snapshots].store(false, std::memory_order_release);
+        Wake();
+    }
+}
+
+#endif // #ifndef IMGUI_DISABLE
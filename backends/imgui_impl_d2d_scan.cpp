@@ -0,0 +1,263 @@
+// dear imgui: Renderer Backend for Direct2D - triangle adjacency scanner & point bounds
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+#if defined(IMGUI_IMPL_D2D_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(IMGUI_IMPL_D2D_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>     // _BitScanForward
+#endif
+
+static inline bool ImGui_ImplD2D_IsSolidTriangle(const ImDrawVert* vert, const ImU32 col, const ImU32 i0, const ImU32 i1, const ImU32 i2) {
+    return vert[i0].col == col && vert[i1].col == col && vert[i2].col == col;
+}
+
+template<typename T>
+int ImGui_ImplD2D_ScanSolidRunScalar(const T* idx, int offset, int count, const ImDrawVert* vert, ImU32 col, ImGui_ImplD2D_FrameStats* stats) {
+    IM_ASSERT(offset >= 6 && offset % 3 == 0);
+    IM_UNUSED(stats);
+    int run = 0;
+    for (int i = offset; i + 2 < count; i += 3) {
+        IMGUI_IMPL_D2D_STAT_ADD(*stats, ClassifySteps, 1);
+        const T* prev = idx + i - 3;
+        const T* curr = idx + i;
+        const bool shared =
+            prev[0] == curr[0] || prev[0] == curr[1] || prev[0] == curr[2] ||
+            prev[1] == curr[0] || prev[1] == curr[1] || prev[1] == curr[2] ||
+            prev[2] == curr[0] || prev[2] == curr[1] || prev[2] == curr[2];
+        if (!shared || !ImGui_ImplD2D_IsSolidTriangle(vert, col, curr[0], curr[1], curr[2])) {
+            break;
+        }
+        run++;
+    }
+    return run;
+}
+
+#if defined(IMGUI_IMPL_D2D_SIMD_SSE2) || defined(IMGUI_IMPL_D2D_SIMD_NEON)
+
+/** @brief Lanes compared with index @p d positions back, so that both indices belong to neighbouring triangles
+
+    Index at triangle corner k equals corner j of previous triangle when they are d = 3 + k - j apart, so distance d
+    is only checked on lanes with d - 3 <= k <= d - 1. Block is three 128 bit vectors, which is a whole number of
+    triangles for both index widths.
+ */
+template<typename T>
+struct ImGui_ImplD2D_AdjacencyMasks
+{
+    static constexpr int Lanes = 16 / (int)sizeof(T);
+    T       Masks[5][3 * Lanes];
+
+    constexpr ImGui_ImplD2D_AdjacencyMasks() : Masks() {
+        for (int d = 1; d <= 5; d++) {
+            for (int p = 0; p < 3 * Lanes; p++) {
+                const int k = p % 3;
+                Masks[d - 1][p] = (d - 3 <= k && k <= d - 1) ? (T)~(T)0 : (T)0;
+            }
+        }
+    }
+};
+
+/** @brief Number of leading triangles having at least one of their three index bits set */
+static inline int ImGui_ImplD2D_LeadingSharedTriangles(ImU32 indexBits, int triangles) {
+    // lowest bit of each triangle is set unless all three are clear
+    const ImU32 any = indexBits | (indexBits >> 1) | (indexBits >> 2);
+    const ImU32 breaks = ~any & (0x49249249u & ((1u << (3 * triangles)) - 1u));
+    if (breaks == 0) {
+        return triangles;
+    }
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long bit;
+    _BitScanForward(&bit, breaks);
+    return (int)bit / 3;
+#else
+    return __builtin_ctz(breaks) / 3;
+#endif
+}
+
+// Lanes of index vector at @p idx equal to index of previous triangle, written out so that whole block stays in registers
+#if defined(IMGUI_IMPL_D2D_SIMD_SSE2)
+static inline __m128i ImGui_ImplD2D_SharedLanes(const ImU16* idx, const ImGui_ImplD2D_AdjacencyMasks<ImU16>& adjacency, int lane) {
+    const __m128i curr = _mm_loadu_si128((const __m128i*)idx);
+    // distance 3 (same corner) is valid on every lane
+    __m128i any = _mm_cmpeq_epi16(curr, _mm_loadu_si128((const __m128i*)(idx - 3)));
+    any = _mm_or_si128(any, _mm_and_si128(_mm_cmpeq_epi16(curr, _mm_loadu_si128((const __m128i*)(idx - 1))), _mm_loadu_si128((const __m128i*)(adjacency.Masks[0] + lane))));
+    any = _mm_or_si128(any, _mm_and_si128(_mm_cmpeq_epi16(curr, _mm_loadu_si128((const __m128i*)(idx - 2))), _mm_loadu_si128((const __m128i*)(adjacency.Masks[1] + lane))));
+    any = _mm_or_si128(any, _mm_and_si128(_mm_cmpeq_epi16(curr, _mm_loadu_si128((const __m128i*)(idx - 4))), _mm_loadu_si128((const __m128i*)(adjacency.Masks[3] + lane))));
+    any = _mm_or_si128(any, _mm_and_si128(_mm_cmpeq_epi16(curr, _mm_loadu_si128((const __m128i*)(idx - 5))), _mm_loadu_si128((const __m128i*)(adjacency.Masks[4] + lane))));
+    return any;
+}
+
+static inline __m128i ImGui_ImplD2D_SharedLanes(const ImU32* idx, const ImGui_ImplD2D_AdjacencyMasks<ImU32>& adjacency, int lane) {
+    const __m128i curr = _mm_loadu_si128((const __m128i*)idx);
+    __m128i any = _mm_cmpeq_epi32(curr, _mm_loadu_si128((const __m128i*)(idx - 3)));
+    any = _mm_or_si128(any, _mm_and_si128(_mm_cmpeq_epi32(curr, _mm_loadu_si128((const __m128i*)(idx - 1))), _mm_loadu_si128((const __m128i*)(adjacency.Masks[0] + lane))));
+    any = _mm_or_si128(any, _mm_and_si128(_mm_cmpeq_epi32(curr, _mm_loadu_si128((const __m128i*)(idx - 2))), _mm_loadu_si128((const __m128i*)(adjacency.Masks[1] + lane))));
+    any = _mm_or_si128(any, _mm_and_si128(_mm_cmpeq_epi32(curr, _mm_loadu_si128((const __m128i*)(idx - 4))), _mm_loadu_si128((const __m128i*)(adjacency.Masks[3] + lane))));
+    any = _mm_or_si128(any, _mm_and_si128(_mm_cmpeq_epi32(curr, _mm_loadu_si128((const __m128i*)(idx - 5))), _mm_loadu_si128((const __m128i*)(adjacency.Masks[4] + lane))));
+    return any;
+}
+#else
+static inline uint16x8_t ImGui_ImplD2D_SharedLanes(const ImU16* idx, const ImGui_ImplD2D_AdjacencyMasks<ImU16>& adjacency, int lane) {
+    const uint16x8_t curr = vld1q_u16(idx);
+    uint16x8_t any = vceqq_u16(curr, vld1q_u16(idx - 3));
+    any = vorrq_u16(any, vandq_u16(vceqq_u16(curr, vld1q_u16(idx - 1)), vld1q_u16(adjacency.Masks[0] + lane)));
+    any = vorrq_u16(any, vandq_u16(vceqq_u16(curr, vld1q_u16(idx - 2)), vld1q_u16(adjacency.Masks[1] + lane)));
+    any = vorrq_u16(any, vandq_u16(vceqq_u16(curr, vld1q_u16(idx - 4)), vld1q_u16(adjacency.Masks[3] + lane)));
+    any = vorrq_u16(any, vandq_u16(vceqq_u16(curr, vld1q_u16(idx - 5)), vld1q_u16(adjacency.Masks[4] + lane)));
+    return any;
+}
+
+static inline uint32x4_t ImGui_ImplD2D_SharedLanes(const ImU32* idx, const ImGui_ImplD2D_AdjacencyMasks<ImU32>& adjacency, int lane) {
+    const uint32x4_t curr = vld1q_u32(idx);
+    uint32x4_t any = vceqq_u32(curr, vld1q_u32(idx - 3));
+    any = vorrq_u32(any, vandq_u32(vceqq_u32(curr, vld1q_u32(idx - 1)), vld1q_u32(adjacency.Masks[0] + lane)));
+    any = vorrq_u32(any, vandq_u32(vceqq_u32(curr, vld1q_u32(idx - 2)), vld1q_u32(adjacency.Masks[1] + lane)));
+    any = vorrq_u32(any, vandq_u32(vceqq_u32(curr, vld1q_u32(idx - 4)), vld1q_u32(adjacency.Masks[3] + lane)));
+    any = vorrq_u32(any, vandq_u32(vceqq_u32(curr, vld1q_u32(idx - 5)), vld1q_u32(adjacency.Masks[4] + lane)));
+    return any;
+}
+#endif
+
+/** @brief Number of leading triangles of block starting at @p idx sharing vertex with their previous triangle */
+static inline int ImGui_ImplD2D_SharedVertexRun(const ImU16* idx) {
+    static constexpr ImGui_ImplD2D_AdjacencyMasks<ImU16> adjacency;
+#if defined(IMGUI_IMPL_D2D_SIMD_SSE2)
+    const __m128i lanes0 = ImGui_ImplD2D_SharedLanes(idx, adjacency, 0);
+    const __m128i lanes1 = ImGui_ImplD2D_SharedLanes(idx + 8, adjacency, 8);
+    const __m128i lanes2 = ImGui_ImplD2D_SharedLanes(idx + 16, adjacency, 16);
+    // saturating pack keeps all ones & zeros, one byte per index
+    const ImU32 bits = (ImU32)_mm_movemask_epi8(_mm_packs_epi16(lanes0, lanes1)) |
+        ((ImU32)_mm_movemask_epi8(_mm_packs_epi16(lanes2, _mm_setzero_si128())) << 16);
+#else
+    static const uint16_t weights[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint16x8_t weight = vld1q_u16(weights);
+    const ImU32 bits = (ImU32)vaddvq_u16(vandq_u16(ImGui_ImplD2D_SharedLanes(idx, adjacency, 0), weight)) |
+        ((ImU32)vaddvq_u16(vandq_u16(ImGui_ImplD2D_SharedLanes(idx + 8, adjacency, 8), weight)) << 8) |
+        ((ImU32)vaddvq_u16(vandq_u16(ImGui_ImplD2D_SharedLanes(idx + 16, adjacency, 16), weight)) << 16);
+#endif
+    return ImGui_ImplD2D_LeadingSharedTriangles(bits, 8);
+}
+
+static inline int ImGui_ImplD2D_SharedVertexRun(const ImU32* idx) {
+    static constexpr ImGui_ImplD2D_AdjacencyMasks<ImU32> adjacency;
+#if defined(IMGUI_IMPL_D2D_SIMD_SSE2)
+    const ImU32 bits = (ImU32)_mm_movemask_ps(_mm_castsi128_ps(ImGui_ImplD2D_SharedLanes(idx, adjacency, 0))) |
+        ((ImU32)_mm_movemask_ps(_mm_castsi128_ps(ImGui_ImplD2D_SharedLanes(idx + 4, adjacency, 4))) << 4) |
+        ((ImU32)_mm_movemask_ps(_mm_castsi128_ps(ImGui_ImplD2D_SharedLanes(idx + 8, adjacency, 8))) << 8);
+#else
+    static const uint32_t weights[4] = { 1, 2, 4, 8 };
+    const uint32x4_t weight = vld1q_u32(weights);
+    const ImU32 bits = (ImU32)vaddvq_u32(vandq_u32(ImGui_ImplD2D_SharedLanes(idx, adjacency, 0), weight)) |
+        ((ImU32)vaddvq_u32(vandq_u32(ImGui_ImplD2D_SharedLanes(idx + 4, adjacency, 4), weight)) << 4) |
+        ((ImU32)vaddvq_u32(vandq_u32(ImGui_ImplD2D_SharedLanes(idx + 8, adjacency, 8), weight)) << 8);
+#endif
+    return ImGui_ImplD2D_LeadingSharedTriangles(bits, 4);
+}
+
+template<typename T>
+int ImGui_ImplD2D_ScanSolidRun(const T* idx, int offset, int count, const ImDrawVert* vert, ImU32 col, ImGui_ImplD2D_FrameStats* stats) {
+    IM_ASSERT(offset >= 6 && offset % 3 == 0);
+    constexpr int blockTriangles = ImGui_ImplD2D_AdjacencyMasks<T>::Lanes;
+    int run = 0;
+    int i = offset;
+    for (; i + 3 * blockTriangles <= count; i += 3 * blockTriangles) {
+        IMGUI_IMPL_D2D_STAT_ADD(*stats, ClassifySteps, 1);
+        const int shared = ImGui_ImplD2D_SharedVertexRun(idx + i);
+        // colors are only fetched for triangles before first shared vertex break
+        int t = 0;
+        for (; t < shared; t++) {
+            const T* curr = idx + i + 3 * t;
+            if (!ImGui_ImplD2D_IsSolidTriangle(vert, col, curr[0], curr[1], curr[2])) {
+                break;
+            }
+        }
+        run += t;
+        if (t < blockTriangles) {
+            return run;
+        }
+    }
+    // remaining triangles do not fill a block
+    return run + ImGui_ImplD2D_ScanSolidRunScalar(idx, i, count, vert, col, stats);
+}
+
+#else
+
+template<typename T>
+int ImGui_ImplD2D_ScanSolidRun(const T* idx, int offset, int count, const ImDrawVert* vert, ImU32 col, ImGui_ImplD2D_FrameStats* stats) {
+    return ImGui_ImplD2D_ScanSolidRunScalar(idx, offset, count, vert, col, stats);
+}
+
+#endif
+
+template int ImGui_ImplD2D_ScanSolidRun<ImU16>(const ImU16*, int, int, const ImDrawVert*, ImU32, ImGui_ImplD2D_FrameStats*);
+template int ImGui_ImplD2D_ScanSolidRun<ImU32>(const ImU32*, int, int, const ImDrawVert*, ImU32, ImGui_ImplD2D_FrameStats*);
+template int ImGui_ImplD2D_ScanSolidRunScalar<ImU16>(const ImU16*, int, int, const ImDrawVert*, ImU32, ImGui_ImplD2D_FrameStats*);
+template int ImGui_ImplD2D_ScanSolidRunScalar<ImU32>(const ImU32*, int, int, const ImDrawVert*, ImU32, ImGui_ImplD2D_FrameStats*);
+
+void ImGui_ImplD2D_GetPointsBoundsScalar(const ImVec2* points, int count, ImVec4* out) {
+    IM_ASSERT(count > 0);
+    ImVec4 bounds(points[0].x, points[0].y, points[0].x, points[0].y);
+    for (int n = 1; n < count; n++) {
+        const ImVec2 p = points[n];
+        bounds.x = p.x < bounds.x ? p.x : bounds.x;
+        bounds.y = p.y < bounds.y ? p.y : bounds.y;
+        bounds.z = p.x > bounds.z ? p.x : bounds.z;
+        bounds.w = p.y > bounds.w ? p.y : bounds.w;
+    }
+    *out = bounds;
+}
+
+void ImGui_ImplD2D_GetPointsBounds(const ImVec2* points, int count, ImVec4* out) {
+    IM_ASSERT(count > 0);
+#if defined(IMGUI_IMPL_D2D_SIMD_SSE2) || defined(IMGUI_IMPL_D2D_SIMD_NEON)
+    // lanes hold x, y of two points, four points per step, pairs of lanes are folded at the end
+    const float* p = &points[0].x;
+    int n = 0;
+#if defined(IMGUI_IMPL_D2D_SIMD_SSE2)
+    __m128 lo = _mm_setr_ps(p[0], p[1], p[0], p[1]);
+    __m128 hi = lo;
+    for (; n + 4 <= count; n += 4) {
+        const __m128 a = _mm_loadu_ps(p + n * 2);
+        const __m128 b = _mm_loadu_ps(p + n * 2 + 4);
+        lo = _mm_min_ps(lo, _mm_min_ps(a, b));
+        hi = _mm_max_ps(hi, _mm_max_ps(a, b));
+    }
+    lo = _mm_min_ps(lo, _mm_movehl_ps(lo, lo));
+    hi = _mm_max_ps(hi, _mm_movehl_ps(hi, hi));
+    float lanes[8];
+    _mm_storeu_ps(lanes, lo);
+    _mm_storeu_ps(lanes + 4, hi);
+#else
+    float32x4_t lo = vcombine_f32(vld1_f32(p), vld1_f32(p));
+    float32x4_t hi = lo;
+    for (; n + 4 <= count; n += 4) {
+        const float32x4_t a = vld1q_f32(p + n * 2);
+        const float32x4_t b = vld1q_f32(p + n * 2 + 4);
+        lo = vminq_f32(lo, vminq_f32(a, b));
+        hi = vmaxq_f32(hi, vmaxq_f32(a, b));
+    }
+    float lanes[8];
+    vst1_f32(lanes, vmin_f32(vget_low_f32(lo), vget_high_f32(lo)));
+    vst1_f32(lanes + 4, vmax_f32(vget_low_f32(hi), vget_high_f32(hi)));
+#endif
+    ImVec4 bounds(lanes[0], lanes[1], lanes[4], lanes[5]);
+    // remaining points do not fill a step
+    for (; n < count; n++) {
+        const ImVec2 q = points[n];
+        bounds.x = q.x < bounds.x ? q.x : bounds.x;
+        bounds.y = q.y < bounds.y ? q.y : bounds.y;
+        bounds.z = q.x > bounds.z ? q.x : bounds.z;
+        bounds.w = q.y > bounds.w ? q.y : bounds.w;
+    }
+    *out = bounds;
+#else
+    ImGui_ImplD2D_GetPointsBoundsScalar(points, count, out);
+#endif
+}
+
+#endif // #ifndef IMGUI_DISABLE
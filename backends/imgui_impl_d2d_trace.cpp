@@ -0,0 +1,86 @@
+// dear imgui: Renderer Backend for Direct2D - Chrome trace writer
+// Portable, does not depend on Direct2D (see imgui_impl_d2d_internal.h)
+
+// Zones are streamed to file as complete events ("ph":"X") when they end, so nothing is buffered & trace
+// of crashed application is still readable (chrome://tracing accepts missing closing bracket).
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_d2d_internal.h"
+
+#if defined(IMGUI_IMPL_D2D_TRACE_CHROME) && !defined(IMGUI_IMPL_D2D_TRACE_TRACY)
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+struct ImGui_ImplD2D_TraceWriter
+{
+    std::mutex Mutex;
+    /** @brief Also read without lock to skip zones quickly when trace is not open */
+    std::atomic<FILE*> File{ nullptr };
+    /** @brief Time of ImGui_ImplD2D_BeginTrace(), timestamps are relative to it */
+    ImU64   Start = 0;
+    bool    FirstEvent = true;
+};
+
+static ImGui_ImplD2D_TraceWriter g_ImplD2DTrace;
+
+ImGui_ImplD2D_TraceZone::ImGui_ImplD2D_TraceZone(const char* name) {
+    Name = name;
+    Start = g_ImplD2DTrace.File != nullptr ? ImGui_ImplD2D_GetTicks() : 0;
+}
+
+ImGui_ImplD2D_TraceZone::~ImGui_ImplD2D_TraceZone() {
+    if (Start == 0) {
+        return;
+    }
+    const ImU64 end = ImGui_ImplD2D_GetTicks();
+    const unsigned int thread = (unsigned int)std::hash<std::thread::id>()(std::this_thread::get_id());
+    std::lock_guard<std::mutex> lock(g_ImplD2DTrace.Mutex);
+    FILE* file = g_ImplD2DTrace.File;
+    if (file == nullptr || Start < g_ImplD2DTrace.Start) {
+        return;
+    }
+    fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"imgui_impl_d2d\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u}",
+        g_ImplD2DTrace.FirstEvent ? "\n" : ",\n", Name,
+        (Start - g_ImplD2DTrace.Start) / 1000.0, (end - Start) / 1000.0, thread);
+    g_ImplD2DTrace.FirstEvent = false;
+}
+
+bool ImGui_ImplD2D_BeginTrace(const char* filename) {
+    ImGui_ImplD2D_EndTrace();
+    std::lock_guard<std::mutex> lock(g_ImplD2DTrace.Mutex);
+    FILE* file = fopen(filename, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fputs("[", file);
+    g_ImplD2DTrace.Start = ImGui_ImplD2D_GetTicks();
+    g_ImplD2DTrace.FirstEvent = true;
+    g_ImplD2DTrace.File = file;
+    return true;
+}
+
+void ImGui_ImplD2D_EndTrace() {
+    std::lock_guard<std::mutex> lock(g_ImplD2DTrace.Mutex);
+    FILE* file = g_ImplD2DTrace.File.exchange(nullptr);
+    if (file != nullptr) {
+        fputs("\n]\n", file);
+        fclose(file);
+    }
+}
+
+#else
+
+bool ImGui_ImplD2D_BeginTrace(const char* filename) {
+    IM_UNUSED(filename);
+    return false;
+}
+
+void ImGui_ImplD2D_EndTrace() {
+}
+
+#endif
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,1281 @@
+// Benchmark of draw data translation
+//
+// Canned scenes are built with Dear ImGui every frame, then translated & submitted to device that only counts
+// calls (no Direct2D required). Only backend work is measured, reported per scene:
+//  - ns/vertex:     translation & submission time divided by vertices of draw data
+//  - calls/frame:   Direct2D calls that would be issued
+//  - allocs/frame:  ImGui heap allocations made by the backend (after warm up frames)
+//
+// Modes only measure, correctness of what they measure & budgets of Direct2D calls are checked by unit tests (tests/unit).
+//
+// With --sweep one dimension of synthetic scene (see synthetic_scene.h) is doubled until draw data reaches
+// --max-vertices, results are printed as CSV for plotting backend cost against that dimension.
+//
+// With --scaling N every scene (and synthetic scene with many windows) is translated with 1 to N threads of job
+// system given to ImGui_ImplD2D_SetParallelFor() in real backend, speedup over one thread is printed as CSV.
+//
+// With --render-thread frames are handed to render thread (ImGui_ImplD2D_StartRenderThread() in real backend) with
+// one & two snapshots, render thread draws to counting device. Time UI thread spends per frame is compared with
+// translating & submitting on UI thread. Render thread allocates through CountingAlloc(), which is thread-safe as
+// ImGui_ImplD2D_StartRenderThread() requires, allocation statistics of ImGui context are not reported by this mode.
+//
+// Usage: imgui_impl_d2d_benchmark [--frames N] [--scene name]
+//        imgui_impl_d2d_benchmark --sweep windows|glyphs|rects|rounded|gradients|images|clips [--frames N] [--max-vertices N]
+//        imgui_impl_d2d_benchmark --scaling N [--frames N] [--scene name]
+//        imgui_impl_d2d_benchmark --render-thread [--frames N] [--scene name]
+
+#include "imgui.h"
+#include "imgui_impl_d2d.h"
+#include "imgui_impl_d2d_internal.h"
+#include "synthetic_scene.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+/** @brief ImGui allocations are counted to find allocations made by backend, jobs can allocate on any thread */
+static std::atomic<int> g_AllocationCount(0);
+
+static void* CountingAlloc(size_t size, void* userData) {
+    IM_UNUSED(userData);
+    g_AllocationCount++;
+    return malloc(size);
+}
+
+static void CountingFree(void* ptr, void* userData) {
+    IM_UNUSED(userData);
+    free(ptr);
+}
+
+static void SceneDemoWindow() {
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(800, 1000));
+    ImGui::ShowDemoWindow();
+}
+
+static void SceneTextTable() {
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("Text table");
+    if (ImGui::BeginTable("table", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        for (int row = 0; row < 60; row++) {
+            ImGui::TableNextRow();
+            for (int column = 0; column < 8; column++) {
+                ImGui::TableSetColumnIndex(column);
+                ImGui::Text("Row %d, column %d", row, column);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+static void SceneColorPickers() {
+    static float colors[4][4] = {
+        { 1.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f, 0.5f }, { 0.0f, 0.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 0.0f, 0.5f }
+    };
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("Color pickers");
+    for (int i = 0; i < 4; i++) {
+        ImGui::PushID(i);
+        const ImGuiColorEditFlags flags = ImGuiColorEditFlags_AlphaBar | ImGuiColorEditFlags_AlphaPreviewHalf |
+            (i % 2 ? ImGuiColorEditFlags_PickerHueWheel : ImGuiColorEditFlags_PickerHueBar);
+        ImGui::SetNextItemWidth(400);
+        ImGui::ColorPicker4("##picker", colors[i], flags);
+        if (i % 2 == 0) {
+            ImGui::SameLine();
+        }
+        ImGui::PopID();
+    }
+    ImGui::End();
+}
+
+static void SceneLongList() {
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("Long list");
+    for (int i = 0; i < 10000; i++) {
+        ImGui::PushID(i);
+        ImGui::Selectable("Item", i % 7 == 0);
+        ImGui::SameLine();
+        ImGui::Text("%05d", i);
+        ImGui::PopID();
+    }
+    ImGui::End();
+}
+
+struct BenchmarkScene
+{
+    const char* Name;
+    void (*Build)();
+};
+
+static const BenchmarkScene g_Scenes[] = {
+    { "demo_window", SceneDemoWindow },
+    { "text_table", SceneTextTable },
+    { "color_pickers", SceneColorPickers },
+    { "list_10k", SceneLongList },
+};
+
+struct BenchmarkResult
+{
+    ImU64 Time;
+    ImU64 Vertices;
+    ImU64 Calls;
+    ImU64 Allocations;
+    int Frames;
+    /** @brief Command lists translated in parallel that differ from serial translation */
+    int Mismatches;
+};
+
+/** @brief Backend state kept between frames, like ImGui_ImplD2D_RenderDrawData() does */
+struct BenchmarkBackend
+{
+    ImGui_ImplD2D_FontTable Fonts;
+    ImGui_ImplD2D_FrameCommands Commands;
+    /** @brief Serial translation of the same frame, reference of parallel one */
+    ImGui_ImplD2D_FrameCommands SerialCommands;
+    ImGui_ImplD2D_RecordingDevice Device;
+    /** @brief Draw lists are translated in parallel when set */
+    ThreadPool* Pool;
+
+    BenchmarkBackend(ThreadPool* pool = nullptr) { Fonts.Build(ImGui::GetIO().Fonts); Pool = pool; }
+};
+
+static bool EqualCommandLists(const ImGui_ImplD2D_CommandList& a, const ImGui_ImplD2D_CommandList& b) {
+    return a.Commands.Size == b.Commands.Size && a.Points.Size == b.Points.Size && a.Glyphs.Size == b.Glyphs.Size &&
+        memcmp(a.Commands.Data, b.Commands.Data, (size_t)a.Commands.size_in_bytes()) == 0 &&
+        memcmp(a.Points.Data, b.Points.Data, (size_t)a.Points.size_in_bytes()) == 0 &&
+        memcmp(a.Glyphs.Data, b.Glyphs.Data, (size_t)a.Glyphs.size_in_bytes()) == 0;
+}
+
+/** @brief Translate & submit draw data, measurements are added to @p result unless it is null (warm up) */
+static void MeasureFrame(const ImDrawData* drawData, BenchmarkBackend& backend, BenchmarkResult* result) {
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplD2D_TranslateParams params;
+    params.Fonts = &backend.Fonts;
+    params.FontGlobalScale = io.FontGlobalScale;
+    params.FramebufferSize = io.DisplaySize;
+    ImGui_ImplD2D_FrameStats stats;
+    memset(&stats, 0, sizeof(stats));
+    backend.Device.Reset();
+
+    const int allocationCount = g_AllocationCount;
+    const ImU64 start = ImGui_ImplD2D_GetTicks();
+    backend.Fonts.UpdateMetrics(io.Fonts);
+    backend.Commands.Translate(drawData, params, backend.Pool ? ThreadPool::ParallelFor : nullptr, backend.Pool, &stats);
+    for (int n = 0; n < backend.Commands.Count; n++) {
+        ImGui_ImplD2D_SubmitCommandList(*backend.Commands.Lists[n], &backend.Device, &stats);
+    }
+    const ImU64 time = ImGui_ImplD2D_GetTicks() - start;
+    if (result == nullptr) {
+        return;
+    }
+    result->Time += time;
+    result->Vertices += drawData->TotalVtxCount;
+    result->Calls += backend.Device.GetTotalCalls();
+    result->Allocations += g_AllocationCount - allocationCount;
+    result->Frames++;
+    if (backend.Pool != nullptr) {
+        backend.SerialCommands.Translate(drawData, params, nullptr, nullptr, &stats);
+        for (int n = 0; n < backend.Commands.Count; n++) {
+            result->Mismatches += EqualCommandLists(*backend.Commands.Lists[n], *backend.SerialCommands.Lists[n]) ? 0 : 1;
+        }
+    }
+}
+
+// frames before measurement let windows settle & backend buffers grow to their final size
+static const int g_WarmUpFrames = 3;
+
+static BenchmarkResult RunScene(const BenchmarkScene& scene, int frames, ThreadPool* pool = nullptr) {
+    BenchmarkBackend backend(pool);
+    BenchmarkResult result;
+    memset(&result, 0, sizeof(result));
+    for (int frame = 0; frame < g_WarmUpFrames + frames; frame++) {
+        ImGui::NewFrame();
+        scene.Build();
+        ImGui::Render();
+        MeasureFrame(ImGui::GetDrawData(), backend, frame < g_WarmUpFrames ? nullptr : &result);
+    }
+    return result;
+}
+
+/** @brief Dimension of synthetic scene that can be swept */
+struct SweepDimension
+{
+    const char* Name;
+    int SyntheticSceneDesc::* Field;
+    /** @brief Dimensions that barely add vertices stop here instead of at vertex limit */
+    int MaxValue;
+};
+
+static const SweepDimension g_SweepDimensions[] = {
+    { "windows", &SyntheticSceneDesc::Windows, 1024 },
+    { "glyphs", &SyntheticSceneDesc::Glyphs, 1 << 24 },
+    { "rects", &SyntheticSceneDesc::Rects, 1 << 24 },
+    { "rounded", &SyntheticSceneDesc::RoundedShapes, 1 << 24 },
+    { "gradients", &SyntheticSceneDesc::Gradients, 1 << 24 },
+    { "images", &SyntheticSceneDesc::Images, 1 << 24 },
+    { "clips", &SyntheticSceneDesc::ClipChanges, 1 << 16 },
+};
+
+/** @brief Double one dimension of synthetic scene (others stay at moderate base values) up to @p maxVertices */
+static int RunSweep(const char* dimensionName, int frames, int maxVertices) {
+    const SweepDimension* dimension = nullptr;
+    for (const SweepDimension& d : g_SweepDimensions) {
+        if (strcmp(d.Name, dimensionName) == 0) {
+            dimension = &d;
+        }
+    }
+    if (dimension == nullptr) {
+        fprintf(stderr, "Unknown sweep dimension %s\n", dimensionName);
+        return 1;
+    }
+    SyntheticSceneDesc desc;
+    desc.Windows = 4;
+    desc.Glyphs = 2000;
+    desc.Rects = 500;
+    desc.RoundedShapes = 100;
+    desc.Gradients = 100;
+    desc.Images = 50;
+    desc.ClipChanges = 16;
+
+    printf("dimension,value,vertices,ns_per_vertex,calls_per_frame,allocs_per_frame\n");
+    SyntheticScene scene;
+    for (int value = 1; value <= dimension->MaxValue; value *= 2) {
+        desc.*(dimension->Field) = value;
+        scene.Build(desc);
+        if (scene.DrawData.TotalVtxCount > maxVertices) {
+            break;
+        }
+        BenchmarkBackend backend;
+        BenchmarkResult result;
+        memset(&result, 0, sizeof(result));
+        for (int frame = 0; frame < g_WarmUpFrames + frames; frame++) {
+            MeasureFrame(&scene.DrawData, backend, frame < g_WarmUpFrames ? nullptr : &result);
+        }
+        printf("%s,%d,%d,%.3f,%.1f,%.2f\n", dimension->Name, value, scene.DrawData.TotalVtxCount,
+            result.Vertices ? (double)result.Time / (double)result.Vertices : 0.0,
+            (double)result.Calls / result.Frames,
+            (double)result.Allocations / result.Frames);
+        fflush(stdout);
+    }
+    return 0;
+}
+
+/** @brief Translate scenes with 1 to @p maxThreads threads, prints time & speedup over one thread as CSV
+
+    Every measured frame is translated serially too, fails when any command list of parallel translation differs.
+ */
+static int RunScaling(int maxThreads, int frames, const char* sceneFilter) {
+    // windows of synthetic scene are separate draw lists, canned scenes have only a few
+    SyntheticSceneDesc desc;
+    desc.Windows = 64;
+    desc.Glyphs = 100000;
+    desc.Rects = 20000;
+    desc.RoundedShapes = 2000;
+    desc.Gradients = 2000;
+    desc.Images = 500;
+    desc.ClipChanges = 256;
+    SyntheticScene synthetic;
+    synthetic.Build(desc);
+
+    printf("scene,threads,draw_lists,ns_per_vertex,speedup\n");
+    const int sceneCount = IM_ARRAYSIZE(g_Scenes) + 1;
+    for (int s = 0; s < sceneCount; s++) {
+        const bool isSynthetic = s == IM_ARRAYSIZE(g_Scenes);
+        const char* name = isSynthetic ? "synthetic_64_windows" : g_Scenes[s].Name;
+        if (sceneFilter != nullptr && strcmp(sceneFilter, name) != 0) {
+            continue;
+        }
+        double singleThread = 0.0;
+        for (int threads = 1; threads <= maxThreads; threads++) {
+            ThreadPool pool;
+            pool.Start(threads);
+            BenchmarkResult result;
+            int drawLists = 0;
+            if (isSynthetic) {
+                BenchmarkBackend backend(&pool);
+                memset(&result, 0, sizeof(result));
+                for (int frame = 0; frame < g_WarmUpFrames + frames; frame++) {
+                    MeasureFrame(&synthetic.DrawData, backend, frame < g_WarmUpFrames ? nullptr : &result);
+                }
+                drawLists = synthetic.DrawData.CmdListsCount;
+            }
+            else {
+                result = RunScene(g_Scenes[s], frames, &pool);
+                drawLists = ImGui::GetDrawData()->CmdListsCount;
+            }
+            const double nsPerVertex = result.Vertices ? (double)result.Time / (double)result.Vertices : 0.0;
+            if (threads == 1) {
+                singleThread = nsPerVertex;
+            }
+            printf("%s,%d,%d,%.3f,%.2f\n", name, threads, drawLists, nsPerVertex, nsPerVertex > 0.0 ? singleThread / nsPerVertex : 0.0);
+            fflush(stdout);
+            if (result.Mismatches != 0) {
+                fprintf(stderr, "%s: %d command lists translated by %d threads differ from serial translation\n", name, result.Mismatches, threads);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/** @brief State of benchmark render thread, only touched by render thread until it is stopped */
+struct RenderThreadTarget
+{
+    BenchmarkBackend Backend;
+};
+
+static void RenderSnapshotToDevice(ImGui_ImplD2D_DrawDataSnapshot* snapshot, void* userData) {
+    RenderThreadTarget* target = (RenderThreadTarget*)userData;
+    target->Backend.Device.Reset();
+    target->Backend.Commands.Translate(&snapshot->DrawData, snapshot->Params, nullptr, nullptr, &snapshot->Stats);
+    for (int n = 0; n < target->Backend.Commands.Count; n++) {
+        ImGui_ImplD2D_SubmitCommandList(*target->Backend.Commands.Lists[n], &target->Backend.Device, &snapshot->Stats);
+    }
+}
+
+/** @brief Hand frames of each scene to render thread, compare UI thread time with rendering on UI thread */
+static int RunRenderThread(int frames, const char* sceneFilter) {
+    printf("%-16s %8s %8s %14s %14s\n", "scene", "buffers", "frames", "serial us/fr", "handoff us/fr");
+    for (const BenchmarkScene& scene : g_Scenes) {
+        if (sceneFilter != nullptr && strcmp(sceneFilter, scene.Name) != 0) {
+            continue;
+        }
+        for (int buffers = 1; buffers <= ImGui_ImplD2D_RenderThread::MaxSnapshots; buffers++) {
+            BenchmarkBackend serial;
+            BenchmarkResult serialResult;
+            memset(&serialResult, 0, sizeof(serialResult));
+            RenderThreadTarget target;
+            ImGui_ImplD2D_RenderThread renderThread;
+            renderThread.Start(RenderSnapshotToDevice, &target, buffers == 2);
+            ImU64 handoffTime = 0;
+            for (int frame = 0; frame < frames; frame++) {
+                ImGui::NewFrame();
+                scene.Build();
+                ImGui::Render();
+                const ImDrawData* drawData = ImGui::GetDrawData();
+                // reference on UI thread, also refreshes font metrics used by snapshot
+                MeasureFrame(drawData, serial, &serialResult);
+
+                ImGui_ImplD2D_TranslateParams params;
+                params.Fonts = &serial.Fonts;
+                params.FontGlobalScale = ImGui::GetIO().FontGlobalScale;
+                params.FramebufferSize = ImGui::GetIO().DisplaySize;
+                const ImU64 start = ImGui_ImplD2D_GetTicks();
+                ImGui_ImplD2D_DrawDataSnapshot* snapshot = renderThread.Acquire();
+                snapshot->Copy(drawData, serial.Fonts, params);
+                renderThread.Publish(snapshot);
+                handoffTime += ImGui_ImplD2D_GetTicks() - start;
+            }
+            renderThread.Stop();
+            printf("%-16s %8d %8d %14.1f %14.1f\n", scene.Name, buffers, frames,
+                serialResult.Time / 1000.0 / frames, handoffTime / 1000.0 / frames);
+        }
+    }
+    return 0;
+}
+
+/** @brief Build command buffer of each frame on worker thread & submit it to two devices
+
+    Fails when command lists of buffer differ from translation of the same frame on UI thread.
+ */
+static int RunCommandBuffer(int frames, const char* sceneFilter) {
+    printf("%-16s %8s %14s %14s %12s\n", "scene", "frames", "build us/fr", "submit us/fr", "allocs/fr");
+    for (const BenchmarkScene& scene : g_Scenes) {
+        if (sceneFilter != nullptr && strcmp(sceneFilter, scene.Name) != 0) {
+            continue;
+        }
+        BenchmarkBackend serial;
+        BenchmarkResult serialResult;
+        memset(&serialResult, 0, sizeof(serialResult));
+        ImGui_ImplD2D_CommandBuffer buffer;
+        ImGui_ImplD2D_RecordingDevice devices[2];
+        ImU64 buildTime = 0;
+        ImU64 submitTime = 0;
+        int allocations = 0;
+        for (int frame = 0; frame < g_WarmUpFrames + frames; frame++) {
+            ImGui::NewFrame();
+            scene.Build();
+            ImGui::Render();
+            const ImDrawData* drawData = ImGui::GetDrawData();
+            const bool measured = frame >= g_WarmUpFrames;
+            // reference on UI thread, also refreshes font metrics used by builder
+            MeasureFrame(drawData, serial, measured ? &serialResult : nullptr);
+
+            ImGui_ImplD2D_TranslateParams params;
+            params.Fonts = &serial.Fonts;
+            params.FontGlobalScale = ImGui::GetIO().FontGlobalScale;
+            params.FramebufferSize = ImGui::GetIO().DisplaySize;
+            const int allocationCount = g_AllocationCount;
+            ImU64 frameBuildTime = 0;
+            std::thread builder([&] {
+                const ImU64 start = ImGui_ImplD2D_GetTicks();
+                buffer.Build(drawData, params, nullptr, nullptr);
+                frameBuildTime = ImGui_ImplD2D_GetTicks() - start;
+            });
+            builder.join();
+            const int frameAllocations = g_AllocationCount - allocationCount;
+            int mismatches = buffer.Frame.Count != serial.Commands.Count ? 1 : 0;
+            for (int n = 0; n < buffer.Frame.Count && mismatches == 0; n++) {
+                mismatches += EqualCommandLists(*buffer.Frame.Lists[n], *serial.Commands.Lists[n]) ? 0 : 1;
+            }
+            if (mismatches != 0) {
+                fprintf(stderr, "%s: command buffer differs from translation on UI thread\n", scene.Name);
+                return 1;
+            }
+
+            // same buffer replayed on every target
+            const ImU64 start = ImGui_ImplD2D_GetTicks();
+            for (int d = 0; d < IM_ARRAYSIZE(devices); d++) {
+                ImGui_ImplD2D_FrameStats stats;
+                memset(&stats, 0, sizeof(stats));
+                devices[d].Reset();
+                buffer.Submit(&devices[d], &stats);
+            }
+            const ImU64 frameSubmitTime = ImGui_ImplD2D_GetTicks() - start;
+            if (!measured) {
+                continue;
+            }
+            buildTime += frameBuildTime;
+            submitTime += frameSubmitTime;
+            allocations += frameAllocations;
+        }
+        printf("%-16s %8d %14.1f %14.1f %12.1f\n", scene.Name, frames,
+            buildTime / 1000.0 / frames, submitTime / 1000.0 / IM_ARRAYSIZE(devices) / frames, (double)allocations / frames);
+    }
+    return 0;
+}
+
+/** @brief Indices of one draw command copied for adjacency scan, offsets into @see ScanData arrays */
+struct ScanCommand
+{
+    int     IdxOffset;
+    int     Count;
+    int     VtxOffset;
+};
+
+struct ScanData
+{
+    ImVector<ScanCommand> Commands;
+    ImVector<ImDrawVert> Vertices;
+    ImVector<ImU16> Indices16;
+    ImVector<ImU32> Indices32;
+};
+
+/** @brief Walk every draw command from run to run, returns number of triangles continuing solid runs */
+template<typename T>
+static ImU64 ScanRuns(const ScanData& data, const ImVector<T>& indices, bool vectorized) {
+    ImGui_ImplD2D_FrameStats stats;
+    memset(&stats, 0, sizeof(stats));
+    ImU64 continued = 0;
+    for (const ScanCommand& command : data.Commands) {
+        const T* idx = indices.Data + command.IdxOffset;
+        const ImDrawVert* vert = data.Vertices.Data + command.VtxOffset;
+        for (int i = 6; i + 2 < command.Count;) {
+            const ImU32 col = vert[idx[i - 3]].col;
+            const int run = vectorized ? ImGui_ImplD2D_ScanSolidRun(idx, i, command.Count, vert, col, &stats) : ImGui_ImplD2D_ScanSolidRunScalar(idx, i, command.Count, vert, col, &stats);
+            continued += run;
+            i += 3 * (run + 1);
+        }
+    }
+    return continued;
+}
+
+template<typename T>
+static void RunScanWidth(const ScanData& data, const ImVector<T>& indices, int frames, ImU64 triangles) {
+    ImU64 times[2] = { 0, 0 };
+    ImU64 continued[2] = { 0, 0 };
+    for (int frame = 0; frame < frames; frame++) {
+        for (int vectorized = 0; vectorized < 2; vectorized++) {
+            const ImU64 start = ImGui_ImplD2D_GetTicks();
+            continued[vectorized] = ScanRuns(data, indices, vectorized != 0);
+            times[vectorized] += ImGui_ImplD2D_GetTicks() - start;
+        }
+    }
+    const int bits = (int)sizeof(T) * 8;
+    printf("%6d %-10s %12llu %12llu %12.3f\n", bits, "scalar", (unsigned long long)triangles, (unsigned long long)continued[0], (double)times[0] / ((double)triangles * frames));
+    printf("%6d %-10s %12llu %12llu %12.3f\n", bits, "block", (unsigned long long)triangles, (unsigned long long)continued[1], (double)times[1] / ((double)triangles * frames));
+}
+
+/** @brief Scan triangle adjacency of all scenes with block scanner & scalar reference, for 16 & 32 bit indices */
+static int RunScan(int frames) {
+    ScanData data;
+    ImU64 triangles = 0;
+    for (const BenchmarkScene& scene : g_Scenes) {
+        ImGui::NewFrame();
+        scene.Build();
+        ImGui::Render();
+        const ImDrawData* drawData = ImGui::GetDrawData();
+        for (int n = 0; n < drawData->CmdListsCount; n++) {
+            const ImDrawList* drawList = drawData->CmdLists[n];
+            const int vtxOffset = data.Vertices.Size;
+            for (int v = 0; v < drawList->VtxBuffer.Size; v++) {
+                data.Vertices.push_back(drawList->VtxBuffer[v]);
+            }
+            for (const ImDrawCmd& cmd : drawList->CmdBuffer) {
+                if (cmd.UserCallback != nullptr || cmd.ElemCount < 9) {
+                    continue;
+                }
+                ScanCommand command;
+                command.IdxOffset = data.Indices16.Size;
+                command.Count = (int)cmd.ElemCount;
+                command.VtxOffset = vtxOffset + (int)cmd.VtxOffset;
+                for (unsigned int i = 0; i < cmd.ElemCount; i++) {
+                    const ImDrawIdx index = drawList->IdxBuffer[(int)(cmd.IdxOffset + i)];
+                    data.Indices16.push_back((ImU16)index);
+                    data.Indices32.push_back((ImU32)index);
+                }
+                data.Commands.push_back(command);
+                triangles += cmd.ElemCount / 3 - 2;
+            }
+        }
+    }
+    printf("%6s %-10s %12s %12s %12s\n", "bits", "path", "triangles", "continued", "ns/triangle");
+    if (triangles == 0) {
+        return 0;
+    }
+    if (sizeof(ImDrawIdx) == 2) {
+        RunScanWidth(data, data.Indices16, frames, triangles);
+    }
+    RunScanWidth(data, data.Indices32, frames, triangles);
+    return 0;
+}
+
+/** @brief Translation features measured by --features */
+struct FeatureSet
+{
+    const char* Name;
+    ImGui_ImplD2D_TranslateFeatures Features;
+};
+
+static const FeatureSet g_FeatureSets[] = {
+    { "all", ImGui_ImplD2D_TranslateFeatures_All },
+    { "no-stats", ImGui_ImplD2D_TranslateFeatures_All & ~ImGui_ImplD2D_TranslateFeatures_Stats },
+    { "no-text", ImGui_ImplD2D_TranslateFeatures_All & ~ImGui_ImplD2D_TranslateFeatures_Text },
+    { "no-gradients", ImGui_ImplD2D_TranslateFeatures_All & ~ImGui_ImplD2D_TranslateFeatures_Gradients },
+    { "no-cull", ImGui_ImplD2D_TranslateFeatures_All & ~ImGui_ImplD2D_TranslateFeatures_Cull },
+    { "none", ImGui_ImplD2D_TranslateFeatures_None },
+};
+
+/** @brief Translate last frame of each scene with every feature set, with 16 & 32 bit copies of indices */
+static int RunFeatures(int frames, const char* sceneFilter) {
+    printf("%-16s %-12s %6s %10s %10s\n", "scene", "features", "index", "commands", "ns/vertex");
+    for (const BenchmarkScene& scene : g_Scenes) {
+        if (sceneFilter != nullptr && strcmp(sceneFilter, scene.Name) != 0) {
+            continue;
+        }
+        for (int frame = 0; frame <= g_WarmUpFrames; frame++) {
+            ImGui::NewFrame();
+            scene.Build();
+            ImGui::Render();
+        }
+        const ImDrawData* drawData = ImGui::GetDrawData();
+        if (drawData->TotalVtxCount == 0) {
+            continue;
+        }
+        // indices of all lists copied back to back, ImVector does not destroy nested vectors
+        ImVector<ImU16> indices16;
+        ImVector<ImU32> indices32;
+        for (int n = 0; n < drawData->CmdListsCount; n++) {
+            const ImVector<ImDrawIdx>& idx = drawData->CmdLists[n]->IdxBuffer;
+            for (int i = 0; i < idx.Size; i++) {
+                indices16.push_back((ImU16)idx[i]);
+                indices32.push_back((ImU32)idx[i]);
+            }
+        }
+        BenchmarkBackend backend;
+        backend.Fonts.UpdateMetrics(ImGui::GetIO().Fonts);
+        ImGui_ImplD2D_CommandList commands;
+        for (const FeatureSet& set : g_FeatureSets) {
+            ImGui_ImplD2D_TranslateParams params;
+            params.Fonts = &backend.Fonts;
+            params.FontGlobalScale = ImGui::GetIO().FontGlobalScale;
+            params.FramebufferSize = ImGui::GetIO().DisplaySize;
+            params.Features = set.Features;
+            int commandCounts[2] = { 0, 0 };
+            for (int width = 0; width < 2; width++) {
+                // 16 bit copy is only exact when indices fit
+                if (width == 0 && sizeof(ImDrawIdx) > 2 && drawData->TotalVtxCount > 0xFFFF) {
+                    continue;
+                }
+                ImGui_ImplD2D_FrameStats stats;
+                memset(&stats, 0, sizeof(stats));
+                const ImU64 start = ImGui_ImplD2D_GetTicks();
+                for (int frame = 0; frame < frames; frame++) {
+                    commandCounts[width] = 0;
+                    int idxOffset = 0;
+                    for (int n = 0; n < drawData->CmdListsCount; n++) {
+                        commands.Reset();
+                        if (width == 0) {
+                            ImGui_ImplD2D_TranslateDrawList(drawData->CmdLists[n], indices16.Data + idxOffset, params, &commands, &stats);
+                        }
+                        else {
+                            ImGui_ImplD2D_TranslateDrawList(drawData->CmdLists[n], indices32.Data + idxOffset, params, &commands, &stats);
+                        }
+                        idxOffset += drawData->CmdLists[n]->IdxBuffer.Size;
+                        commandCounts[width] += commands.Commands.Size;
+                    }
+                }
+                const ImU64 time = ImGui_ImplD2D_GetTicks() - start;
+                printf("%-16s %-12s %6d %10d %10.2f\n", scene.Name, set.Name, width == 0 ? 16 : 32, commandCounts[width],
+                    (double)time / ((double)drawData->TotalVtxCount * frames));
+            }
+        }
+    }
+    return 0;
+}
+
+/** @brief Translate frames of each scene with & without reuse of unchanged draw lists
+
+    Small window showing frame number is added to each scene, so one draw list changes every frame.
+ */
+static int RunReuse(int frames, const char* sceneFilter) {
+    printf("%-16s %8s %14s %14s %10s %8s\n", "scene", "frames", "fresh us/fr", "reuse us/fr", "lists/fr", "reused");
+    for (const BenchmarkScene& scene : g_Scenes) {
+        if (sceneFilter != nullptr && strcmp(sceneFilter, scene.Name) != 0) {
+            continue;
+        }
+        BenchmarkBackend fresh;
+        BenchmarkBackend reuse;
+        reuse.Commands.ReuseUnchanged = true;
+        ImU64 times[2] = { 0, 0 };
+        ImGui_ImplD2D_FrameStats reuseTotals;
+        memset(&reuseTotals, 0, sizeof(reuseTotals));
+        for (int frame = 0; frame < g_WarmUpFrames + frames; frame++) {
+            ImGui::NewFrame();
+            scene.Build();
+            ImGui::SetNextWindowPos(ImVec2(10, 10));
+            ImGui::Begin("Frame counter", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+            ImGui::Text("Frame %d", frame);
+            ImGui::End();
+            ImGui::Render();
+            const ImDrawData* drawData = ImGui::GetDrawData();
+            ImGui_ImplD2D_TranslateParams params;
+            params.Fonts = &fresh.Fonts;
+            params.FontGlobalScale = ImGui::GetIO().FontGlobalScale;
+            params.FramebufferSize = ImGui::GetIO().DisplaySize;
+            fresh.Fonts.UpdateMetrics(ImGui::GetIO().Fonts);
+            BenchmarkBackend* backends[2] = { &fresh, &reuse };
+            ImGui_ImplD2D_FrameStats stats[2];
+            for (int b = 0; b < 2; b++) {
+                memset(&stats[b], 0, sizeof(stats[b]));
+                const ImU64 start = ImGui_ImplD2D_GetTicks();
+                backends[b]->Commands.Translate(drawData, params, nullptr, nullptr, &stats[b]);
+                if (frame >= g_WarmUpFrames) {
+                    times[b] += ImGui_ImplD2D_GetTicks() - start;
+                }
+            }
+            if (frame >= g_WarmUpFrames) {
+                ImGui_ImplD2D_AddFrameStats(&reuseTotals, stats[1]);
+            }
+        }
+        const int lists = reuseTotals.DrawListsTranslated + reuseTotals.DrawListsReused;
+        printf("%-16s %8d %14.1f %14.1f %10.1f %7.0f%%\n", scene.Name, frames, times[0] / 1000.0 / frames, times[1] / 1000.0 / frames,
+            (double)lists / frames, lists > 0 ? 100.0 * reuseTotals.DrawListsReused / lists : 0.0);
+    }
+    return 0;
+}
+
+/** @brief Window cache of one budget measured by --layers */
+struct LayerRun
+{
+    ImU64 Budget;
+    BenchmarkBackend Backend;
+    ImGui_ImplD2D_LayerCache Cache;
+    ImU64 Calls;
+    ImU64 PeakBytes;
+    ImGui_ImplD2D_FrameStats Totals;
+};
+
+/** @brief Draw frames of each scene through window cache with large & small budget, report calls compared with direct drawing
+
+    Small window showing frame number is added to each scene, so one layer is redrawn every frame.
+ */
+static int RunLayers(int frames, const char* sceneFilter) {
+    printf("%-16s %10s %14s %14s %10s %10s %10s\n", "scene", "budget MB", "direct call/fr", "cached call/fr", "drawn/fr", "reused/fr", "peak MB");
+    static const ImU64 budgets[] = { 256 * 1024 * 1024, 1024 * 1024 };
+    for (const BenchmarkScene& scene : g_Scenes) {
+        if (sceneFilter != nullptr && strcmp(sceneFilter, scene.Name) != 0) {
+            continue;
+        }
+        BenchmarkBackend direct;
+        ImU64 directCalls = 0;
+        LayerRun runs[IM_ARRAYSIZE(budgets)];
+        for (int r = 0; r < IM_ARRAYSIZE(budgets); r++) {
+            runs[r].Budget = budgets[r];
+            runs[r].Backend.Commands.HashLists = true;
+            runs[r].Cache.Budget = budgets[r];
+            runs[r].Calls = 0;
+            runs[r].PeakBytes = 0;
+            memset(&runs[r].Totals, 0, sizeof(runs[r].Totals));
+        }
+        for (int frame = 0; frame < g_WarmUpFrames + frames; frame++) {
+            ImGui::NewFrame();
+            scene.Build();
+            ImGui::SetNextWindowPos(ImVec2(10, 10));
+            ImGui::Begin("Frame counter", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+            ImGui::Text("Frame %d", frame);
+            ImGui::End();
+            ImGui::Render();
+            const ImDrawData* drawData = ImGui::GetDrawData();
+            const bool measured = frame >= g_WarmUpFrames;
+            // direct drawing also refreshes font metrics shared by parameters
+            BenchmarkResult directResult;
+            memset(&directResult, 0, sizeof(directResult));
+            MeasureFrame(drawData, direct, &directResult);
+            if (measured) {
+                directCalls += directResult.Calls;
+            }
+            ImGui_ImplD2D_TranslateParams params;
+            params.Fonts = &direct.Fonts;
+            params.FontGlobalScale = ImGui::GetIO().FontGlobalScale;
+            params.FramebufferSize = ImGui::GetIO().DisplaySize;
+            for (LayerRun& run : runs) {
+                ImGui_ImplD2D_FrameStats stats;
+                memset(&stats, 0, sizeof(stats));
+                ImGui_ImplD2D_RecordingDevice& device = run.Backend.Device;
+                device.Reset();
+                run.Backend.Commands.Translate(drawData, params, nullptr, nullptr, &stats);
+                run.Cache.BeginFrame();
+                for (int n = 0; n < run.Backend.Commands.Count; n++) {
+                    run.Cache.Submit(*run.Backend.Commands.Lists[n], params.FramebufferSize, &device, &stats);
+                }
+                run.Cache.EndFrame(&device);
+                if (run.Cache.UsedBytes > run.PeakBytes) {
+                    run.PeakBytes = run.Cache.UsedBytes;
+                }
+                if (measured) {
+                    run.Calls += device.GetTotalCalls();
+                    ImGui_ImplD2D_AddFrameStats(&run.Totals, stats);
+                }
+            }
+        }
+        for (LayerRun& run : runs) {
+            printf("%-16s %10.0f %14.1f %14.1f %10.1f %10.1f %10.1f\n", scene.Name, run.Budget / (1024.0 * 1024.0), (double)directCalls / frames,
+                (double)run.Calls / frames, (double)run.Totals.LayersDrawn / frames, (double)run.Totals.LayersReused / frames,
+                run.PeakBytes / (1024.0 * 1024.0));
+            run.Cache.Clear(&run.Backend.Device);
+        }
+    }
+    return 0;
+}
+
+/** @brief Compute dirty rectangles of frames of each scene, report their count, covered area & time
+
+    Frame number window changes every fourth frame, every third frame vertices of one random command are moved.
+ */
+static int RunDirtyRects(int frames, const char* sceneFilter) {
+    printf("%-16s %8s %10s %10s %10s %10s\n", "scene", "frames", "rects/fr", "dirty %", "clean fr", "us/frame");
+    static const int maxRects = 4;
+    unsigned int seed = 1;
+    for (const BenchmarkScene& scene : g_Scenes) {
+        if (sceneFilter != nullptr && strcmp(sceneFilter, scene.Name) != 0) {
+            continue;
+        }
+        BenchmarkBackend backend;
+        ImGui_ImplD2D_DirtyTracker tracker;
+        ImGui_ImplD2D_DrawDataSnapshot snapshot;
+        ImGui_ImplD2D_TranslateParams params;
+        int rectCount = 0;
+        int cleanFrames = 0;
+        double dirtyArea = 0.0;
+        ImU64 time = 0;
+        for (int frame = 0; frame < g_WarmUpFrames + frames; frame++) {
+            ImGui::NewFrame();
+            scene.Build();
+            ImGui::SetNextWindowPos(ImVec2(10, 10));
+            ImGui::Begin("Frame counter", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+            ImGui::Text("Frame %d", frame / 4);
+            ImGui::End();
+            ImGui::Render();
+            // vertices are moved in copy of draw data
+            snapshot.Copy(ImGui::GetDrawData(), backend.Fonts, params);
+            ImDrawData* drawData = &snapshot.DrawData;
+            if (frame % 3 == 2 && drawData->CmdListsCount > 0) {
+                seed = seed * 1103515245u + 12345u;
+                ImDrawList* drawList = drawData->CmdLists[(seed >> 8) % (unsigned int)drawData->CmdListsCount];
+                const ImDrawCmd& cmd = drawList->CmdBuffer[(seed >> 16) % (unsigned int)drawList->CmdBuffer.Size];
+                unsigned int last = 0;
+                for (unsigned int i = 0; i < cmd.ElemCount; i++) {
+                    last = drawList->IdxBuffer[cmd.IdxOffset + i] > last ? drawList->IdxBuffer[cmd.IdxOffset + i] : last;
+                }
+                for (unsigned int i = 0; cmd.ElemCount > 0 && i <= last; i++) {
+                    drawList->VtxBuffer[cmd.VtxOffset + i].pos.x += 3.0f;
+                }
+            }
+            const ImU64 start = ImGui_ImplD2D_GetTicks();
+            const int count = tracker.Compute(drawData, &backend.Fonts, ImGui::GetIO().FontGlobalScale, maxRects);
+            const ImU64 elapsed = ImGui_ImplD2D_GetTicks() - start;
+            const ImVec4* rects = tracker.Rects.Data;
+            const ImVec2 framebufferSize(drawData->DisplaySize.x * drawData->FramebufferScale.x, drawData->DisplaySize.y * drawData->FramebufferScale.y);
+            float area = 0.0f;
+            for (int r = 0; r < count; r++) {
+                area += (rects[r].z - rects[r].x) * (rects[r].w - rects[r].y);
+            }
+            if (frame >= g_WarmUpFrames) {
+                time += elapsed;
+                rectCount += count;
+                cleanFrames += count == 0 ? 1 : 0;
+                dirtyArea += area / (framebufferSize.x * framebufferSize.y);
+            }
+        }
+        printf("%-16s %8d %10.2f %9.1f%% %10d %10.1f\n", scene.Name, frames, (double)rectCount / frames, 100.0 * dirtyArea / frames,
+            cleanFrames, time / 1000.0 / frames);
+    }
+    return 0;
+}
+
+/** @brief Fingerprint frames of each scene (as ImGui_ImplD2D_IsFrameUnchanged() does) & compare cost with translation & submission
+
+    Frame number window changes every fourth frame. Fingerprinting taking more than quarter of rendering time is noted.
+ */
+static int RunFrameSkip(int frames, const char* sceneFilter) {
+    printf("%-16s %8s %10s %14s %14s %8s\n", "scene", "frames", "unchanged", "hash us/fr", "render us/fr", "ratio");
+    for (const BenchmarkScene& scene : g_Scenes) {
+        if (sceneFilter != nullptr && strcmp(sceneFilter, scene.Name) != 0) {
+            continue;
+        }
+        BenchmarkBackend backend;
+        BenchmarkResult result;
+        memset(&result, 0, sizeof(result));
+        ImU64 previousHash = 0;
+        ImU64 hashTime = 0;
+        int unchangedFrames = 0;
+        for (int frame = 0; frame < g_WarmUpFrames + frames; frame++) {
+            ImGui::NewFrame();
+            scene.Build();
+            ImGui::SetNextWindowPos(ImVec2(10, 10));
+            ImGui::Begin("Frame counter", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+            ImGui::Text("Frame %d", frame / 4);
+            ImGui::End();
+            ImGui::Render();
+            const ImDrawData* drawData = ImGui::GetDrawData();
+            const bool measured = frame >= g_WarmUpFrames;
+            const ImU64 start = ImGui_ImplD2D_GetTicks();
+            ImU64 hash = 0;
+            const bool hashed = ImGui_ImplD2D_HashDrawData(drawData, 0, &hash);
+            if (measured) {
+                hashTime += ImGui_ImplD2D_GetTicks() - start;
+            }
+            MeasureFrame(drawData, backend, measured ? &result : nullptr);
+            if (frame > 0 && hashed) {
+                unchangedFrames += hash == previousHash && measured ? 1 : 0;
+            }
+            previousHash = hash;
+        }
+        printf("%-16s %8d %10d %14.1f %14.1f %7.1f%%\n", scene.Name, frames, unchangedFrames, hashTime / 1000.0 / frames,
+            result.Time / 1000.0 / frames, result.Time > 0 ? 100.0 * hashTime / result.Time : 0.0);
+        // timing depends on machine & load, only reported
+        if (hashTime * 4 > result.Time) {
+            printf("note: %s: fingerprint takes more than quarter of rendering time\n", scene.Name);
+        }
+    }
+    return 0;
+}
+
+/** @brief Window with widgets scrolled by few pixels every frame */
+static void SceneScrolling(int frame) {
+    ImGui::SetNextWindowPos(ImVec2(100, 100));
+    ImGui::SetNextWindowSize(ImVec2(600, 800));
+    ImGui::Begin("Scrolling");
+    ImGui::SetScrollY((float)((frame * 7) % 4000));
+    static bool checks[200] = {};
+    for (int i = 0; i < 200; i++) {
+        ImGui::PushID(i);
+        ImGui::Button("Button");
+        ImGui::SameLine();
+        ImGui::Checkbox("Check", &checks[i]);
+        ImGui::SameLine();
+        ImGui::ProgressBar((i % 10) / 10.0f, ImVec2(200, 0));
+        ImGui::Separator();
+        ImGui::PopID();
+    }
+    ImGui::End();
+}
+
+/** @brief Draw continuously scrolled window through geometry cache & directly, report cache hit rate
+
+    Hit rate of cache keyed by shape relative to first point is compared with key of absolute points (shapes seen
+    in previous frame at the same position).
+ */
+static int RunScroll(int frames) {
+    printf("%-16s %8s %12s %12s %12s %12s\n", "scene", "frames", "polygons/fr", "created/fr", "hit rate", "abs hit rate");
+    BenchmarkBackend backend;
+    ImGui_ImplD2D_RecordingDevice cachedDevice;
+    ImGui_ImplD2D_GeometryCache cache;
+    cache.MaxEntries = 4096;
+    ImGuiStorage previousShapes;
+    ImGuiStorage currentShapes;
+    ImGui_ImplD2D_FrameStats totals;
+    memset(&totals, 0, sizeof(totals));
+    int polygons = 0;
+    int absoluteHits = 0;
+    for (int frame = 0; frame < g_WarmUpFrames + frames; frame++) {
+        ImGui::NewFrame();
+        SceneScrolling(frame);
+        ImGui::Render();
+        const ImDrawData* drawData = ImGui::GetDrawData();
+        const bool measured = frame >= g_WarmUpFrames;
+        ImGui_ImplD2D_TranslateParams params;
+        params.Fonts = &backend.Fonts;
+        params.FontGlobalScale = ImGui::GetIO().FontGlobalScale;
+        params.FramebufferSize = ImGui::GetIO().DisplaySize;
+        ImGui_ImplD2D_FrameStats stats;
+        memset(&stats, 0, sizeof(stats));
+        backend.Fonts.UpdateMetrics(ImGui::GetIO().Fonts);
+        backend.Commands.Translate(drawData, params, nullptr, nullptr, &stats);
+        cache.BeginFrame();
+        currentShapes.Clear();
+        for (int n = 0; n < backend.Commands.Count; n++) {
+            const ImGui_ImplD2D_CommandList& list = *backend.Commands.Lists[n];
+            ImGui_ImplD2D_SubmitCommandList(list, &cachedDevice, &stats, &cache);
+            // shapes keyed by absolute points, as content keyed cache without normalization would be
+            for (int c = 0; c < list.Commands.Size; c++) {
+                const ImGui_ImplD2D_Command& command = list.Commands[c];
+                if (command.Type != ImGui_ImplD2D_CommandType_Solid && command.Type != ImGui_ImplD2D_CommandType_LinearGradient &&
+                    command.Type != ImGui_ImplD2D_CommandType_RadialGradient) {
+                    continue;
+                }
+                const ImGuiID key = (ImGuiID)ImGui_ImplD2D_Hash(list.Points.Data + command.Offset, command.Count * 3 * sizeof(ImVec2), 0);
+                if (measured) {
+                    absoluteHits += previousShapes.GetInt(key) != 0 ? 1 : 0;
+                    polygons++;
+                }
+                currentShapes.SetInt(key, 1);
+            }
+        }
+        cache.EndFrame(&cachedDevice);
+        previousShapes.Data.swap(currentShapes.Data);
+        if (measured) {
+            ImGui_ImplD2D_AddFrameStats(&totals, stats);
+        }
+    }
+    cache.Clear(&cachedDevice);
+    const int drawn = totals.GeometriesCreated + totals.GeometriesReused;
+    printf("%-16s %8d %12.1f %12.1f %11.1f%% %11.1f%%\n", "scrolling", frames, (double)polygons / frames, (double)totals.GeometriesCreated / frames,
+        drawn > 0 ? 100.0 * totals.GeometriesReused / drawn : 0.0, polygons > 0 ? 100.0 * absoluteHits / polygons : 0.0);
+    return 0;
+}
+
+static void SceneScrolled() {
+    SceneScrolling(100);
+}
+
+/** @brief Translate & submit each scene (and scrolled window) with & without culling */
+static int RunCulling(int frames, const char* sceneFilter) {
+    printf("%-16s %10s %10s %12s %12s %10s %10s\n", "scene", "culled/fr", "unclip/fr", "calls", "calls culled", "ms/frame", "ms culled");
+    const BenchmarkScene scrolled = { "scrolling", SceneScrolled };
+    for (int s = 0; s <= IM_ARRAYSIZE(g_Scenes); s++) {
+        const BenchmarkScene& scene = s < IM_ARRAYSIZE(g_Scenes) ? g_Scenes[s] : scrolled;
+        if (sceneFilter != nullptr && strcmp(sceneFilter, scene.Name) != 0) {
+            continue;
+        }
+        BenchmarkBackend backends[2];
+        ImGui_ImplD2D_FrameStats stats[2];
+        ImU64 times[2] = { 0, 0 };
+        ImU64 calls[2] = { 0, 0 };
+        memset(stats, 0, sizeof(stats));
+        for (int frame = 0; frame < g_WarmUpFrames + frames; frame++) {
+            ImGui::NewFrame();
+            scene.Build();
+            ImGui::Render();
+            const ImDrawData* drawData = ImGui::GetDrawData();
+            const bool measured = frame >= g_WarmUpFrames;
+            for (int culling = 0; culling < 2; culling++) {
+                ImGui_ImplD2D_TranslateParams params;
+                params.Fonts = &backends[culling].Fonts;
+                params.FontGlobalScale = ImGui::GetIO().FontGlobalScale;
+                params.FramebufferSize = ImGui::GetIO().DisplaySize;
+                params.Features = culling ? ImGui_ImplD2D_TranslateFeatures_All : ImGui_ImplD2D_TranslateFeatures_All & ~ImGui_ImplD2D_TranslateFeatures_Cull;
+                ImGui_ImplD2D_RecordingDevice& device = backends[culling].Device;
+                device.Reset();
+                ImGui_ImplD2D_FrameStats frameStats;
+                memset(&frameStats, 0, sizeof(frameStats));
+                const ImU64 start = ImGui_ImplD2D_GetTicks();
+                backends[culling].Fonts.UpdateMetrics(ImGui::GetIO().Fonts);
+                backends[culling].Commands.Translate(drawData, params, nullptr, nullptr, &frameStats);
+                for (int n = 0; n < backends[culling].Commands.Count; n++) {
+                    ImGui_ImplD2D_SubmitCommandList(*backends[culling].Commands.Lists[n], &device, &frameStats);
+                }
+                if (measured) {
+                    times[culling] += ImGui_ImplD2D_GetTicks() - start;
+                    calls[culling] += device.GetTotalCalls();
+                    ImGui_ImplD2D_AddFrameStats(&stats[culling], frameStats);
+                }
+            }
+        }
+        printf("%-16s %10.1f %10.1f %12.1f %12.1f %10.3f %10.3f\n", scene.Name, (double)stats[1].PrimitivesCulled / frames,
+            (double)stats[1].ClipsSkipped / frames, (double)calls[0] / frames, (double)calls[1] / frames,
+            times[0] / 1000000.0 / frames, times[1] / 1000000.0 / frames);
+    }
+    return 0;
+}
+
+/** @brief Overlapping windows with opaque background, four stacks of windows at the same place */
+static void SceneStackedWindows() {
+    ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.10f, 0.10f, 0.12f, 1.00f));
+    for (int w = 0; w < 24; w++) {
+        char name[32];
+        snprintf(name, sizeof(name), "Stacked %d", w);
+        ImGui::SetNextWindowPos(ImVec2(20.0f + 470.0f * (w % 4), 40.0f + 60.0f * (w % 4)));
+        ImGui::SetNextWindowSize(ImVec2(450, 600));
+        ImGui::Begin(name);
+        for (int line = 0; line < 30; line++) {
+            ImGui::Text("Window %d, line %d", w, line);
+            if (line % 6 == 0) {
+                ImGui::Button("Button");
+                ImGui::SameLine();
+                ImGui::ProgressBar(line / 30.0f);
+            }
+        }
+        ImGui::End();
+    }
+    ImGui::PopStyleColor();
+}
+
+/** @brief Translate & submit each scene (and stacked opaque windows) with & without occlusion culling */
+static int RunOcclusion(int frames, const char* sceneFilter) {
+    printf("%-16s %12s %12s %12s %10s %10s\n", "scene", "occluded/fr", "calls", "calls culled", "ms/frame", "ms culled");
+    const BenchmarkScene stacked = { "stacked_windows", SceneStackedWindows };
+    for (int s = 0; s <= IM_ARRAYSIZE(g_Scenes); s++) {
+        const BenchmarkScene& scene = s < IM_ARRAYSIZE(g_Scenes) ? g_Scenes[s] : stacked;
+        if (sceneFilter != nullptr && strcmp(sceneFilter, scene.Name) != 0) {
+            continue;
+        }
+        BenchmarkBackend backends[2];
+        ImGui_ImplD2D_FrameStats stats[2];
+        ImU64 times[2] = { 0, 0 };
+        ImU64 calls[2] = { 0, 0 };
+        memset(stats, 0, sizeof(stats));
+        for (int culling = 0; culling < 2; culling++) {
+            // unchanged lists are reused, so occluders in front of list must be part of its hash
+            backends[culling].Commands.ReuseUnchanged = true;
+            backends[culling].Commands.OcclusionCulling = culling != 0;
+        }
+        for (int frame = 0; frame < g_WarmUpFrames + frames; frame++) {
+            ImGui::NewFrame();
+            scene.Build();
+            ImGui::Render();
+            const ImDrawData* drawData = ImGui::GetDrawData();
+            const bool measured = frame >= g_WarmUpFrames;
+            for (int culling = 0; culling < 2; culling++) {
+                BenchmarkBackend& backend = backends[culling];
+                ImGui_ImplD2D_TranslateParams params;
+                params.Fonts = &backend.Fonts;
+                params.FontGlobalScale = ImGui::GetIO().FontGlobalScale;
+                params.FramebufferSize = ImGui::GetIO().DisplaySize;
+                ImGui_ImplD2D_FrameStats frameStats;
+                memset(&frameStats, 0, sizeof(frameStats));
+                backend.Device.Reset();
+                const ImU64 start = ImGui_ImplD2D_GetTicks();
+                backend.Fonts.UpdateMetrics(ImGui::GetIO().Fonts);
+                backend.Commands.Translate(drawData, params, nullptr, nullptr, &frameStats);
+                for (int n = 0; n < backend.Commands.Count; n++) {
+                    ImGui_ImplD2D_SubmitCommandList(*backend.Commands.Lists[n], &backend.Device, &frameStats);
+                }
+                if (measured) {
+                    times[culling] += ImGui_ImplD2D_GetTicks() - start;
+                    calls[culling] += backend.Device.GetTotalCalls();
+                    ImGui_ImplD2D_AddFrameStats(&stats[culling], frameStats);
+                }
+            }
+        }
+        printf("%-16s %12.1f %12.1f %12.1f %10.3f %10.3f\n", scene.Name, (double)stats[1].DrawCommandsOccluded / frames,
+            (double)calls[0] / frames, (double)calls[1] / frames, times[0] / 1000000.0 / frames, times[1] / 1000000.0 / frames);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int frames = 100;
+    const char* sceneFilter = nullptr;
+    const char* sweep = nullptr;
+    int maxVertices = 2000000;
+    int scalingThreads = 0;
+    bool renderThread = false;
+    bool commandBuffer = false;
+    bool scan = false;
+    bool features = false;
+    bool reuse = false;
+    bool layers = false;
+    bool dirtyRects = false;
+    bool frameSkip = false;
+    bool scroll = false;
+    bool culling = false;
+    bool occlusion = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            sceneFilter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) {
+            sweep = argv[++i];
+        }
+        else if (strcmp(argv[i], "--max-vertices") == 0 && i + 1 < argc) {
+            maxVertices = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--scaling") == 0 && i + 1 < argc) {
+            scalingThreads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--render-thread") == 0) {
+            renderThread = true;
+        }
+        else if (strcmp(argv[i], "--command-buffer") == 0) {
+            commandBuffer = true;
+        }
+        else if (strcmp(argv[i], "--scan") == 0) {
+            scan = true;
+        }
+        else if (strcmp(argv[i], "--features") == 0) {
+            features = true;
+        }
+        else if (strcmp(argv[i], "--reuse") == 0) {
+            reuse = true;
+        }
+        else if (strcmp(argv[i], "--layers") == 0) {
+            layers = true;
+        }
+        else if (strcmp(argv[i], "--dirty-rects") == 0) {
+            dirtyRects = true;
+        }
+        else if (strcmp(argv[i], "--frame-skip") == 0) {
+            frameSkip = true;
+        }
+        else if (strcmp(argv[i], "--scroll") == 0) {
+            scroll = true;
+        }
+        else if (strcmp(argv[i], "--culling") == 0) {
+            culling = true;
+        }
+        else if (strcmp(argv[i], "--occlusion") == 0) {
+            occlusion = true;
+        }
+        else {
+            fprintf(stderr, "Usage: %s [--frames N] [--scene name]\n", argv[0]);
+            fprintf(stderr, "       %s --sweep dimension [--frames N] [--max-vertices N]\n", argv[0]);
+            fprintf(stderr, "       %s --scaling N [--frames N] [--scene name]\n", argv[0]);
+            fprintf(stderr, "       %s --render-thread [--frames N] [--scene name]\n", argv[0]);
+            fprintf(stderr, "       %s --command-buffer [--frames N] [--scene name]\n", argv[0]);
+            fprintf(stderr, "       %s --scan [--frames N]\n", argv[0]);
+            fprintf(stderr, "       %s --features [--frames N] [--scene name]\n", argv[0]);
+            fprintf(stderr, "       %s --reuse [--frames N] [--scene name]\n", argv[0]);
+            fprintf(stderr, "       %s --layers [--frames N] [--scene name]\n", argv[0]);
+            fprintf(stderr, "       %s --dirty-rects [--frames N] [--scene name]\n", argv[0]);
+            fprintf(stderr, "       %s --frame-skip [--frames N] [--scene name]\n", argv[0]);
+            fprintf(stderr, "       %s --scroll [--frames N]\n", argv[0]);
+            fprintf(stderr, "       %s --culling [--frames N] [--scene name]\n", argv[0]);
+            fprintf(stderr, "       %s --occlusion [--frames N] [--scene name]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (frames <= 0) {
+        frames = 1;
+    }
+
+    ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree, nullptr);
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    // any non-null id, texture is never sampled
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
+    if (sweep != nullptr) {
+        const int sweepResult = RunSweep(sweep, frames, maxVertices);
+        ImGui::DestroyContext();
+        return sweepResult;
+    }
+    if (scalingThreads > 0) {
+        const int scalingResult = RunScaling(scalingThreads, frames, sceneFilter);
+        ImGui::DestroyContext();
+        return scalingResult;
+    }
+    if (occlusion) {
+        const int occlusionResult = RunOcclusion(frames, sceneFilter);
+        ImGui::DestroyContext();
+        return occlusionResult;
+    }
+    if (culling) {
+        const int cullingResult = RunCulling(frames, sceneFilter);
+        ImGui::DestroyContext();
+        return cullingResult;
+    }
+    if (scroll) {
+        const int scrollResult = RunScroll(frames);
+        ImGui::DestroyContext();
+        return scrollResult;
+    }
+    if (frameSkip) {
+        const int frameSkipResult = RunFrameSkip(frames, sceneFilter);
+        ImGui::DestroyContext();
+        return frameSkipResult;
+    }
+    if (dirtyRects) {
+        const int dirtyRectsResult = RunDirtyRects(frames, sceneFilter);
+        ImGui::DestroyContext();
+        return dirtyRectsResult;
+    }
+    if (layers) {
+        const int layersResult = RunLayers(frames, sceneFilter);
+        ImGui::DestroyContext();
+        return layersResult;
+    }
+    if (reuse) {
+        const int reuseResult = RunReuse(frames, sceneFilter);
+        ImGui::DestroyContext();
+        return reuseResult;
+    }
+    if (features) {
+        const int featuresResult = RunFeatures(frames, sceneFilter);
+        ImGui::DestroyContext();
+        return featuresResult;
+    }
+    if (scan) {
+        const int scanResult = RunScan(frames);
+        ImGui::DestroyContext();
+        return scanResult;
+    }
+    if (commandBuffer) {
+        const int commandBufferResult = RunCommandBuffer(frames, sceneFilter);
+        ImGui::DestroyContext();
+        return commandBufferResult;
+    }
+    if (renderThread) {
+        const int renderThreadResult = RunRenderThread(frames, sceneFilter);
+        ImGui::DestroyContext();
+        return renderThreadResult;
+    }
+
+    printf("%-16s %8s %12s %10s %12s %12s\n", "scene", "frames", "vertices", "ns/vertex", "calls/frame", "allocs/frame");
+    int result = 0;
+    for (const BenchmarkScene& scene : g_Scenes) {
+        if (sceneFilter != nullptr && strcmp(sceneFilter, scene.Name) != 0) {
+            continue;
+        }
+        const BenchmarkResult r = RunScene(scene, frames);
+        if (r.Vertices == 0) {
+            fprintf(stderr, "FAILED: %s: scene has no vertices\n", scene.Name);
+            result = 1;
+            continue;
+        }
+        printf("%-16s %8d %12llu %10.2f %12.1f %12.2f\n", scene.Name, r.Frames,
+            (unsigned long long)(r.Vertices / r.Frames),
+            (double)r.Time / (double)r.Vertices,
+            (double)r.Calls / r.Frames,
+            (double)r.Allocations / r.Frames);
+    }
+
+    ImGui::DestroyContext();
+    return result;
+}
@@ -0,0 +1,142 @@
+// Synthetic scenes for imgui_impl_d2d benchmark
+
+#include "synthetic_scene.h"
+
+/** @brief Deterministic random numbers (xorshift32), independent of platform rand() */
+struct SyntheticRandom
+{
+    unsigned int State;
+
+    SyntheticRandom(unsigned int seed) { State = seed != 0 ? seed : 1u; }
+    unsigned int Next() {
+        State ^= State << 13;
+        State ^= State >> 17;
+        State ^= State << 5;
+        return State;
+    }
+    float Range(float min, float max) { return min + (max - min) * (float)(Next() & 0xFFFFu) / 65535.0f; }
+    ImU32 Color() { return Next() | IM_COL32_A_MASK; }
+};
+
+/** @brief Share of @p total for window @p index, remainder goes to first windows */
+static int SyntheticShare(int total, int windows, int index) {
+    return total / windows + (index < total % windows ? 1 : 0);
+}
+
+void SyntheticScene::Build(const SyntheticSceneDesc& desc) {
+    Clear();
+    ImGuiIO& io = ImGui::GetIO();
+    IM_ASSERT(io.Fonts->IsBuilt() && io.Fonts->Fonts.Size > 0);
+    const int windows = desc.Windows > 0 ? desc.Windows : 1;
+    int columns = 1;
+    while (columns * columns < windows) {
+        columns++;
+    }
+    const int rows = (windows + columns - 1) / columns;
+    const ImVec2 cellSize(io.DisplaySize.x / columns, io.DisplaySize.y / rows);
+    ImFont* font = io.Fonts->Fonts[0];
+    SyntheticRandom random(desc.Seed);
+
+    // draw list shared data (white pixel, full screen clip rectangle) is only valid inside frame
+    ImGui::NewFrame();
+    for (int w = 0; w < windows; w++) {
+        ImDrawList* list = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+        list->_ResetForNewFrame();
+        list->PushClipRectFullScreen();
+        list->PushTextureID(io.Fonts->TexID);
+        const ImVec2 min(cellSize.x * (w % columns), cellSize.y * (w / columns));
+        const ImVec2 max(min.x + cellSize.x, min.y + cellSize.y);
+
+        int glyphs = SyntheticShare(desc.Glyphs, windows, w);
+        int rects = SyntheticShare(desc.Rects, windows, w);
+        int rounded = SyntheticShare(desc.RoundedShapes, windows, w);
+        int gradients = SyntheticShare(desc.Gradients, windows, w);
+        int images = SyntheticShare(desc.Images, windows, w);
+        const int clips = SyntheticShare(desc.ClipChanges, windows, w);
+        const int items = (glyphs + 15) / 16 + rects + rounded + gradients + images;
+        int item = 0, clip = 0;
+        bool clipPushed = false;
+        // kinds are interleaved, so clip changes split all of them
+        while (glyphs > 0 || rects > 0 || rounded > 0 || gradients > 0 || images > 0) {
+            if (clips > 0 && items > 0 && clip < clips && (long long)item * clips >= (long long)clip * items) {
+                if (clipPushed) {
+                    list->PopClipRect();
+                }
+                const ImVec2 clipMin(random.Range(min.x, max.x), random.Range(min.y, max.y));
+                list->PushClipRect(clipMin, ImVec2(random.Range(clipMin.x, max.x), random.Range(clipMin.y, max.y)), true);
+                clipPushed = true;
+                clip++;
+            }
+            const ImVec2 pos(random.Range(min.x, max.x - 32.0f), random.Range(min.y, max.y - 32.0f));
+            const ImVec2 size(random.Range(4.0f, 32.0f), random.Range(4.0f, 32.0f));
+            const ImVec2 end(pos.x + size.x, pos.y + size.y);
+            if (glyphs > 0) {
+                char text[16];
+                const int count = glyphs < 16 ? glyphs : 16;
+                for (int c = 0; c < count; c++) {
+                    text[c] = (char)('!' + random.Next() % ('~' - '!'));
+                }
+                list->AddText(font, font->FontSize, pos, random.Color(), text, text + count);
+                glyphs -= count;
+                item++;
+            }
+            if (rects > 0) {
+                list->AddRectFilled(pos, end, random.Color());
+                rects--;
+                item++;
+            }
+            if (rounded > 0) {
+                if (rounded % 2) {
+                    list->AddRectFilled(pos, end, random.Color(), 6.0f);
+                }
+                else {
+                    list->AddCircleFilled(pos, size.x * 0.5f, random.Color());
+                }
+                rounded--;
+                item++;
+            }
+            if (gradients > 0) {
+                // two, three & four colors are translated to different commands
+                const ImU32 a = random.Color(), b = random.Color(), c = random.Color(), d = random.Color();
+                switch (gradients % 3) {
+                case 0: list->AddRectFilledMultiColor(pos, end, a, b, b, a); break;
+                case 1: list->AddRectFilledMultiColor(pos, end, a, b, c, a); break;
+                default: list->AddRectFilledMultiColor(pos, end, a, b, c, d); break;
+                }
+                gradients--;
+                item++;
+            }
+            if (images > 0) {
+                list->AddImage((ImTextureID)(intptr_t)(0x1000 + images % 8), pos, end);
+                images--;
+                item++;
+            }
+        }
+        if (clipPushed) {
+            list->PopClipRect();
+        }
+        list->_PopUnusedDrawCmd();
+        Lists.push_back(list);
+    }
+    ImGui::EndFrame();
+
+    DrawData.Clear();
+    DrawData.Valid = true;
+    DrawData.DisplayPos = ImVec2(0, 0);
+    DrawData.DisplaySize = io.DisplaySize;
+    DrawData.FramebufferScale = ImVec2(1, 1);
+    for (ImDrawList* list : Lists) {
+        DrawData.CmdLists.push_back(list);
+        DrawData.TotalVtxCount += list->VtxBuffer.Size;
+        DrawData.TotalIdxCount += list->IdxBuffer.Size;
+    }
+    DrawData.CmdListsCount = Lists.Size;
+}
+
+void SyntheticScene::Clear() {
+    DrawData.Clear();
+    for (ImDrawList* list : Lists) {
+        IM_DELETE(list);
+    }
+    Lists.clear();
+}
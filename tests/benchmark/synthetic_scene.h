@@ -0,0 +1,43 @@
+// Synthetic scenes for imgui_impl_d2d benchmark
+//
+// Draw lists are built with ImDrawList API directly, so every dimension of the workload (windows, glyphs,
+// shapes, gradients, images, clip changes) can be scaled independently, up to millions of vertices.
+
+#pragma once
+#include "imgui.h"
+
+/** @brief Number of items of each kind in the whole scene, items are spread evenly over windows */
+struct SyntheticSceneDesc
+{
+    /** @brief Draw lists, each covers one cell of grid over display */
+    int     Windows;
+    /** @brief Characters of text */
+    int     Glyphs;
+    /** @brief Single color rectangles */
+    int     Rects;
+    /** @brief Rounded rectangles & circles */
+    int     RoundedShapes;
+    /** @brief Rectangles with two, three or four corner colors */
+    int     Gradients;
+    /** @brief Images with one of several texture ids */
+    int     Images;
+    /** @brief Clip rectangle changes, each one splits draw command */
+    int     ClipChanges;
+    /** @brief Seed of positions, sizes & colors, same description & seed give same scene */
+    unsigned int Seed;
+
+    SyntheticSceneDesc() { Windows = 1; Glyphs = Rects = RoundedShapes = Gradients = Images = ClipChanges = 0; Seed = 1; }
+};
+
+/** @brief Owns draw lists of generated scene */
+struct SyntheticScene
+{
+    ImVector<ImDrawList*> Lists;
+    ImDrawData DrawData;
+
+    ~SyntheticScene() { Clear(); }
+
+    /** @brief Generate scene, requires ImGui context with built font atlas & must be called outside of frame */
+    void    Build(const SyntheticSceneDesc& desc);
+    void    Clear();
+};
@@ -0,0 +1,72 @@
+// Minimal job system for imgui_impl_d2d benchmark, see thread_pool.h
+
+#include "thread_pool.h"
+
+void ThreadPool::Start(int threadCount) {
+    Stop();
+    m_Stop = false;
+    for (int i = 1; i < threadCount; i++) {
+        m_Workers.emplace_back(&ThreadPool::WorkerMain, this);
+    }
+}
+
+void ThreadPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_WorkReady.notify_all();
+    for (std::thread& worker : m_Workers) {
+        worker.join();
+    }
+    m_Workers.clear();
+}
+
+void ThreadPool::RunBatch(Batch* batch) {
+    for (int index = batch->Next.fetch_add(1); index < batch->Count; index = batch->Next.fetch_add(1)) {
+        batch->Job(index, batch->JobData);
+    }
+}
+
+void ThreadPool::WorkerMain() {
+    unsigned int generation = 0;
+    for (;;) {
+        Batch* batch = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_WorkReady.wait(lock, [&] { return m_Stop || (m_Batch != nullptr && m_Generation != generation); });
+            if (m_Stop) {
+                return;
+            }
+            generation = m_Generation;
+            batch = m_Batch;
+            m_ActiveWorkers++;
+        }
+        RunBatch(batch);
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_ActiveWorkers--;
+        }
+        m_WorkDone.notify_all();
+    }
+}
+
+void ThreadPool::ParallelFor(int count, void (*job)(int index, void* jobData), void* jobData, void* userData) {
+    ThreadPool* pool = (ThreadPool*)userData;
+    Batch batch;
+    batch.Job = job;
+    batch.JobData = jobData;
+    batch.Count = count;
+    batch.Next = 0;
+    {
+        std::lock_guard<std::mutex> lock(pool->m_Mutex);
+        pool->m_Batch = &batch;
+        pool->m_Generation++;
+    }
+    pool->m_WorkReady.notify_all();
+    RunBatch(&batch);
+    // all indices are taken once calling thread runs out of them, wait for workers still running theirs
+    std::unique_lock<std::mutex> lock(pool->m_Mutex);
+    pool->m_Batch = nullptr;
+    pool->m_WorkDone.wait(lock, [&] { return pool->m_ActiveWorkers == 0; });
+}
@@ -0,0 +1,51 @@
+// Minimal job system for imgui_impl_d2d benchmark
+//
+// Stands in for the application job system behind ImGui_ImplD2D_SetParallelFor(): fixed set of worker threads,
+// calling thread takes part in each parallel for & waits until all indices are done.
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    ThreadPool() : m_Batch(nullptr), m_Generation(0), m_ActiveWorkers(0), m_Stop(false) {}
+    ~ThreadPool() { Stop(); }
+
+    /** @brief Start @p threadCount - 1 workers, calling thread is the last one */
+    void    Start(int threadCount);
+    void    Stop();
+    int     GetThreadCount() const { return (int)m_Workers.size() + 1; }
+
+    /** @brief ImGui_ImplD2D_ParallelForFunc, @p userData is the pool */
+    static void ParallelFor(int count, void (*job)(int index, void* jobData), void* jobData, void* userData);
+
+private:
+    /** @brief One parallel for, lives on the stack of the calling thread */
+    struct Batch
+    {
+        void    (*Job)(int, void*);
+        void*   JobData;
+        int     Count;
+        std::atomic<int> Next;
+    };
+
+    void    WorkerMain();
+    /** @brief Run indices of @p batch until none is left */
+    static void RunBatch(Batch* batch);
+
+    std::vector<std::thread> m_Workers;
+    std::mutex  m_Mutex;
+    std::condition_variable m_WorkReady;
+    std::condition_variable m_WorkDone;
+    Batch*      m_Batch;
+    /** @brief Incremented for each parallel for, workers wake up when it changes */
+    unsigned int m_Generation;
+    /** @brief Workers running current batch, parallel for returns only when it drops to zero */
+    int         m_ActiveWorkers;
+    bool        m_Stop;
+};
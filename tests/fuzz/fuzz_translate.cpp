@@ -0,0 +1,199 @@
+// Fuzzing harness of draw list translation (polygon classification & glyph detection)
+//
+// Arbitrary bytes are turned into draw list with valid vertex references (as Dear ImGui guarantees) but otherwise
+// arbitrary indices, commands, colors & texture coordinates, which is translated & submitted to recording device.
+// Besides crashes (use with sanitizers) harness aborts when classification work exceeds linear bound, so
+// crafted index patterns cannot make frame time quadratic.
+//
+// Built as libFuzzer target with Clang. Other compilers get standalone main running files given on command line,
+// or random inputs with --random N, so corpus can be replayed anywhere.
+
+#include "imgui.h"
+#include "imgui_impl_d2d.h"
+#include "imgui_impl_d2d_internal.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/** @brief Consumes fuzzer input, returns zeros once input is exhausted */
+struct FuzzReader
+{
+    const uint8_t* Data;
+    size_t  Size;
+    size_t  Pos;
+
+    FuzzReader(const uint8_t* data, size_t size) { Data = data; Size = size; Pos = 0; }
+    unsigned int Byte() { return Pos < Size ? Data[Pos++] : 0u; }
+    unsigned int U16() { const unsigned int lo = Byte(); return lo | (Byte() << 8); }
+};
+
+static const ImTextureID FuzzFontTexID = (ImTextureID)(intptr_t)1;
+static const int FuzzFontCount = 2;
+static const int FuzzGlyphsPerFont = 96;
+static const ImVec2 FuzzWhitePixel(0.999f, 0.999f);
+
+/** @brief Font table with glyphs on regular grid of atlas, built once */
+static const ImGui_ImplD2D_FontTable& FuzzFonts() {
+    static ImGui_ImplD2D_FontTable fonts;
+    if (fonts.Glyphs.Size == 0) {
+        fonts.TexID = FuzzFontTexID;
+        fonts.Version = 1;
+        for (int f = 0; f < FuzzFontCount; f++) {
+            ImGui_ImplD2D_FontInfo info;
+            info.FontSize = 13.0f + f * 5.0f;
+            info.Scale = 1.0f;
+            info.Ascent = 10.0f + f * 4.0f;
+            info.GlyphOffset = fonts.Glyphs.Size;
+            info.GlyphCount = FuzzGlyphsPerFont;
+            fonts.Fonts.push_back(info);
+            for (int c = 0; c < FuzzGlyphsPerFont; c++) {
+                const int cell = f * FuzzGlyphsPerFont + c;
+                ImGui_ImplD2D_FontGlyph glyph;
+                glyph.Codepoint = 32 + c;
+                glyph.X0 = 0.0f;
+                glyph.Y0 = 1.0f;
+                glyph.U0 = (cell % 16) / 16.0f;
+                glyph.V0 = (cell / 16) / 16.0f;
+                glyph.U1 = glyph.U0 + 1.0f / 32.0f;
+                glyph.V1 = glyph.V0 + 1.0f / 32.0f;
+                fonts.Glyphs.push_back(glyph);
+            }
+        }
+        fonts.BuildLookup();
+    }
+    return fonts;
+}
+
+static void FuzzFail(const char* message, int value, int bound) {
+    fprintf(stderr, "FAILED: %s (%d, bound %d)\n", message, value, bound);
+    abort();
+}
+
+static void FuzzTranslate(const uint8_t* data, size_t size) {
+    const ImGui_ImplD2D_FontTable& fonts = FuzzFonts();
+    FuzzReader reader(data, size);
+    static const ImU32 colors[4] = { 0xFF0000FFu, 0xFF00FF00u, 0xFFFF0000u, 0x80FFFFFFu };
+
+    ImDrawList drawList(nullptr);
+    const int vtxCount = 1 + (int)(reader.U16() % 4096);
+    drawList.VtxBuffer.resize(vtxCount);
+    for (int v = 0; v < vtxCount; v++) {
+        ImDrawVert& vert = drawList.VtxBuffer[v];
+        const unsigned int kind = reader.Byte();
+        vert.pos = ImVec2((float)reader.Byte(), (float)reader.Byte());
+        vert.col = colors[kind & 3];
+        const int glyph = (int)(reader.Byte() % fonts.Glyphs.Size);
+        switch ((kind >> 2) & 3) {
+        case 0: vert.uv = ImVec2(fonts.Glyphs[glyph].U0, fonts.Glyphs[glyph].V0); break;
+        case 1: vert.uv = ImVec2(fonts.Glyphs[glyph].U1, fonts.Glyphs[glyph].V1); break;
+        default: vert.uv = FuzzWhitePixel; break;
+        }
+    }
+
+    const int cmdCount = 1 + (int)(reader.Byte() % 8);
+    int totalElemCount = 0;
+    for (int c = 0; c < cmdCount; c++) {
+        ImDrawCmd cmd;
+        const unsigned int flags = reader.Byte();
+        // element count is not always multiple of three, translation must not read past the command
+        cmd.ElemCount = reader.U16() % 8192;
+        cmd.IdxOffset = (unsigned int)drawList.IdxBuffer.Size;
+        cmd.VtxOffset = 0;
+        cmd.TextureId = (flags & 1) ? FuzzFontTexID : (ImTextureID)(intptr_t)2;
+        const float x = (float)reader.Byte(), y = (float)reader.Byte();
+        cmd.ClipRect = (flags & 2) ? ImVec4(x, y, x + reader.Byte(), y + reader.Byte()) : ImVec4(0, 0, 4096, 4096);
+        int base = 0;
+        for (unsigned int i = 0; i < cmd.ElemCount; i++) {
+            // small deltas from moving base produce long chains of triangles sharing indices
+            const unsigned int value = reader.U16();
+            if (flags & 4) {
+                base = (base + (int)(value >> 12)) % vtxCount;
+                drawList.IdxBuffer.push_back((ImDrawIdx)((base + (int)(value & 7)) % vtxCount));
+            }
+            else {
+                drawList.IdxBuffer.push_back((ImDrawIdx)(value % vtxCount));
+            }
+        }
+        totalElemCount += (int)cmd.ElemCount;
+        drawList.CmdBuffer.push_back(cmd);
+    }
+
+    ImGui_ImplD2D_TranslateParams params;
+    params.Fonts = &fonts;
+    params.FramebufferSize = ImVec2(4096, 4096);
+    ImGui_ImplD2D_FrameStats stats;
+    memset(&stats, 0, sizeof(stats));
+    ImGui_ImplD2D_CommandList commands;
+    ImGui_ImplD2D_TranslateDrawList(&drawList, params, &commands, &stats);
+    ImGui_ImplD2D_RecordingDevice device;
+    ImGui_ImplD2D_SubmitCommandList(commands, &device, &stats);
+
+    if (device.ClipDepth != 0) {
+        FuzzFail("unbalanced clip rectangles", device.ClipDepth, 0);
+    }
+    if (device.LiveObjects != 0) {
+        FuzzFail("leaked device objects", device.LiveObjects, 0);
+    }
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    // each triangle is scanned at most twice & each glyph (six indices) needs two lookups at most
+    const int workBound = totalElemCount + 4 * cmdCount;
+    if (stats.ClassifySteps > workBound) {
+        FuzzFail("classification work exceeds linear bound", stats.ClassifySteps, workBound);
+    }
+#endif
+    // every emitted triangle comes from indices of the draw list
+    if (commands.Points.Size > totalElemCount) {
+        FuzzFail("more points than indices", commands.Points.Size, totalElemCount);
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    FuzzTranslate(data, size);
+    return 0;
+}
+
+#ifdef IMGUI_IMPL_D2D_FUZZ_STANDALONE
+int main(int argc, char** argv) {
+    if (argc == 3 && strcmp(argv[1], "--random") == 0) {
+        const int runs = atoi(argv[2]);
+        unsigned int state = 1u;
+        ImVector<uint8_t> input;
+        for (int r = 0; r < runs; r++) {
+            input.resize(1 + (int)(state % 65536));
+            for (int i = 0; i < input.Size; i++) {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                input[i] = (uint8_t)state;
+            }
+            FuzzTranslate(input.Data, (size_t)input.Size);
+        }
+        printf("%d random inputs passed\n", runs);
+        return 0;
+    }
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <input files...> | --random N\n", argv[0]);
+        return 1;
+    }
+    for (int i = 1; i < argc; i++) {
+        FILE* file = fopen(argv[i], "rb");
+        if (file == nullptr) {
+            fprintf(stderr, "Cannot open %s\n", argv[i]);
+            return 1;
+        }
+        ImVector<uint8_t> input;
+        uint8_t buffer[4096];
+        size_t count = 0;
+        while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            for (size_t b = 0; b < count; b++) {
+                input.push_back(buffer[b]);
+            }
+        }
+        fclose(file);
+        FuzzTranslate(input.Data, (size_t)input.Size);
+    }
+    printf("%d inputs passed\n", argc - 1);
+    return 0;
+}
+#endif
@@ -0,0 +1,163 @@
+// Shelf packer of texture atlas pages (imgui_impl_d2d_atlas.cpp)
+
+#include "unit_test.h"
+#include "imgui_impl_d2d_internal.h"
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+static bool Overlap(const ImGui_ImplD2D_AtlasRect& a, const ImGui_ImplD2D_AtlasRect& b, int padding) {
+    return a.Page == b.Page && a.X - padding < b.X + b.Width && b.X - padding < a.X + a.Width &&
+        a.Y - padding < b.Y + b.Height && b.Y - padding < a.Y + a.Height;
+}
+
+UNIT_TEST(atlas_packer, disabled_until_init) {
+    ImGui_ImplD2D_AtlasPacker packer;
+    ImGui_ImplD2D_AtlasRect rect;
+    UNIT_CHECK(!packer.IsEnabled());
+    UNIT_CHECK(!packer.CanPack(16, 16));
+    UNIT_CHECK(!packer.Pack(16, 16, &rect));
+    UNIT_CHECK(packer.GetPageCount() == 0);
+}
+
+UNIT_TEST(atlas_packer, rejects_large_and_empty_images) {
+    ImGui_ImplD2D_AtlasPacker packer;
+    packer.Init(256, 64, 1);
+    UNIT_CHECK(packer.CanPack(64, 64));
+    UNIT_CHECK(!packer.CanPack(65, 8));
+    UNIT_CHECK(!packer.CanPack(8, 65));
+    UNIT_CHECK(!packer.CanPack(0, 8));
+    // padding must fit the page too
+    packer.Init(64, 64, 1);
+    UNIT_CHECK(!packer.CanPack(64, 8));
+    UNIT_CHECK(packer.CanPack(62, 62));
+}
+
+UNIT_TEST(atlas_packer, random_images_do_not_overlap) {
+    static const int padding = 2;
+    ImGui_ImplD2D_AtlasPacker packer;
+    packer.Init(256, 64, padding);
+    UnitRandom random(23);
+    ImVector<ImGui_ImplD2D_AtlasRect> rects;
+    for (int n = 0; n < 400; n++) {
+        const int width = 1 + random.Index(64);
+        const int height = 1 + random.Index(64);
+        const int pages = packer.GetPageCount();
+        ImGui_ImplD2D_AtlasRect rect;
+        UNIT_REQUIRE(packer.Pack(width, height, &rect));
+        UNIT_CHECK(rect.Width == width && rect.Height == height);
+        UNIT_CHECK(rect.Page >= 0 && rect.Page <= pages && packer.GetPageCount() == (rect.Page == pages ? pages + 1 : pages));
+        UNIT_CHECK(rect.X >= padding && rect.Y >= padding && rect.X + width + padding <= 256 && rect.Y + height + padding <= 256);
+        UNIT_CHECK(rect.Uv0.x == rect.X / 256.0f && rect.Uv0.y == rect.Y / 256.0f);
+        UNIT_CHECK(rect.Uv1.x == (rect.X + width) / 256.0f && rect.Uv1.y == (rect.Y + height) / 256.0f);
+        for (const ImGui_ImplD2D_AtlasRect& other : rects) {
+            UNIT_CHECK(!Overlap(rect, other, padding));
+        }
+        rects.push_back(rect);
+    }
+    UNIT_CHECK(packer.GetPageCount() > 1);
+}
+
+UNIT_TEST(atlas_packer, remap_uv_to_page) {
+    ImGui_ImplD2D_AtlasPacker packer;
+    packer.Init(128, 64, 1);
+    ImGui_ImplD2D_AtlasRect rect;
+    UNIT_REQUIRE(packer.Pack(32, 16, &rect));
+    const ImVec2 uv0 = ImGui_ImplD2D_AtlasRemapUV(rect, ImVec2(0, 0));
+    const ImVec2 uv1 = ImGui_ImplD2D_AtlasRemapUV(rect, ImVec2(1, 1));
+    const ImVec2 mid = ImGui_ImplD2D_AtlasRemapUV(rect, ImVec2(0.5f, 0.5f));
+    UNIT_CHECK(uv0.x == rect.Uv0.x && uv0.y == rect.Uv0.y && uv1.x == rect.Uv1.x && uv1.y == rect.Uv1.y);
+    UNIT_CHECK(mid.x == (rect.X + 16) / 128.0f && mid.y == (rect.Y + 8) / 128.0f);
+}
+
+UNIT_TEST(atlas_packer, clear_starts_over) {
+    ImGui_ImplD2D_AtlasPacker packer;
+    packer.Init(64, 32, 0);
+    ImGui_ImplD2D_AtlasRect first, rect;
+    UNIT_REQUIRE(packer.Pack(32, 32, &first));
+    for (int n = 0; n < 8; n++) {
+        UNIT_REQUIRE(packer.Pack(32, 32, &rect));
+    }
+    UNIT_CHECK(packer.GetPageCount() == 3);
+    packer.Clear();
+    UNIT_CHECK(packer.GetPageCount() == 0);
+    UNIT_REQUIRE(packer.Pack(32, 32, &rect));
+    UNIT_CHECK(rect.Page == 0 && rect.X == first.X && rect.Y == first.Y);
+}
+
+UNIT_TEST(atlas_packer, icons_share_shelves) {
+    ImGui_ImplD2D_AtlasPacker packer;
+    packer.Init(256, 64, 1);
+    ImGui_ImplD2D_AtlasRect rect;
+    for (int n = 0; n < 8; n++) {
+        UNIT_REQUIRE(packer.Pack(16, 16, &rect));
+        UNIT_CHECK(rect.Page == 0 && rect.X == 1 + n * 18 && rect.Y == 1);
+    }
+    // smaller icon wastes at most half of shelf height, so it goes next to the others
+    UNIT_REQUIRE(packer.Pack(8, 8, &rect));
+    UNIT_CHECK(rect.X == 1 + 8 * 18 && rect.Y == 1);
+    // much smaller one opens shelf of its own below
+    UNIT_REQUIRE(packer.Pack(4, 4, &rect));
+    UNIT_CHECK(rect.X == 1 && rect.Y == 19);
+    UNIT_CHECK(packer.Shelves.size() == 2 && packer.GetPageCount() == 1);
+}
+
+UNIT_TEST(atlas_packer, new_shelf_on_first_page_with_room) {
+    ImGui_ImplD2D_AtlasPacker packer;
+    packer.Init(256, 256, 1);
+    ImGui_ImplD2D_AtlasRect rect;
+    // three shelves of 66 rows fill first page up to row 198, fourth needs new page
+    for (int n = 0; n < 4; n++) {
+        UNIT_REQUIRE(packer.Pack(200, 64, &rect));
+        UNIT_CHECK(rect.Page == n / 3 && rect.Y == 1 + (n % 3) * 66);
+    }
+    UNIT_CHECK(packer.GetPageCount() == 2);
+    UNIT_REQUIRE(packer.Pack(16, 16, &rect));
+    UNIT_CHECK(rect.Page == 0 && rect.X == 1 && rect.Y == 199);
+}
+
+/** @brief ImGui allocations made on threads other than the one running test */
+static std::atomic<int> g_LoaderAllocations(0);
+static std::thread::id g_TestThread;
+
+static void* LoaderCountingAlloc(size_t size, void* userData) {
+    IM_UNUSED(userData);
+    if (std::this_thread::get_id() != g_TestThread) {
+        g_LoaderAllocations++;
+    }
+    return malloc(size);
+}
+
+static void LoaderCountingFree(void* ptr, void* userData) {
+    IM_UNUSED(userData);
+    free(ptr);
+}
+
+/** @brief Textures are packed & their files mapped on loading threads while UI thread allocates through ImGui */
+UNIT_TEST(atlas_packer, loader_thread_does_not_use_imgui_allocator) {
+    ImGuiMemAllocFunc allocFunc = nullptr;
+    ImGuiMemFreeFunc freeFunc = nullptr;
+    void* allocUserData = nullptr;
+    ImGui::GetAllocatorFunctions(&allocFunc, &freeFunc, &allocUserData);
+    g_TestThread = std::this_thread::get_id();
+    g_LoaderAllocations = 0;
+    ImGui::SetAllocatorFunctions(LoaderCountingAlloc, LoaderCountingFree, nullptr);
+    ImGui_ImplD2D_AtlasPacker packer;
+    packer.Init(128, 64, 1);
+    int packed = 0;
+    bool mapped = false;
+    std::thread loader([&] {
+        // several pages & shelves of each height, so packer grows all of its vectors
+        ImGui_ImplD2D_AtlasRect rect;
+        for (int n = 0; n < 64; n++) {
+            packed += packer.Pack(8 + (n % 4) * 14, 8 + (n % 5) * 12, &rect) ? 1 : 0;
+        }
+        ImGui_ImplD2D_MappedFile file;
+        mapped = file.Open(UNIT_SOURCE_DIR "/test_atlas_packer.cpp");
+    });
+    loader.join();
+    ImGui::SetAllocatorFunctions(allocFunc, freeFunc, allocUserData);
+    UNIT_CHECK(packed == 64 && packer.GetPageCount() > 1);
+    UNIT_CHECK(mapped);
+    UNIT_CHECK(g_LoaderAllocations == 0);
+}
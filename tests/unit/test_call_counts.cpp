@@ -0,0 +1,165 @@
+// Direct2D calls per frame of fixed scenes against budgets of call_counts.baseline (imgui_impl_d2d_draw.cpp)
+//
+// Scenes are raw draw lists, so counts depend only on the backend. Any count above its budget fails, as does scene
+// without budgets. After intended changes baseline is rewritten with: imgui_impl_d2d_unit_tests call_counts --update-baseline
+
+#include "unit_test.h"
+#include "unit_scene.h"
+#include <cstdio>
+#include <cstring>
+
+#ifndef UNIT_SOURCE_DIR
+#define UNIT_SOURCE_DIR "."
+#endif
+
+static const char* const g_BaselineFilename = UNIT_SOURCE_DIR "/call_counts.baseline";
+
+/** @brief Budget of calls of one type in one scene */
+struct BaselineEntry
+{
+    char Scene[32];
+    char Call[32];
+    int Count;
+};
+
+struct CallCountScene
+{
+    const char* Name;
+    UnitSceneDesc Desc;
+};
+
+static ImVector<CallCountScene> GetCallCountScenes() {
+    ImVector<CallCountScene> scenes;
+    CallCountScene scene;
+    scene.Name = "grid_windows";
+    scene.Desc.Windows = 9;
+    scene.Desc.Items = 30;
+    scenes.push_back(scene);
+    scene = CallCountScene();
+    scene.Name = "stacked_windows";
+    scene.Desc.Windows = 8;
+    scene.Desc.Items = 40;
+    scene.Desc.Stacked = true;
+    scene.Desc.Seed = 7;
+    scenes.push_back(scene);
+    scene = CallCountScene();
+    scene.Name = "transparent_windows";
+    scene.Desc.Windows = 8;
+    scene.Desc.Stacked = true;
+    scene.Desc.Opaque = false;
+    scenes.push_back(scene);
+    scene = CallCountScene();
+    scene.Name = "scrolled_windows";
+    scene.Desc.Windows = 6;
+    scene.Desc.Items = 60;
+    scene.Desc.Scroll = 100.0f;
+    scene.Desc.Seed = 3;
+    scenes.push_back(scene);
+    scene = CallCountScene();
+    scene.Name = "frame_counter";
+    scene.Desc.Counter = 1234;
+    scenes.push_back(scene);
+    return scenes;
+}
+
+/** @brief Read baseline file, lines are `<scene> <call> <count>`, lines starting with '#' are comments */
+static bool LoadBaseline(const char* filename, ImVector<BaselineEntry>* out) {
+    FILE* file = fopen(filename, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        BaselineEntry entry;
+        if (line[0] == '#' || sscanf(line, "%31s %31s %d", entry.Scene, entry.Call, &entry.Count) != 3) {
+            continue;
+        }
+        out->push_back(entry);
+    }
+    fclose(file);
+    return true;
+}
+
+static const BaselineEntry* FindBaseline(const ImVector<BaselineEntry>& baseline, const char* scene, const char* call) {
+    for (const BaselineEntry& entry : baseline) {
+        if (strcmp(entry.Scene, scene) == 0 && strcmp(entry.Call, call) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+/** @brief Compare calls of scene against baseline, returns number of failures
+
+    Call types missing in baseline have zero budget, scene missing in baseline is a failure.
+ */
+static int CheckBaseline(const ImVector<BaselineEntry>& baseline, const char* scene, const int* calls) {
+    bool found = false;
+    for (const BaselineEntry& entry : baseline) {
+        found = found || strcmp(entry.Scene, scene) == 0;
+    }
+    if (!found) {
+        fprintf(stderr, "%s: no baseline, run with --update-baseline\n", scene);
+        return 1;
+    }
+    int failures = 0;
+    for (int c = 0; c < ImGui_ImplD2D_RecordingDevice::Call_COUNT; c++) {
+        const char* call = ImGui_ImplD2D_RecordingDevice::GetCallName(c);
+        const BaselineEntry* entry = FindBaseline(baseline, scene, call);
+        const int budget = entry != nullptr ? entry->Count : 0;
+        if (calls[c] > budget) {
+            fprintf(stderr, "%s: %s called %d times, baseline budget is %d\n", scene, call, calls[c], budget);
+            failures++;
+        }
+        else if (calls[c] < budget) {
+            printf("note: %s: %s called %d times, below baseline budget %d (update baseline to lock it in)\n", scene, call, calls[c], budget);
+        }
+    }
+    return failures;
+}
+
+static void WriteBaseline(FILE* file, const char* scene, const int* calls) {
+    for (int c = 0; c < ImGui_ImplD2D_RecordingDevice::Call_COUNT; c++) {
+        if (calls[c] != 0) {
+            fprintf(file, "%s %s %d\n", scene, ImGui_ImplD2D_RecordingDevice::GetCallName(c), calls[c]);
+        }
+    }
+}
+
+UNIT_TEST(call_counts, scenes_within_baseline) {
+    ImVector<BaselineEntry> baseline;
+    FILE* baselineFile = nullptr;
+    if (g_UnitUpdateBaseline) {
+        baselineFile = fopen(g_BaselineFilename, "w");
+        UNIT_REQUIRE(baselineFile != nullptr);
+        fprintf(baselineFile, "# Direct2D calls per frame budget: <scene> <call> <count>\n");
+        fprintf(baselineFile, "# Generated by imgui_impl_d2d_unit_tests call_counts --update-baseline\n");
+    }
+    else {
+        UNIT_REQUIRE(LoadBaseline(g_BaselineFilename, &baseline));
+        // budgets must exist, otherwise nothing would be checked
+        UNIT_REQUIRE(baseline.Size > 0);
+    }
+    for (const CallCountScene& desc : GetCallCountScenes()) {
+        UnitScene scene;
+        scene.Build(desc.Desc);
+        ImGui_ImplD2D_FrameCommands commands;
+        ImGui_ImplD2D_RecordingDevice device;
+        ImGui_ImplD2D_FrameStats stats;
+        memset(&stats, 0, sizeof(stats));
+        commands.Translate(&scene.DrawData, UnitParams(), nullptr, nullptr, &stats);
+        for (int n = 0; n < commands.Count; n++) {
+            ImGui_ImplD2D_SubmitCommandList(*commands.Lists[n], &device, &stats);
+        }
+        UNIT_CHECK(device.GetTotalCalls() > 0);
+        if (baselineFile != nullptr) {
+            WriteBaseline(baselineFile, desc.Name, device.Calls);
+        }
+        else {
+            UNIT_CHECK(CheckBaseline(baseline, desc.Name, device.Calls) == 0);
+        }
+    }
+    if (baselineFile != nullptr) {
+        fclose(baselineFile);
+    }
+}
@@ -0,0 +1,181 @@
+// Draw data capture writer & reader (imgui_impl_d2d_capture.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+#include <cstdio>
+#include <cstring>
+
+static const char* g_CaptureFilename = "imgui_impl_d2d_unit_capture.tmp";
+static const char* g_CorruptFilename = "imgui_impl_d2d_unit_capture_corrupt.tmp";
+
+// Offsets in first frame of file, see file layout in imgui_impl_d2d_capture.cpp
+static const int CaptureFontCountOffset = 64;
+static const int CaptureGlyphCountOffset = 68;
+static const int CaptureFontsOffset = 72;
+
+static bool WriteCapture(const char* filename, const ImDrawData* const* frames, int frameCount) {
+    ImGui_ImplD2D_CaptureWriter writer;
+    if (!writer.Open(filename)) {
+        return false;
+    }
+    bool success = true;
+    for (int n = 0; n < frameCount; n++) {
+        success = success && writer.WriteFrame(frames[n], UnitFonts(), 1.0f, UnitDisplaySize);
+    }
+    return success && writer.FrameCount == frameCount;
+}
+
+static bool ReadFile(const char* filename, ImVector<char>* out) {
+    FILE* file = fopen(filename, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    out->resize(0);
+    char buffer[4096];
+    size_t read = 0;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        const int size = out->Size;
+        out->resize(size + (int)read);
+        memcpy(out->Data + size, buffer, read);
+    }
+    fclose(file);
+    return true;
+}
+
+static bool WriteFile(const char* filename, const char* data, int size) {
+    FILE* file = fopen(filename, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    const bool success = size == 0 || fwrite(data, (size_t)size, 1, file) == 1;
+    fclose(file);
+    return success;
+}
+
+/** @brief Draw data equal in everything capture stores, list flags & user callbacks are not stored */
+static bool EqualCapturedDrawData(const ImDrawData* read, const ImDrawData* written) {
+    if (read->CmdListsCount != written->CmdListsCount || read->TotalVtxCount != written->TotalVtxCount || read->TotalIdxCount != written->TotalIdxCount ||
+        memcmp(&read->DisplayPos, &written->DisplayPos, sizeof(ImVec2)) != 0 || memcmp(&read->DisplaySize, &written->DisplaySize, sizeof(ImVec2)) != 0 ||
+        memcmp(&read->FramebufferScale, &written->FramebufferScale, sizeof(ImVec2)) != 0) {
+        return false;
+    }
+    for (int n = 0; n < read->CmdListsCount; n++) {
+        const ImDrawList* listA = read->CmdLists[n];
+        const ImDrawList* listB = written->CmdLists[n];
+        if (listA->VtxBuffer.Size != listB->VtxBuffer.Size || listA->IdxBuffer.Size != listB->IdxBuffer.Size || listA->CmdBuffer.Size != listB->CmdBuffer.Size ||
+            memcmp(listA->VtxBuffer.Data, listB->VtxBuffer.Data, (size_t)listA->VtxBuffer.size_in_bytes()) != 0 ||
+            memcmp(listA->IdxBuffer.Data, listB->IdxBuffer.Data, (size_t)listA->IdxBuffer.size_in_bytes()) != 0) {
+            return false;
+        }
+        for (int cmd_i = 0; cmd_i < listA->CmdBuffer.Size; cmd_i++) {
+            const ImDrawCmd& cmdA = listA->CmdBuffer[cmd_i];
+            const ImDrawCmd& cmdB = listB->CmdBuffer[cmd_i];
+            if (memcmp(&cmdA.ClipRect, &cmdB.ClipRect, sizeof(ImVec4)) != 0 || cmdA.GetTexID() != cmdB.GetTexID() ||
+                cmdA.VtxOffset != cmdB.VtxOffset || cmdA.IdxOffset != cmdB.IdxOffset || cmdA.ElemCount != cmdB.ElemCount) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/** @brief Whether reader accepts first frame of @p original with u32 at @p offset replaced by @p value */
+static bool ReadPatchedFrame(const ImVector<char>& original, int offset, ImU32 value) {
+    ImVector<char> data = original;
+    memcpy(data.Data + offset, &value, sizeof(value));
+    if (!WriteFile(g_CorruptFilename, data.Data, data.Size)) {
+        // unknown, treated as accepted so checks of corrupted frames fail
+        return true;
+    }
+    ImGui_ImplD2D_CaptureReader reader;
+    return reader.Open(g_CorruptFilename) && reader.ReadFrame();
+}
+
+UNIT_TEST(capture, round_trip) {
+    UnitSceneDesc desc;
+    desc.Windows = 5;
+    desc.Items = 30;
+    UnitScene first;
+    first.Build(desc);
+    desc.Scroll = 12.0f;
+    desc.Counter = 3;
+    UnitScene second;
+    second.Build(desc);
+    const ImDrawData* frames[] = { &first.DrawData, &second.DrawData };
+    UNIT_REQUIRE(WriteCapture(g_CaptureFilename, frames, 2));
+
+    ImGui_ImplD2D_CaptureReader reader;
+    UNIT_REQUIRE(reader.Open(g_CaptureFilename));
+    for (int pass = 0; pass < 2; pass++) {
+        for (int n = 0; n < 2; n++) {
+            UNIT_REQUIRE(reader.ReadFrame());
+            UNIT_CHECK(reader.DrawData.Valid && EqualCapturedDrawData(&reader.DrawData, frames[n]));
+            // font table is stored with first frame only & kept by reader
+            const ImGui_ImplD2D_FontTable& fonts = UnitFonts();
+            UNIT_CHECK(reader.Fonts.TexID == fonts.TexID && reader.Fonts.Fonts.Size == fonts.Fonts.Size && reader.Fonts.Glyphs.Size == fonts.Glyphs.Size);
+            UNIT_CHECK(memcmp(reader.Fonts.Glyphs.Data, fonts.Glyphs.Data, (size_t)fonts.Glyphs.size_in_bytes()) == 0);
+            UNIT_CHECK(reader.FramebufferSize.x == UnitDisplaySize.x && reader.FramebufferSize.y == UnitDisplaySize.y);
+        }
+        UNIT_CHECK(!reader.ReadFrame());
+        UNIT_CHECK(reader.FrameCount == 2);
+        UNIT_REQUIRE(reader.Rewind());
+    }
+    reader.Close();
+    remove(g_CaptureFilename);
+}
+
+UNIT_TEST(capture, truncated_file) {
+    UnitSceneDesc desc;
+    desc.Windows = 2;
+    desc.Items = 8;
+    UnitScene scene;
+    scene.Build(desc);
+    const ImDrawData* frames[] = { &scene.DrawData };
+    UNIT_REQUIRE(WriteCapture(g_CaptureFilename, frames, 1));
+    ImVector<char> data;
+    UNIT_REQUIRE(ReadFile(g_CaptureFilename, &data) && data.Size > CaptureFontsOffset);
+    // every cut inside of the header & font table, then coarser steps through draw lists
+    for (int size = 0; size < data.Size; size += size < CaptureFontsOffset + 64 ? 1 : 97) {
+        UNIT_REQUIRE(WriteFile(g_CorruptFilename, data.Data, size));
+        ImGui_ImplD2D_CaptureReader reader;
+        UNIT_REQUIRE(reader.Open(g_CorruptFilename));
+        UNIT_CHECK(!reader.ReadFrame());
+        UNIT_CHECK(!reader.DrawData.Valid && reader.DrawData.CmdListsCount == 0 && reader.FrameCount == 0);
+    }
+    remove(g_CaptureFilename);
+    remove(g_CorruptFilename);
+}
+
+UNIT_TEST(capture, corrupt_counts) {
+    UnitSceneDesc desc;
+    desc.Windows = 2;
+    desc.Items = 8;
+    UnitScene scene;
+    scene.Build(desc);
+    const ImDrawData* frames[] = { &scene.DrawData };
+    UNIT_REQUIRE(WriteCapture(g_CaptureFilename, frames, 1));
+    ImVector<char> data;
+    UNIT_REQUIRE(ReadFile(g_CaptureFilename, &data));
+    const ImGui_ImplD2D_FontTable& fonts = UnitFonts();
+    const int listCountOffset = CaptureFontsOffset + fonts.Fonts.Size * 16 + fonts.Glyphs.Size * 28;
+    UNIT_REQUIRE(listCountOffset + 16 <= data.Size);
+    ImU32 listCount = 0;
+    memcpy(&listCount, data.Data + listCountOffset, sizeof(listCount));
+    UNIT_REQUIRE(listCount == (ImU32)scene.DrawData.CmdListsCount);
+    // offsets are right when unchanged value is accepted
+    UNIT_CHECK(ReadPatchedFrame(data, listCountOffset, listCount));
+
+    // negative as int, larger than ImVector can hold, larger than rest of file
+    const ImU32 counts[] = { 0xFFFFFFFFu, 0x80000000u, 0x7FFFFFFFu, 0x00100000u };
+    const int offsets[] = { CaptureFontCountOffset, CaptureGlyphCountOffset, listCountOffset, listCountOffset + 4, listCountOffset + 8, listCountOffset + 12 };
+    for (int o = 0; o < IM_ARRAYSIZE(offsets); o++) {
+        for (int c = 0; c < IM_ARRAYSIZE(counts); c++) {
+            UNIT_CHECK(!ReadPatchedFrame(data, offsets[o], counts[c]));
+        }
+    }
+    // glyph count of one font beyond glyphs of the table
+    UNIT_CHECK(!ReadPatchedFrame(data, CaptureFontsOffset + 12, (ImU32)fonts.Glyphs.Size + 1));
+    UNIT_CHECK(!ReadPatchedFrame(data, CaptureFontsOffset + 12, 0xFFFFFFFFu));
+    remove(g_CaptureFilename);
+    remove(g_CorruptFilename);
+}
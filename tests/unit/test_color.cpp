@@ -0,0 +1,26 @@
+// Conversion of vertex colors (imgui_impl_d2d_color.cpp)
+
+#include "unit_test.h"
+#include "imgui_impl_d2d_internal.h"
+
+/** @brief Every value of every channel, with the other channels set to a different value, converts to value / 255 */
+UNIT_TEST(color, every_channel_value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        for (ImU32 value = 0; value < 256; value++) {
+            const ImU32 others = (255 - value) * 0x01010101u & ~(0xFFu << shift);
+            const ImGui_ImplD2D_ColorF col = ImGui_ImplD2D_ConvertColor(others | (value << shift));
+            const float expected[4] = {
+                (float)((shift == IM_COL32_R_SHIFT ? value : 255 - value)) / 255.0f,
+                (float)((shift == IM_COL32_G_SHIFT ? value : 255 - value)) / 255.0f,
+                (float)((shift == IM_COL32_B_SHIFT ? value : 255 - value)) / 255.0f,
+                (float)((shift == IM_COL32_A_SHIFT ? value : 255 - value)) / 255.0f };
+            UNIT_CHECK(col.r == expected[0] && col.g == expected[1] && col.b == expected[2] && col.a == expected[3]);
+        }
+    }
+}
+
+UNIT_TEST(color, single_color) {
+    const ImGui_ImplD2D_ColorF col = ImGui_ImplD2D_ConvertColor(IM_COL32(255, 0, 51, 255));
+    UNIT_CHECK(col.r == 1.0f && col.g == 0.0f && col.a == 1.0f);
+    UNIT_CHECK(col.b > 0.19f && col.b < 0.21f);
+}
@@ -0,0 +1,44 @@
+// Self-contained command buffer built off the UI thread (imgui_impl_d2d_draw.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+#include "unit_device.h"
+#include <thread>
+
+/** @brief Build command buffer on worker thread, submit it on two threads at once & compare call streams with direct translation */
+UNIT_TEST(command_buffer, replay_matches_direct_translation) {
+    const ImGui_ImplD2D_TranslateParams params = UnitParams();
+    UnitSceneDesc desc;
+    desc.Windows = 6;
+    UnitScene scene;
+    ImGui_ImplD2D_CommandBuffer buffer;
+    ImGui_ImplD2D_FrameCommands direct;
+    for (int frame = 0; frame < 4; frame++) {
+        desc.Counter = frame;
+        scene.Build(desc);
+        ImGui_ImplD2D_FrameStats stats;
+        memset(&stats, 0, sizeof(stats));
+        StreamDevice reference;
+        direct.Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+        for (int n = 0; n < direct.Count; n++) {
+            ImGui_ImplD2D_SubmitCommandList(*direct.Lists[n], &reference, &stats);
+        }
+        std::thread builder([&] { buffer.Build(&scene.DrawData, params, nullptr, nullptr); });
+        builder.join();
+        // buffer is only read by submission, each thread has its own device & statistics
+        StreamDevice devices[2];
+        ImGui_ImplD2D_FrameStats replayStats[2];
+        memset(replayStats, 0, sizeof(replayStats));
+        std::thread replay([&] { buffer.Submit(&devices[1], &replayStats[1]); });
+        buffer.Submit(&devices[0], &replayStats[0]);
+        replay.join();
+        for (const StreamDevice& device : devices) {
+            UNIT_CHECK(reference.Stream.Size > 0 && device.EqualStream(reference));
+            UNIT_CHECK(device.LiveObjects == 0 && device.ClipDepth == 0);
+        }
+        UNIT_REQUIRE(buffer.Frame.Count == direct.Count);
+        for (int n = 0; n < direct.Count; n++) {
+            UNIT_CHECK(UnitEqualCommandLists(*buffer.Frame.Lists[n], *direct.Lists[n]));
+        }
+    }
+}
@@ -0,0 +1,96 @@
+// Culling of primitives outside of clip rectangle during translation (imgui_impl_d2d_draw.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+#include "unit_device.h"
+
+static bool EqualRects(const ImVec4& a, const ImVec4& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+}
+
+/** @brief Draws of culled translation must be draws of full translation in the same order, with the same clip or none
+    when inside of it, dropped draws must not reach into their clip */
+static bool CheckCulledDraws(const ImVector<CullCheckDraw>& reference, const ImVector<CullCheckDraw>& culled) {
+    int c = 0;
+    for (const CullCheckDraw& draw : reference) {
+        if (c < culled.Size && EqualRects(culled[c].Bounds, draw.Bounds)) {
+            const CullCheckDraw& kept = culled[c++];
+            const bool inside = draw.Bounds.x >= draw.Clip.x && draw.Bounds.y >= draw.Clip.y && draw.Bounds.z <= draw.Clip.z && draw.Bounds.w <= draw.Clip.w;
+            if (kept.Clipped ? !(draw.Clipped && EqualRects(kept.Clip, draw.Clip)) : (draw.Clipped && !inside)) {
+                return false;
+            }
+        }
+        else if (!draw.Clipped || (draw.Bounds.z > draw.Clip.x && draw.Bounds.w > draw.Clip.y && draw.Bounds.x < draw.Clip.z && draw.Bounds.y < draw.Clip.w)) {
+            return false;
+        }
+    }
+    return c == culled.Size;
+}
+
+/** @brief Translate & submit scrolled frames with & without culling, draws must match & some must be culled */
+static void CheckCulling(UnitSceneDesc desc, int frames, int* culled) {
+    ImGui_ImplD2D_FrameCommands commands[2];
+    CullCheckDevice devices[2];
+    UnitScene scene;
+    for (int frame = 0; frame < frames; frame++) {
+        desc.Scroll = (float)(frame * 37);
+        scene.Build(desc);
+        for (int culling = 0; culling < 2; culling++) {
+            const ImGui_ImplD2D_TranslateParams params = UnitParams(culling ? ImGui_ImplD2D_TranslateFeatures_All : ImGui_ImplD2D_TranslateFeatures_All & ~ImGui_ImplD2D_TranslateFeatures_Cull);
+            CullCheckDevice& device = devices[culling];
+            device.Reset();
+            device.Draws.resize(0);
+            device.ClearFills();
+            ImGui_ImplD2D_FrameStats stats;
+            memset(&stats, 0, sizeof(stats));
+            commands[culling].Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+            for (int n = 0; n < commands[culling].Count; n++) {
+                ImGui_ImplD2D_SubmitCommandList(*commands[culling].Lists[n], &device, &stats);
+            }
+            *culled += culling ? stats.PrimitivesCulled : 0;
+        }
+        UNIT_CHECK(CheckCulledDraws(devices[0].Draws, devices[1].Draws));
+        UNIT_CHECK(devices[1].ClipDepth == 0 && devices[1].LiveObjects == 0);
+    }
+}
+
+UNIT_TEST(culling, scrolled_windows_draw_same_primitives) {
+    UnitSceneDesc desc;
+    desc.Windows = 6;
+    desc.Items = 60;
+    int culled = 0;
+    CheckCulling(desc, 8, &culled);
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    // content is taller than windows, rows below & above are outside of content clip
+    UNIT_CHECK(culled > 0);
+#endif
+}
+
+UNIT_TEST(culling, stacked_windows_draw_same_primitives) {
+    UnitSceneDesc desc;
+    desc.Windows = 8;
+    desc.Stacked = true;
+    desc.Seed = 3;
+    int culled = 0;
+    CheckCulling(desc, 4, &culled);
+}
+
+UNIT_TEST(culling, primitive_outside_of_clip_is_dropped) {
+    UnitScene scene;
+    UnitDrawList list(scene.AddList("Clipped"));
+    list.SetClip(ImVec4(100, 100, 200, 200));
+    list.AddRect(ImVec2(120, 120), ImVec2(180, 180), IM_COL32(255, 0, 0, 255));
+    list.AddRect(ImVec2(300, 300), ImVec2(400, 400), IM_COL32(0, 255, 0, 255));
+    list.AddText(0, ImVec2(120, 250), IM_COL32_WHITE, "hidden");
+    list.AddImage((ImTextureID)(intptr_t)2, ImVec2(250, 100), ImVec2(300, 150), ImVec2(0, 0), ImVec2(1, 1), IM_COL32_WHITE);
+    scene.Finish();
+
+    ImGui_ImplD2D_CommandList commands;
+    ImGui_ImplD2D_FrameStats stats;
+    memset(&stats, 0, sizeof(stats));
+    ImGui_ImplD2D_TranslateDrawList(scene.Lists[0], UnitParams(), &commands, &stats);
+    CullCheckDevice device;
+    ImGui_ImplD2D_SubmitCommandList(commands, &device, &stats);
+    UNIT_REQUIRE(device.Draws.Size == 1);
+    UNIT_CHECK(EqualRects(device.Draws[0].Bounds, ImVec4(120, 120, 180, 180)));
+}
@@ -0,0 +1,155 @@
+// Dirty rectangles between frames (imgui_impl_d2d_dirty.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+
+/** @brief Draw command is drawn identically in both frames: same clip, texture & referenced vertices */
+static bool EqualDrawCmds(const ImDrawList* a, const ImDrawCmd& cmdA, const ImDrawList* b, const ImDrawCmd& cmdB) {
+    if (cmdA.ElemCount != cmdB.ElemCount || cmdA.TextureId != cmdB.TextureId || cmdA.UserCallback != nullptr || cmdB.UserCallback != nullptr ||
+        memcmp(&cmdA.ClipRect, &cmdB.ClipRect, sizeof(cmdA.ClipRect)) != 0) {
+        return false;
+    }
+    for (unsigned int i = 0; i < cmdA.ElemCount; i++) {
+        const ImDrawVert& vtxA = a->VtxBuffer[cmdA.VtxOffset + a->IdxBuffer[cmdA.IdxOffset + i]];
+        const ImDrawVert& vtxB = b->VtxBuffer[cmdB.VtxOffset + b->IdxBuffer[cmdB.IdxOffset + i]];
+        if (memcmp(&vtxA, &vtxB, sizeof(ImDrawVert)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** @brief Framebuffer area command can draw, computed apart from ImGui_ImplD2D_GetDrawCmdRect()
+
+    Text is drawn by DirectWrite, whose outlines reach past atlas quads by at most font size, so bounds of commands
+    drawn with font atlas are grown by size of largest font of @see UnitFonts. Returns false when area is empty.
+ */
+static bool UnitDrawnBounds(const ImDrawList* drawList, const ImDrawCmd& cmd, ImVec4* out) {
+    // framebuffer of unit scenes, clip rectangles are already inside
+    ImVec4 area(0.0f, 0.0f, UnitDisplaySize.x, UnitDisplaySize.y);
+    const ImVec4& clip = cmd.ClipRect;
+    area = ImVec4(clip.x > area.x ? clip.x : area.x, clip.y > area.y ? clip.y : area.y, clip.z < area.z ? clip.z : area.z, clip.w < area.w ? clip.w : area.w);
+    ImVec4 bounds = area;
+    if (cmd.UserCallback == nullptr) {
+        ImVector<ImVec2> points;
+        for (unsigned int i = 0; i < cmd.ElemCount; i++) {
+            points.push_back(drawList->VtxBuffer[cmd.VtxOffset + drawList->IdxBuffer[cmd.IdxOffset + i]].pos);
+        }
+        ImGui_ImplD2D_GetPointsBoundsScalar(points.Data, points.Size, &bounds);
+        float margin = 0.0f;
+        for (const ImGui_ImplD2D_FontInfo& font : UnitFonts().Fonts) {
+            margin = cmd.TextureId == UnitFontTexID && font.FontSize > margin ? font.FontSize : margin;
+        }
+        bounds = ImVec4(bounds.x - margin, bounds.y - margin, bounds.z + margin, bounds.w + margin);
+    }
+    *out = ImVec4(bounds.x > area.x ? bounds.x : area.x, bounds.y > area.y ? bounds.y : area.y, bounds.z < area.z ? bounds.z : area.z, bounds.w < area.w ? bounds.w : area.w);
+    return out->z > out->x && out->w > out->y;
+}
+
+/** @brief Count commands of @p drawData not drawn identically at the same position of @p other, each must lie inside dirty rectangle */
+static int CheckDirtyCommands(const ImDrawData* drawData, const ImDrawData* other, const ImVec4* rects, int count, int* uncovered) {
+    int changed = 0;
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList* drawList = drawData->CmdLists[n];
+        for (int c = 0; c < drawList->CmdBuffer.Size; c++) {
+            const ImDrawCmd& cmd = drawList->CmdBuffer[c];
+            if (n < other->CmdListsCount && c < other->CmdLists[n]->CmdBuffer.Size &&
+                EqualDrawCmds(drawList, cmd, other->CmdLists[n], other->CmdLists[n]->CmdBuffer[c])) {
+                continue;
+            }
+            ImVec4 bounds;
+            if ((cmd.ElemCount == 0 && cmd.UserCallback == nullptr) || !UnitDrawnBounds(drawList, cmd, &bounds)) {
+                continue;
+            }
+            changed++;
+            bool covered = false;
+            for (int r = 0; r < count && !covered; r++) {
+                covered = rects[r].x <= bounds.x && rects[r].y <= bounds.y && rects[r].z >= bounds.z && rects[r].w >= bounds.w;
+            }
+            if (!covered) {
+                (*uncovered)++;
+            }
+        }
+    }
+    return changed;
+}
+
+/** @brief Frame counter changes every fourth frame & every third frame vertices of one random command are moved
+
+    Changed command must be inside dirty rectangle, unchanged frame must have none, rectangles must not overlap, leave
+    framebuffer or exceed requested count.
+ */
+static void CheckDirtyFrames(UnitSceneDesc desc, int frames) {
+    static const int maxRects = 4;
+    UnitRandom random(desc.Seed);
+    ImGui_ImplD2D_DirtyTracker tracker;
+    UnitScene scenes[2];
+    int cleanFrames = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        UnitScene& current = scenes[frame & 1];
+        const UnitScene& previous = scenes[(frame + 1) & 1];
+        desc.Counter = frame / 4;
+        current.Build(desc);
+        ImDrawData* drawData = &current.DrawData;
+        if (frame % 3 == 2) {
+            ImDrawList* drawList = drawData->CmdLists[random.Index(drawData->CmdListsCount)];
+            const ImDrawCmd& cmd = drawList->CmdBuffer[random.Index(drawList->CmdBuffer.Size)];
+            unsigned int last = 0;
+            for (unsigned int i = 0; i < cmd.ElemCount; i++) {
+                last = drawList->IdxBuffer[cmd.IdxOffset + i] > last ? drawList->IdxBuffer[cmd.IdxOffset + i] : last;
+            }
+            for (unsigned int i = 0; cmd.ElemCount > 0 && i <= last; i++) {
+                drawList->VtxBuffer[cmd.VtxOffset + i].pos.x += 3.0f;
+            }
+        }
+        const int count = tracker.Compute(drawData, &UnitFonts(), 1.0f, maxRects);
+        const ImVec4* rects = tracker.Rects.Data;
+        UNIT_CHECK(count <= maxRects);
+        UNIT_CHECK(frame != 0 || count == 1);
+        for (int r = 0; r < count; r++) {
+            const ImVec4& rect = rects[r];
+            UNIT_CHECK(rect.x >= 0.0f && rect.y >= 0.0f && rect.z <= UnitDisplaySize.x && rect.w <= UnitDisplaySize.y);
+            UNIT_CHECK(rect.z > rect.x && rect.w > rect.y);
+            for (int o = r + 1; o < count; o++) {
+                UNIT_CHECK(!(rect.x < rects[o].z && rects[o].x < rect.z && rect.y < rects[o].w && rects[o].y < rect.w));
+            }
+        }
+        if (frame > 0) {
+            // commands that appeared or changed are dirty where they are, those that disappeared where they were
+            int uncovered = 0;
+            const int changed = CheckDirtyCommands(drawData, &previous.DrawData, rects, count, &uncovered) +
+                CheckDirtyCommands(&previous.DrawData, drawData, rects, count, &uncovered);
+            UNIT_CHECK(uncovered == 0);
+            UNIT_CHECK(changed != 0 || count == 0);
+            cleanFrames += changed == 0 ? 1 : 0;
+        }
+    }
+    // counter changes every fourth frame & vertices every third, some frames stay the same
+    UNIT_CHECK(cleanFrames > 0);
+}
+
+UNIT_TEST(dirty_rects, grid_windows) {
+    UnitSceneDesc desc;
+    desc.Windows = 9;
+    CheckDirtyFrames(desc, 24);
+}
+
+UNIT_TEST(dirty_rects, stacked_windows) {
+    UnitSceneDesc desc;
+    desc.Windows = 8;
+    desc.Items = 40;
+    desc.Stacked = true;
+    desc.Seed = 7;
+    CheckDirtyFrames(desc, 24);
+}
+
+UNIT_TEST(dirty_rects, framebuffer_resize_marks_everything) {
+    UnitScene scene;
+    scene.Build(UnitSceneDesc());
+    ImGui_ImplD2D_DirtyTracker tracker;
+    UNIT_CHECK(tracker.Compute(&scene.DrawData, &UnitFonts(), 1.0f, 4) == 1);
+    UNIT_CHECK(tracker.Compute(&scene.DrawData, &UnitFonts(), 1.0f, 4) == 0);
+    scene.DrawData.DisplaySize = ImVec2(640, 480);
+    UNIT_REQUIRE(tracker.Compute(&scene.DrawData, &UnitFonts(), 1.0f, 4) == 1);
+    UNIT_CHECK(tracker.Rects[0].x == 0.0f && tracker.Rects[0].y == 0.0f && tracker.Rects[0].z == 640.0f && tracker.Rects[0].w == 480.0f);
+}
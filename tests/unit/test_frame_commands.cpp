@@ -0,0 +1,127 @@
+// Command lists of whole frame & reuse of unchanged draw lists (imgui_impl_d2d_draw.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+/** @brief Translate frames with & without reuse of unchanged draw lists, commands must be equal
+
+    Frame counter window changes every frame, other windows every fifth frame (scrolled), so most lists are reused.
+ */
+UNIT_TEST(frame_commands, reused_lists_equal_fresh_translation) {
+    ImGui_ImplD2D_FrameCommands fresh;
+    ImGui_ImplD2D_FrameCommands reuse;
+    reuse.ReuseUnchanged = true;
+    const ImGui_ImplD2D_TranslateParams params = UnitParams();
+    UnitSceneDesc desc;
+    desc.Windows = 6;
+    UnitScene scene;
+    ImGui_ImplD2D_FrameStats totals;
+    memset(&totals, 0, sizeof(totals));
+    for (int frame = 0; frame < 20; frame++) {
+        desc.Counter = frame;
+        desc.Scroll = (float)(frame / 5);
+        scene.Build(desc);
+        ImGui_ImplD2D_FrameStats stats;
+        memset(&stats, 0, sizeof(stats));
+        fresh.Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+        memset(&stats, 0, sizeof(stats));
+        reuse.Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+        UNIT_REQUIRE(fresh.Count == scene.DrawData.CmdListsCount && reuse.Count == fresh.Count);
+        for (int n = 0; n < fresh.Count; n++) {
+            UNIT_CHECK(UnitEqualCommandLists(*fresh.Lists[n], *reuse.Lists[n]));
+        }
+        ImGui_ImplD2D_AddFrameStats(&totals, stats);
+    }
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    UNIT_CHECK(totals.DrawListsReused > 0 && totals.DrawListsTranslated > 0);
+#endif
+}
+
+UNIT_TEST(frame_commands, params_change_translates_again) {
+    ImGui_ImplD2D_FrameCommands reuse;
+    reuse.ReuseUnchanged = true;
+    UnitScene scene;
+    scene.Build(UnitSceneDesc());
+    ImGui_ImplD2D_TranslateParams params = UnitParams();
+    ImGui_ImplD2D_FrameStats stats;
+    memset(&stats, 0, sizeof(stats));
+    reuse.Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+    params.ClipOffset = ImVec2(5, 5);
+    memset(&stats, 0, sizeof(stats));
+    reuse.Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+    ImGui_ImplD2D_FrameCommands fresh;
+    fresh.Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+    for (int n = 0; n < fresh.Count; n++) {
+        UNIT_CHECK(UnitEqualCommandLists(*fresh.Lists[n], *reuse.Lists[n]));
+    }
+}
+
+/** @brief ImGui allocations made on threads other than the one running test */
+static std::atomic<int> g_WorkerAllocations(0);
+static std::thread::id g_TestThread;
+
+static void* WorkerCountingAlloc(size_t size, void* userData) {
+    IM_UNUSED(userData);
+    if (std::this_thread::get_id() != g_TestThread) {
+        g_WorkerAllocations++;
+    }
+    return malloc(size);
+}
+
+static void WorkerCountingFree(void* ptr, void* userData) {
+    IM_UNUSED(userData);
+    free(ptr);
+}
+
+/** @brief Job system of one thread per job */
+static void ThreadParallelFor(int count, void (*job)(int index, void* jobData), void* jobData, void* userData) {
+    IM_UNUSED(userData);
+    std::vector<std::thread> threads;
+    for (int n = 0; n < count; n++) {
+        threads.emplace_back(job, n, jobData);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+/** @brief Lists translated by parallel jobs equal serial translation & jobs never call ImGui allocator */
+UNIT_TEST(frame_commands, parallel_lists_equal_serial_translation) {
+    ImGuiMemAllocFunc allocFunc;
+    ImGuiMemFreeFunc freeFunc;
+    void* allocUserData;
+    ImGui::GetAllocatorFunctions(&allocFunc, &freeFunc, &allocUserData);
+    g_TestThread = std::this_thread::get_id();
+    g_WorkerAllocations = 0;
+    ImGui::SetAllocatorFunctions(WorkerCountingAlloc, WorkerCountingFree, nullptr);
+    {
+        ImGui_ImplD2D_FrameCommands serial;
+        ImGui_ImplD2D_FrameCommands parallel;
+        const ImGui_ImplD2D_TranslateParams params = UnitParams();
+        UnitSceneDesc desc;
+        desc.Windows = 9;
+        desc.Items = 60;
+        UnitScene scene;
+        for (int frame = 0; frame < 4; frame++) {
+            // lists grow every frame, so buffers of previous frame are too small
+            desc.Counter = frame;
+            desc.Items += frame * 20;
+            desc.Seed = (unsigned int)frame;
+            scene.Build(desc);
+            ImGui_ImplD2D_FrameStats stats;
+            memset(&stats, 0, sizeof(stats));
+            serial.Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+            parallel.Translate(&scene.DrawData, params, ThreadParallelFor, nullptr, &stats);
+            UNIT_REQUIRE(parallel.Count == serial.Count && serial.Count > 1);
+            for (int n = 0; n < serial.Count; n++) {
+                UNIT_CHECK(UnitEqualCommandLists(*serial.Lists[n], *parallel.Lists[n]));
+            }
+        }
+    }
+    ImGui::SetAllocatorFunctions(allocFunc, freeFunc, allocUserData);
+    UNIT_CHECK(g_WorkerAllocations == 0);
+}
@@ -0,0 +1,80 @@
+// Geometries cached by shape relative to first point (imgui_impl_d2d_geometry.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+#include "unit_device.h"
+#include <cmath>
+
+/** @brief Draw scrolled frames through geometry cache & directly, framebuffer points of fills & clips must be equal */
+UNIT_TEST(geometry_cache, scrolled_frames_fill_same_points) {
+    ImGui_ImplD2D_FrameCommands commands;
+    GeometryCheckDevice direct;
+    GeometryCheckDevice cached;
+    ImGui_ImplD2D_GeometryCache cache;
+    cache.MaxEntries = 4096;
+    const ImGui_ImplD2D_TranslateParams params = UnitParams();
+    UnitSceneDesc desc;
+    desc.Windows = 4;
+    desc.Items = 60;
+    UnitScene scene;
+    ImGui_ImplD2D_FrameStats totals;
+    memset(&totals, 0, sizeof(totals));
+    for (int frame = 0; frame < 12; frame++) {
+        desc.Scroll = (float)(frame * 7);
+        scene.Build(desc);
+        ImGui_ImplD2D_FrameStats stats;
+        memset(&stats, 0, sizeof(stats));
+        commands.Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+        direct.ClearFills();
+        cached.Fills.resize(0);
+        cached.PushedClips.resize(0);
+        cache.BeginFrame();
+        for (int n = 0; n < commands.Count; n++) {
+            ImGui_ImplD2D_SubmitCommandList(*commands.Lists[n], &direct, &stats);
+            ImGui_ImplD2D_SubmitCommandList(*commands.Lists[n], &cached, &stats, &cache);
+        }
+        cache.EndFrame(&cached);
+        // no early return, cached geometries are released through device below
+        bool equal = direct.Fills.Size == cached.Fills.Size;
+        for (int p = 0; equal && p < direct.Fills.Size; p++) {
+            equal &= fabsf(direct.Fills[p].x - cached.Fills[p].x) < 0.01f && fabsf(direct.Fills[p].y - cached.Fills[p].y) < 0.01f;
+        }
+        UNIT_CHECK(equal);
+        // transform of cached geometry must not move clip rectangles pushed after it
+        UNIT_CHECK(direct.PushedClips.Size > 0 && direct.PushedClips.Size == cached.PushedClips.Size &&
+            memcmp(direct.PushedClips.Data, cached.PushedClips.Data, (size_t)direct.PushedClips.size_in_bytes()) == 0);
+        UNIT_CHECK(direct.LiveObjects == 0 && cached.ClipDepth == 0);
+        UNIT_CHECK(cached.LiveObjects == cache.Entries.Size);
+        ImGui_ImplD2D_AddFrameStats(&totals, stats);
+    }
+    cache.Clear(&cached);
+    UNIT_CHECK(cached.LiveObjects == 0 && cache.Entries.Size == 0);
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    UNIT_CHECK(totals.GeometriesReused > 0);
+#endif
+}
+
+UNIT_TEST(geometry_cache, full_cache_uses_temporary_geometry) {
+    ImGui_ImplD2D_GeometryCache cache;
+    cache.MaxEntries = 2;
+    ImGui_ImplD2D_RecordingDevice device;
+    ImGui_ImplD2D_FrameStats stats;
+    memset(&stats, 0, sizeof(stats));
+    cache.BeginFrame();
+    for (int n = 0; n < 3; n++) {
+        const ImVec2 points[3] = { ImVec2(10, 10), ImVec2(20.0f + n, 10), ImVec2(10, 30) };
+        ImVec2 origin;
+        bool cached = false;
+        void* geometry = cache.Acquire(points, 1, &device, &origin, &cached, &stats);
+        UNIT_CHECK(geometry != nullptr);
+        UNIT_CHECK(origin.x == 10.0f && origin.y == 10.0f);
+        UNIT_CHECK(cached == (n < 2));
+        if (!cached && geometry != nullptr) {
+            device.ReleaseGeometry(geometry);
+        }
+    }
+    cache.EndFrame(&device);
+    UNIT_CHECK(device.LiveObjects == cache.Entries.Size);
+    cache.Clear(&device);
+    UNIT_CHECK(device.LiveObjects == 0);
+}
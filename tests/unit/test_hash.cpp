@@ -0,0 +1,79 @@
+// Hash of buffers & frame fingerprint (imgui_impl_d2d_hash.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+
+UNIT_TEST(hash, vector_equals_scalar) {
+    UnitRandom random(19);
+    ImVector<unsigned char> data;
+    data.resize(1024 + 64);
+    for (int n = 0; n < data.Size; n++) {
+        data[n] = (unsigned char)random.Next();
+    }
+    // every size around stripe & block boundaries, at unaligned offsets
+    for (int size = 0; size <= 1024; size += size < 160 ? 1 : 37) {
+        for (int offset = 0; offset < 8; offset += 3) {
+            const ImU64 seed = random.Next();
+            UNIT_CHECK(ImGui_ImplD2D_Hash(data.Data + offset, (size_t)size, seed) == ImGui_ImplD2D_HashScalar(data.Data + offset, (size_t)size, seed));
+        }
+    }
+}
+
+UNIT_TEST(hash, single_byte_changes_hash) {
+    unsigned char data[97] = {};
+    const ImU64 hash = ImGui_ImplD2D_Hash(data, sizeof(data), 0);
+    for (int n = 0; n < (int)sizeof(data); n++) {
+        data[n] ^= 1;
+        UNIT_CHECK(ImGui_ImplD2D_Hash(data, sizeof(data), 0) != hash);
+        data[n] ^= 1;
+    }
+    UNIT_CHECK(ImGui_ImplD2D_Hash(data, sizeof(data), 1) != hash);
+}
+
+/** @brief Frame counter changes every fourth frame, fingerprints of consecutive frames are equal exactly when draw data is */
+UNIT_TEST(hash, fingerprint_follows_draw_data) {
+    UnitScene scenes[2];
+    UnitSceneDesc desc;
+    desc.Windows = 6;
+    ImU64 previous = 0;
+    int unchanged = 0;
+    for (int frame = 0; frame < 16; frame++) {
+        desc.Counter = frame / 4;
+        UnitScene& current = scenes[frame & 1];
+        current.Build(desc);
+        ImU64 hash = 0;
+        UNIT_REQUIRE(ImGui_ImplD2D_HashDrawData(&current.DrawData, 0, &hash));
+        if (frame > 0) {
+            const bool equal = UnitEqualDrawData(&current.DrawData, &scenes[(frame + 1) & 1].DrawData);
+            UNIT_CHECK((hash == previous) == equal);
+            unchanged += equal ? 1 : 0;
+        }
+        previous = hash;
+    }
+    UNIT_CHECK(unchanged == 12);
+}
+
+UNIT_TEST(hash, display_rect_changes_fingerprint) {
+    UnitScene scene;
+    scene.Build(UnitSceneDesc());
+    ImU64 hashes[3];
+    UNIT_REQUIRE(ImGui_ImplD2D_HashDrawData(&scene.DrawData, 0, &hashes[0]));
+    scene.DrawData.DisplayPos = ImVec2(1, 0);
+    UNIT_REQUIRE(ImGui_ImplD2D_HashDrawData(&scene.DrawData, 0, &hashes[1]));
+    scene.DrawData.DisplayPos = ImVec2(0, 0);
+    scene.DrawData.FramebufferScale = ImVec2(2, 2);
+    UNIT_REQUIRE(ImGui_ImplD2D_HashDrawData(&scene.DrawData, 0, &hashes[2]));
+    UNIT_CHECK(hashes[0] != hashes[1] && hashes[0] != hashes[2] && hashes[1] != hashes[2]);
+}
+
+static void UnitNoopCallback(const ImDrawList*, const ImDrawCmd*) {}
+
+UNIT_TEST(hash, callbacks_cannot_be_fingerprinted) {
+    UnitScene scene;
+    UnitDrawList list(scene.AddList("Callback"));
+    list.AddRect(ImVec2(0, 0), ImVec2(10, 10), IM_COL32_WHITE);
+    list.AddCallback(UnitNoopCallback, nullptr);
+    scene.Finish();
+    ImU64 hash = 0;
+    UNIT_CHECK(!ImGui_ImplD2D_HashDrawData(&scene.DrawData, 0, &hash));
+}
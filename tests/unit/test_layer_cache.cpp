@@ -0,0 +1,73 @@
+// Draw lists cached in offscreen layers (imgui_impl_d2d_layer.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+
+/** @brief Draw frames through layer cache of @p budget bytes, frame counter window is redrawn every frame
+
+    Device objects must not leak, clips must balance, layers must be closed & cache must stay within budget.
+ */
+static void CheckLayerFrames(ImU64 budget, int* drawn, int* reused) {
+    ImGui_ImplD2D_FrameCommands commands;
+    commands.HashLists = true;
+    ImGui_ImplD2D_LayerCache cache;
+    cache.Budget = budget;
+    ImGui_ImplD2D_RecordingDevice device;
+    const ImGui_ImplD2D_TranslateParams params = UnitParams();
+    UnitSceneDesc desc;
+    desc.Windows = 6;
+    UnitScene scene;
+    for (int frame = 0; frame < 10; frame++) {
+        desc.Counter = frame;
+        scene.Build(desc);
+        ImGui_ImplD2D_FrameStats stats;
+        memset(&stats, 0, sizeof(stats));
+        device.Reset();
+        commands.Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+        cache.BeginFrame();
+        for (int n = 0; n < commands.Count; n++) {
+            cache.Submit(*commands.Lists[n], params.FramebufferSize, &device, &stats);
+        }
+        cache.EndFrame(&device);
+        UNIT_CHECK(device.LiveObjects == 0 && device.ClipDepth == 0 && !device.InLayer);
+        UNIT_CHECK(device.LiveLayers == cache.Layers.Size);
+        UNIT_CHECK(cache.UsedBytes <= cache.Budget);
+        *drawn += stats.LayersDrawn;
+        *reused += stats.LayersReused;
+    }
+    cache.Clear(&device);
+    UNIT_CHECK(device.LiveLayers == 0 && cache.UsedBytes == 0);
+}
+
+UNIT_TEST(layer_cache, large_budget_reuses_layers) {
+    int drawn = 0, reused = 0;
+    CheckLayerFrames(256 * 1024 * 1024, &drawn, &reused);
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    UNIT_CHECK(drawn > 0 && reused > drawn);
+#endif
+}
+
+UNIT_TEST(layer_cache, small_budget_stays_within) {
+    int drawn = 0, reused = 0;
+    CheckLayerFrames(1024 * 1024, &drawn, &reused);
+}
+
+UNIT_TEST(layer_cache, unhashed_lists_are_drawn_directly) {
+    ImGui_ImplD2D_FrameCommands commands;
+    ImGui_ImplD2D_LayerCache cache;
+    cache.Budget = 256 * 1024 * 1024;
+    ImGui_ImplD2D_RecordingDevice device;
+    UnitScene scene;
+    scene.Build(UnitSceneDesc());
+    ImGui_ImplD2D_FrameStats stats;
+    memset(&stats, 0, sizeof(stats));
+    commands.Translate(&scene.DrawData, UnitParams(), nullptr, nullptr, &stats);
+    cache.BeginFrame();
+    for (int n = 0; n < commands.Count; n++) {
+        cache.Submit(*commands.Lists[n], UnitDisplaySize, &device, &stats);
+    }
+    cache.EndFrame(&device);
+    UNIT_CHECK(device.Calls[ImGui_ImplD2D_RecordingDevice::Call_CreateLayer] == 0 && cache.Layers.Size == 0);
+    UNIT_CHECK(device.Calls[ImGui_ImplD2D_RecordingDevice::Call_FillGeometry] > 0);
+    cache.Clear(&device);
+}
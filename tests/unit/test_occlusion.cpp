@@ -0,0 +1,117 @@
+// Occlusion of draw lists by opaque rectangles drawn later (imgui_impl_d2d_occlusion.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+#include "unit_device.h"
+
+/** @brief Translate & rasterize frames with & without occlusion culling, unchanged lists reused like the backend does */
+static void CheckOcclusionPixels(UnitSceneDesc desc, int frames, int* occluded) {
+    ImGui_ImplD2D_FrameCommands commands[2];
+    RasterDevice rasters[2];
+    for (int culling = 0; culling < 2; culling++) {
+        // unchanged lists are reused, so occluders in front of list must be part of its hash
+        commands[culling].ReuseUnchanged = true;
+        commands[culling].OcclusionCulling = culling != 0;
+    }
+    const ImGui_ImplD2D_TranslateParams params = UnitParams();
+    UnitScene scene;
+    for (int frame = 0; frame < frames; frame++) {
+        desc.Counter = frame / 2;
+        desc.Scroll = (float)(frame * 3);
+        scene.Build(desc);
+        for (int culling = 0; culling < 2; culling++) {
+            ImGui_ImplD2D_FrameStats stats;
+            memset(&stats, 0, sizeof(stats));
+            commands[culling].Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+            rasters[culling].Begin((int)UnitDisplaySize.x, (int)UnitDisplaySize.y);
+            for (int n = 0; n < commands[culling].Count; n++) {
+                ImGui_ImplD2D_SubmitCommandList(*commands[culling].Lists[n], &rasters[culling], &stats);
+            }
+            *occluded += culling ? stats.DrawCommandsOccluded : 0;
+        }
+        UNIT_CHECK(memcmp(rasters[0].Pixels.Data, rasters[1].Pixels.Data, (size_t)rasters[0].Pixels.size_in_bytes()) == 0);
+        UNIT_CHECK(rasters[1].ClipDepth == 0 && rasters[1].LiveObjects == 0);
+    }
+}
+
+UNIT_TEST(occlusion, stacked_windows_draw_same_pixels) {
+    UnitSceneDesc desc;
+    desc.Windows = 12;
+    desc.Items = 30;
+    desc.Stacked = true;
+    int occluded = 0;
+    CheckOcclusionPixels(desc, 4, &occluded);
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    // windows stacked at the same place hide all but the last of each stack
+    UNIT_CHECK(occluded > 0);
+#endif
+}
+
+UNIT_TEST(occlusion, transparent_windows_occlude_nothing) {
+    UnitSceneDesc desc;
+    desc.Windows = 12;
+    desc.Stacked = true;
+    desc.Opaque = false;
+    int occluded = 0;
+    CheckOcclusionPixels(desc, 2, &occluded);
+    UNIT_CHECK(occluded == 0);
+}
+
+UNIT_TEST(occlusion, grid_windows_draw_same_pixels) {
+    UnitSceneDesc desc;
+    desc.Windows = 9;
+    int occluded = 0;
+    CheckOcclusionPixels(desc, 3, &occluded);
+}
+
+UNIT_TEST(occlusion, occluders_of_opaque_quad) {
+    UnitScene scene;
+    UnitDrawList back(scene.AddList("Back"));
+    back.SetClip(ImVec4(100, 100, 200, 200));
+    back.AddRect(ImVec2(100, 100), ImVec2(200, 200), IM_COL32(255, 0, 0, 255));
+    UnitDrawList front(scene.AddList("Front"));
+    front.AddRect(ImVec2(50.5f, 50.5f), ImVec2(300.5f, 300.5f), IM_COL32(0, 0, 255, 255));
+    // not opaque, hides nothing
+    front.AddRect(ImVec2(400, 400), ImVec2(500, 500), IM_COL32(0, 0, 255, 128));
+    scene.Finish();
+
+    ImGui_ImplD2D_Occlusion occlusion;
+    occlusion.Compute(&scene.DrawData, UnitParams());
+    const ImVec4* occluders = nullptr;
+    UNIT_REQUIRE(occlusion.GetOccludersInFront(0, &occluders) == 1);
+    // pixels are only hidden where their centers are inside, rounded inwards
+    UNIT_CHECK(occluders[0].x == 51.0f && occluders[0].y == 51.0f && occluders[0].z == 300.0f && occluders[0].w == 300.0f);
+    UNIT_CHECK(occlusion.GetOccludersInFront(1, &occluders) == 0);
+}
+
+UNIT_TEST(occlusion, images_occlude_nothing) {
+    UnitScene scene;
+    UnitDrawList back(scene.AddList("Back"));
+    back.AddRect(ImVec2(100, 100), ImVec2(200, 200), IM_COL32(255, 0, 0, 255));
+    UnitDrawList front(scene.AddList("Front"));
+    // opaque tint, yet texture pixels may be transparent
+    front.AddImage((ImTextureID)(intptr_t)2, ImVec2(0, 0), ImVec2(400, 400), ImVec2(0, 0), ImVec2(1, 1), IM_COL32_WHITE);
+    scene.Finish();
+
+    ImGui_ImplD2D_Occlusion occlusion;
+    occlusion.Compute(&scene.DrawData, UnitParams());
+    const ImVec4* occluders = nullptr;
+    UNIT_CHECK(occlusion.GetOccludersInFront(0, &occluders) == 0);
+}
+
+static void UnitNoopCallback(const ImDrawList*, const ImDrawCmd*) {}
+
+UNIT_TEST(occlusion, callbacks_disable_occlusion) {
+    UnitScene scene;
+    UnitDrawList back(scene.AddList("Back"));
+    back.AddRect(ImVec2(100, 100), ImVec2(200, 200), IM_COL32(255, 0, 0, 255));
+    UnitDrawList front(scene.AddList("Front"));
+    front.AddCallback(UnitNoopCallback, nullptr);
+    front.AddRect(ImVec2(0, 0), ImVec2(400, 400), IM_COL32(0, 0, 255, 255));
+    scene.Finish();
+
+    ImGui_ImplD2D_Occlusion occlusion;
+    occlusion.Compute(&scene.DrawData, UnitParams());
+    const ImVec4* occluders = nullptr;
+    UNIT_CHECK(occlusion.GetOccludersInFront(0, &occluders) == 0);
+}
@@ -0,0 +1,189 @@
+// ImGui_ImplD2D_RenderDrawData() of Direct2D backend (imgui_impl_d2d.cpp), built on Windows only
+//
+// Unlike other units this one needs Direct2D & ImGui context: ImGui builds frames of a few windows, backend renders
+// them into WIC bitmap render target while ImGui_ImplD2D_SetSubmitDevice() records the call stream.
+
+#include "unit_test.h"
+#include "unit_device.h"
+#include "imgui_impl_d2d.h"
+#include <d2d1.h>
+#include <dwrite.h>
+#include <wincodec.h>
+#include <wrl/client.h>
+
+using Microsoft::WRL::ComPtr;
+
+static const int UnitTargetWidth = 1280;
+static const int UnitTargetHeight = 720;
+
+/** @brief ImGui context with backend initialized on WIC bitmap render target, torn down in reverse order */
+struct UnitBackend
+{
+    ComPtr<ID2D1Factory> Factory;
+    ComPtr<IDWriteFactory> WriteFactory;
+    ComPtr<IWICImagingFactory> ImagingFactory;
+    ComPtr<IWICBitmap> Bitmap;
+    ComPtr<ID2D1RenderTarget> RenderTarget;
+    ImGuiContext* Context;
+    bool    ComInitialized;
+    bool    Initialized;
+
+    UnitBackend() : Context(nullptr), ComInitialized(false), Initialized(false) {}
+    ~UnitBackend() {
+        if (Initialized) {
+            ImGui_ImplD2D_Shutdown();
+        }
+        if (Context != nullptr) {
+            ImGui::DestroyContext(Context);
+        }
+        RenderTarget.Reset();
+        Bitmap.Reset();
+        ImagingFactory.Reset();
+        WriteFactory.Reset();
+        Factory.Reset();
+        if (ComInitialized) {
+            CoUninitialize();
+        }
+    }
+
+    bool    Init(D2D1_FACTORY_TYPE factoryType) {
+        ComInitialized = SUCCEEDED(CoInitializeEx(NULL, COINIT_MULTITHREADED));
+        HRESULT hr = D2D1CreateFactory(factoryType, Factory.GetAddressOf());
+        if (SUCCEEDED(hr)) {
+            hr = DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED, __uuidof(IDWriteFactory), reinterpret_cast<IUnknown**>(WriteFactory.GetAddressOf()));
+        }
+        if (SUCCEEDED(hr)) {
+            hr = CoCreateInstance(CLSID_WICImagingFactory, NULL, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(ImagingFactory.GetAddressOf()));
+        }
+        if (SUCCEEDED(hr)) {
+            hr = ImagingFactory->CreateBitmap(UnitTargetWidth, UnitTargetHeight, GUID_WICPixelFormat32bppPBGRA, WICBitmapCacheOnLoad, Bitmap.GetAddressOf());
+        }
+        if (SUCCEEDED(hr)) {
+            hr = Factory->CreateWicBitmapRenderTarget(Bitmap.Get(), D2D1::RenderTargetProperties(), RenderTarget.GetAddressOf());
+        }
+        if (FAILED(hr)) {
+            return false;
+        }
+        Context = ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.DisplaySize = ImVec2((float)UnitTargetWidth, (float)UnitTargetHeight);
+        io.DeltaTime = 1.0f / 60.0f;
+        // backend keeps the reference it is given until ImGui_ImplD2D_Shutdown()
+        RenderTarget->AddRef();
+        Initialized = ImGui_ImplD2D_Init(RenderTarget.Get(), WriteFactory.Get());
+        return Initialized;
+    }
+};
+
+static void UnitBeginDraw(ImGui_ImplD2D_RenderTarget* renderTarget, void* userData) {
+    IM_UNUSED(userData);
+    renderTarget->BeginDraw();
+    renderTarget->Clear(D2D1::ColorF(D2D1::ColorF::Black));
+}
+
+static void UnitEndDraw(ImGui_ImplD2D_RenderTarget* renderTarget, void* userData) {
+    IM_UNUSED(userData);
+    renderTarget->EndDraw();
+}
+
+/** @brief Windows of text, widgets & gradients, frame counter changes every frame */
+static void UnitBuildFrame(int frame) {
+    ImGui_ImplD2D_NewFrame();
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(700, 700));
+    ImGui::ShowDemoWindow();
+    ImGui::SetNextWindowPos(ImVec2(720, 20));
+    ImGui::SetNextWindowSize(ImVec2(500, 400));
+    ImGui::Begin("Frame counter");
+    ImGui::Text("Frame %d", frame);
+    float color[4] = { 0.2f, 0.5f, 0.8f, 1.0f };
+    ImGui::ColorPicker4("Color", color);
+    ImGui::End();
+    ImGui::Render();
+}
+
+/** @brief How frames of one test run are rendered */
+struct UnitRenderDesc
+{
+    D2D1_FACTORY_TYPE FactoryType;
+    bool    RenderThread;
+    bool    DoubleBuffer;
+    int     Frames;
+
+    UnitRenderDesc() { FactoryType = D2D1_FACTORY_TYPE_SINGLE_THREADED; RenderThread = false; DoubleBuffer = false; Frames = 8; }
+};
+
+/** @brief Render frames through ImGui_ImplD2D_RenderDrawData(), calls are appended to @p device stream & factory
+    lock sections reported by ImGui_ImplD2D_GetFrameStats() after each frame are added to @p factoryLocks */
+static bool RenderFrames(const UnitRenderDesc& desc, StreamDevice* device, int* factoryLocks) {
+    UnitBackend backend;
+    if (!backend.Init(desc.FactoryType)) {
+        return false;
+    }
+    ImGui_ImplD2D_SetSubmitDevice(device);
+    if (desc.RenderThread) {
+        ImGui_ImplD2D_StartRenderThread(UnitBeginDraw, UnitEndDraw, nullptr, desc.DoubleBuffer);
+    }
+    for (int frame = 0; frame < desc.Frames; frame++) {
+        UnitBuildFrame(frame);
+        if (!desc.RenderThread) {
+            UnitBeginDraw(backend.RenderTarget.Get(), nullptr);
+        }
+        ImGui_ImplD2D_RenderDrawData(ImGui::GetDrawData());
+        if (!desc.RenderThread) {
+            UnitEndDraw(backend.RenderTarget.Get(), nullptr);
+        }
+        // render thread reports statistics of last frame it finished
+        *factoryLocks += ImGui_ImplD2D_GetFrameStats()->FactoryLocks;
+    }
+    ImGui_ImplD2D_StopRenderThread();
+    ImGui_ImplD2D_SetSubmitDevice(nullptr);
+    return true;
+}
+
+/** @brief Frames rendered on render thread issue the same calls in the same order as rendering on calling thread */
+static void CheckRenderThreadStream(D2D1_FACTORY_TYPE factoryType, bool doubleBuffer) {
+    UnitRenderDesc desc;
+    StreamDevice serial;
+    int serialLocks = 0;
+    UNIT_REQUIRE(RenderFrames(desc, &serial, &serialLocks));
+    desc.FactoryType = factoryType;
+    desc.RenderThread = true;
+    desc.DoubleBuffer = doubleBuffer;
+    StreamDevice threaded;
+    int threadedLocks = 0;
+    UNIT_REQUIRE(RenderFrames(desc, &threaded, &threadedLocks));
+    UNIT_CHECK(serial.Stream.Size > 0 && threaded.EqualStream(serial));
+    UNIT_CHECK(threaded.ClipDepth == 0 && threaded.LiveObjects == 0);
+}
+
+UNIT_TEST(render_draw_data, render_thread_single_snapshot_same_stream) {
+    CheckRenderThreadStream(D2D1_FACTORY_TYPE_SINGLE_THREADED, false);
+}
+
+UNIT_TEST(render_draw_data, render_thread_double_buffered_same_stream) {
+    CheckRenderThreadStream(D2D1_FACTORY_TYPE_SINGLE_THREADED, true);
+}
+
+UNIT_TEST(render_draw_data, render_thread_multithreaded_factory_same_stream) {
+    CheckRenderThreadStream(D2D1_FACTORY_TYPE_MULTI_THREADED, true);
+}
+
+/** @brief Single threaded factory is never locked, multithreaded one is locked around drawing on render thread */
+UNIT_TEST(render_draw_data, factory_locks) {
+    UnitRenderDesc desc;
+    StreamDevice device;
+    int locks = 0;
+    UNIT_REQUIRE(RenderFrames(desc, &device, &locks));
+    UNIT_CHECK(locks == 0);
+    desc.RenderThread = true;
+    UNIT_REQUIRE(RenderFrames(desc, &device, &locks));
+    UNIT_CHECK(locks == 0);
+    desc.FactoryType = D2D1_FACTORY_TYPE_MULTI_THREADED;
+    UNIT_REQUIRE(RenderFrames(desc, &device, &locks));
+#ifndef IMGUI_IMPL_D2D_DISABLE_STATS
+    UNIT_CHECK(locks > 0);
+#endif
+}
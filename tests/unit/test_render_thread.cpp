@@ -0,0 +1,64 @@
+// Snapshots handed to render thread (imgui_impl_d2d_render_thread.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+#include "unit_device.h"
+
+/** @brief State of render thread, only touched by render thread until it is stopped */
+struct RenderThreadTarget
+{
+    ImGui_ImplD2D_FrameCommands Commands;
+    /** @brief Call stream of every rendered frame, compared with UI thread once thread stopped */
+    StreamDevice Device;
+    int     Frames;
+
+    RenderThreadTarget() { Frames = 0; }
+};
+
+static void RenderSnapshot(ImGui_ImplD2D_DrawDataSnapshot* snapshot, void* userData) {
+    RenderThreadTarget* target = (RenderThreadTarget*)userData;
+    target->Commands.Translate(&snapshot->DrawData, snapshot->Params, nullptr, nullptr, &snapshot->Stats, snapshot->ListKeys.Data);
+    for (int n = 0; n < target->Commands.Count; n++) {
+        ImGui_ImplD2D_SubmitCommandList(*target->Commands.Lists[n], &target->Device, &snapshot->Stats);
+    }
+    target->Frames++;
+}
+
+/** @brief Frames rendered from snapshots on render thread issue the same calls in the same order as rendering on UI thread */
+static void CheckRenderThread(bool doubleBuffer) {
+    const ImGui_ImplD2D_TranslateParams params = UnitParams();
+    UnitSceneDesc desc;
+    desc.Windows = 6;
+    UnitScene scene;
+    RenderThreadTarget target;
+    ImGui_ImplD2D_FrameCommands commands;
+    StreamDevice device;
+    ImGui_ImplD2D_RenderThread renderThread;
+    renderThread.Start(RenderSnapshot, &target, doubleBuffer);
+    static const int frames = 12;
+    for (int frame = 0; frame < frames; frame++) {
+        desc.Counter = frame;
+        desc.Scroll = (float)frame;
+        scene.Build(desc);
+        ImGui_ImplD2D_FrameStats stats;
+        memset(&stats, 0, sizeof(stats));
+        commands.Translate(&scene.DrawData, params, nullptr, nullptr, &stats);
+        for (int n = 0; n < commands.Count; n++) {
+            ImGui_ImplD2D_SubmitCommandList(*commands.Lists[n], &device, &stats);
+        }
+        ImGui_ImplD2D_DrawDataSnapshot* snapshot = renderThread.Acquire();
+        snapshot->Copy(&scene.DrawData, *params.Fonts, params);
+        renderThread.Publish(snapshot);
+    }
+    renderThread.Stop();
+    UNIT_REQUIRE(target.Frames == frames);
+    UNIT_CHECK(device.Stream.Size > 0 && target.Device.EqualStream(device));
+}
+
+UNIT_TEST(render_thread, single_snapshot) {
+    CheckRenderThread(false);
+}
+
+UNIT_TEST(render_thread, double_buffered) {
+    CheckRenderThread(true);
+}
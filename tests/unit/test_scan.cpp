@@ -0,0 +1,97 @@
+// Solid run scanner & bounds of points (imgui_impl_d2d_scan.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+
+/** @brief Walk indices from run to run with block scanner & scalar reference, runs must be equal */
+template<typename T>
+static void CheckScanRuns(const T* idx, int count, const ImDrawVert* vert) {
+    ImGui_ImplD2D_FrameStats stats;
+    memset(&stats, 0, sizeof(stats));
+    for (int i = 6; i + 2 < count;) {
+        const ImU32 col = vert[idx[i - 3]].col;
+        const int block = ImGui_ImplD2D_ScanSolidRun(idx, i, count, vert, col, &stats);
+        const int scalar = ImGui_ImplD2D_ScanSolidRunScalar(idx, i, count, vert, col, &stats);
+        UNIT_REQUIRE(block == scalar);
+        i += 3 * (scalar + 1);
+    }
+}
+
+/** @brief Fans & strips with random breaks (no shared vertex) & color changes, at every alignment of block */
+template<typename T>
+static void CheckRandomPatterns(unsigned int seed) {
+    UnitRandom random(seed);
+    ImVector<ImDrawVert> vertices;
+    ImVector<T> indices;
+    for (int pattern = 0; pattern < 200; pattern++) {
+        vertices.resize(0);
+        indices.resize(0);
+        const int triangles = 3 + random.Index(80);
+        const ImU32 col = random.Color();
+        for (int t = 0; t < triangles; t++) {
+            ImDrawVert vert;
+            vert.pos = ImVec2(random.Range(0, 100), random.Range(0, 100));
+            vert.uv = UnitWhitePixel;
+            vert.col = random.Index(8) == 0 ? random.Color() : col;
+            const bool shared = t > 0 && random.Index(6) != 0;
+            const int first = vertices.Size;
+            for (int v = 0; v < 3; v++) {
+                vertices.push_back(vert);
+            }
+            // fan around first vertex of previous triangle, or disconnected triangle
+            indices.push_back((T)(shared ? indices[indices.Size - 3] : first));
+            indices.push_back((T)(shared ? indices[indices.Size - 2] : first + 1));
+            indices.push_back((T)(first + 2));
+        }
+        CheckScanRuns(indices.Data, indices.Size, vertices.Data);
+    }
+}
+
+UNIT_TEST(scan, random_patterns_16_bit) {
+    CheckRandomPatterns<ImU16>(11);
+}
+
+UNIT_TEST(scan, random_patterns_32_bit) {
+    CheckRandomPatterns<ImU32>(13);
+}
+
+UNIT_TEST(scan, scene_commands) {
+    UnitSceneDesc desc;
+    desc.Windows = 6;
+    desc.Items = 60;
+    UnitScene scene;
+    scene.Build(desc);
+    int scanned = 0;
+    for (const ImDrawList* drawList : scene.Lists) {
+        for (const ImDrawCmd& cmd : drawList->CmdBuffer) {
+            if (cmd.UserCallback != nullptr || cmd.ElemCount < 9) {
+                continue;
+            }
+            ImVector<ImU16> indices16;
+            ImVector<ImU32> indices32;
+            for (unsigned int i = 0; i < cmd.ElemCount; i++) {
+                indices16.push_back((ImU16)drawList->IdxBuffer[(int)(cmd.IdxOffset + i)]);
+                indices32.push_back((ImU32)drawList->IdxBuffer[(int)(cmd.IdxOffset + i)]);
+            }
+            CheckScanRuns(indices16.Data, indices16.Size, drawList->VtxBuffer.Data + cmd.VtxOffset);
+            CheckScanRuns(indices32.Data, indices32.Size, drawList->VtxBuffer.Data + cmd.VtxOffset);
+            scanned++;
+        }
+    }
+    UNIT_CHECK(scanned > 0);
+}
+
+UNIT_TEST(scan, points_bounds) {
+    UnitRandom random(17);
+    ImVector<ImVec2> points;
+    for (int count = 1; count < 64; count++) {
+        points.resize(count);
+        for (int n = 0; n < count; n++) {
+            points[n] = ImVec2(random.Range(-500, 500), random.Range(-500, 500));
+        }
+        ImVec4 bounds, reference;
+        ImGui_ImplD2D_GetPointsBounds(points.Data, count, &bounds);
+        ImGui_ImplD2D_GetPointsBoundsScalar(points.Data, count, &reference);
+        UNIT_CHECK(memcmp(&bounds, &reference, sizeof(bounds)) == 0);
+    }
+}
@@ -0,0 +1,145 @@
+// Translation of draw lists into commands (imgui_impl_d2d_draw.cpp)
+
+#include "unit_test.h"
+#include "unit_scene.h"
+#include "unit_device.h"
+
+/** @brief Translation features checked by tests */
+static const ImGui_ImplD2D_TranslateFeatures g_FeatureSets[] = {
+    ImGui_ImplD2D_TranslateFeatures_All,
+    ImGui_ImplD2D_TranslateFeatures_All & ~ImGui_ImplD2D_TranslateFeatures_Stats,
+    ImGui_ImplD2D_TranslateFeatures_All & ~ImGui_ImplD2D_TranslateFeatures_Text,
+    ImGui_ImplD2D_TranslateFeatures_All & ~ImGui_ImplD2D_TranslateFeatures_Gradients,
+    ImGui_ImplD2D_TranslateFeatures_All & ~ImGui_ImplD2D_TranslateFeatures_Cull,
+    ImGui_ImplD2D_TranslateFeatures_None,
+};
+
+UNIT_TEST(translate, index_widths_give_same_commands) {
+    UnitSceneDesc desc;
+    desc.Windows = 6;
+    desc.Items = 40;
+    UnitScene scene;
+    scene.Build(desc);
+    for (ImGui_ImplD2D_TranslateFeatures features : g_FeatureSets) {
+        const ImGui_ImplD2D_TranslateParams params = UnitParams(features);
+        for (const ImDrawList* drawList : scene.Lists) {
+            ImVector<ImU16> indices16;
+            ImVector<ImU32> indices32;
+            for (int i = 0; i < drawList->IdxBuffer.Size; i++) {
+                indices16.push_back((ImU16)drawList->IdxBuffer[i]);
+                indices32.push_back((ImU32)drawList->IdxBuffer[i]);
+            }
+            ImGui_ImplD2D_CommandList commands[3];
+            ImGui_ImplD2D_FrameStats stats;
+            memset(&stats, 0, sizeof(stats));
+            ImGui_ImplD2D_TranslateDrawList(drawList, params, &commands[0], &stats);
+            ImGui_ImplD2D_TranslateDrawList(drawList, indices16.Data, params, &commands[1], &stats);
+            ImGui_ImplD2D_TranslateDrawList(drawList, indices32.Data, params, &commands[2], &stats);
+            UNIT_CHECK(commands[0].Commands.Size > 0);
+            UNIT_CHECK(UnitEqualCommandLists(commands[0], commands[1]));
+            UNIT_CHECK(UnitEqualCommandLists(commands[0], commands[2]));
+        }
+    }
+}
+
+UNIT_TEST(translate, features_select_command_types) {
+    UnitScene scene;
+    UnitDrawList list(scene.AddList("Types"));
+    list.AddRect(ImVec2(10, 10), ImVec2(50, 50), IM_COL32(255, 0, 0, 255));
+    list.AddRectMultiColor(ImVec2(60, 10), ImVec2(100, 50), IM_COL32(255, 0, 0, 255), IM_COL32(0, 255, 0, 255), IM_COL32(0, 255, 0, 255), IM_COL32(255, 0, 0, 255));
+    list.AddText(0, ImVec2(10, 60), IM_COL32_WHITE, "Text");
+    scene.Finish();
+    for (ImGui_ImplD2D_TranslateFeatures features : g_FeatureSets) {
+        ImGui_ImplD2D_CommandList commands;
+        ImGui_ImplD2D_FrameStats stats;
+        memset(&stats, 0, sizeof(stats));
+        ImGui_ImplD2D_TranslateDrawList(scene.Lists[0], UnitParams(features), &commands, &stats);
+        int counts[ImGui_ImplD2D_CommandType_COUNT] = {};
+        for (const ImGui_ImplD2D_Command& command : commands.Commands) {
+            counts[command.Type]++;
+        }
+        UNIT_CHECK((counts[ImGui_ImplD2D_CommandType_GlyphRun] > 0) == ((features & ImGui_ImplD2D_TranslateFeatures_Text) != 0));
+        UNIT_CHECK((counts[ImGui_ImplD2D_CommandType_LinearGradient] > 0) == ((features & ImGui_ImplD2D_TranslateFeatures_Gradients) != 0));
+        UNIT_CHECK(counts[ImGui_ImplD2D_CommandType_Solid] > 0);
+        UNIT_CHECK(counts[ImGui_ImplD2D_CommandType_PushClip] == counts[ImGui_ImplD2D_CommandType_PopClip]);
+    }
+}
+
+UNIT_TEST(translate, glyphs_of_text) {
+    UnitScene scene;
+    UnitDrawList list(scene.AddList("Text"));
+    list.AddText(1, ImVec2(10, 20), IM_COL32(0, 255, 0, 255), "Hello");
+    scene.Finish();
+    ImGui_ImplD2D_CommandList commands;
+    ImGui_ImplD2D_FrameStats stats;
+    memset(&stats, 0, sizeof(stats));
+    ImGui_ImplD2D_TranslateDrawList(scene.Lists[0], UnitParams(), &commands, &stats);
+    UNIT_REQUIRE(commands.Glyphs.Size == 5);
+    static const char text[] = "Hello";
+    for (int n = 0; n < commands.Glyphs.Size; n++) {
+        UNIT_CHECK(commands.Glyphs[n].Codepoint == (unsigned int)text[n]);
+    }
+    int runs = 0;
+    for (const ImGui_ImplD2D_Command& command : commands.Commands) {
+        if (command.Type == ImGui_ImplD2D_CommandType_GlyphRun) {
+            UNIT_CHECK(command.Font == 1 && command.Col[0] == IM_COL32(0, 255, 0, 255));
+            runs++;
+        }
+    }
+    UNIT_CHECK(runs == 1);
+}
+
+UNIT_TEST(translate, images_of_other_textures) {
+    const ImTextureID texture = (ImTextureID)(intptr_t)2;
+    UnitScene scene;
+    UnitDrawList list(scene.AddList("Images"));
+    list.AddRect(ImVec2(0, 0), ImVec2(400, 300), IM_COL32(255, 0, 0, 255));
+    list.AddImage(texture, ImVec2(10, 20), ImVec2(74, 84), ImVec2(0.25f, 0.0f), ImVec2(0.5f, 1.0f), IM_COL32(255, 255, 255, 128));
+    // font atlas quad is not a glyph, it stays polygon
+    list.AddImage(UnitFontTexID, ImVec2(100, 20), ImVec2(164, 84), ImVec2(0, 0), ImVec2(1, 1), IM_COL32_WHITE);
+    list.AddText(0, ImVec2(10, 100), IM_COL32_WHITE, "Text");
+    scene.Finish();
+    for (ImGui_ImplD2D_TranslateFeatures features : g_FeatureSets) {
+        ImGui_ImplD2D_CommandList commands;
+        ImGui_ImplD2D_FrameStats stats;
+        memset(&stats, 0, sizeof(stats));
+        ImGui_ImplD2D_TranslateDrawList(scene.Lists[0], UnitParams(features), &commands, &stats);
+        int images = 0;
+        for (const ImGui_ImplD2D_Command& command : commands.Commands) {
+            if (command.Type == ImGui_ImplD2D_CommandType_Image) {
+                UNIT_CHECK(command.Texture == texture && command.Col[0] == IM_COL32(255, 255, 255, 128));
+                UNIT_CHECK(command.Pos[0].x == 10.0f && command.Pos[0].y == 20.0f && command.Pos[1].x == 74.0f && command.Pos[1].y == 84.0f);
+                UNIT_CHECK(command.Pos[2].x == 0.25f && command.Pos[2].y == 0.0f && command.Pos[3].x == 0.5f && command.Pos[3].y == 1.0f);
+                images++;
+            }
+        }
+        UNIT_CHECK(images == 1);
+
+        // image after fill drawn from geometry cache (with transform to its origin) is drawn at its place
+        ImGui_ImplD2D_GeometryCache cache;
+        cache.MaxEntries = 16;
+        CullCheckDevice device;
+        cache.BeginFrame();
+        ImGui_ImplD2D_SubmitCommandList(commands, &device, &stats, &cache);
+        cache.EndFrame(&device);
+        UNIT_CHECK(device.Calls[ImGui_ImplD2D_RecordingDevice::Call_DrawImage] == 1);
+        bool found = false;
+        for (const CullCheckDraw& draw : device.Draws) {
+            found |= draw.Bounds.x == 10.0f && draw.Bounds.y == 20.0f && draw.Bounds.z == 74.0f && draw.Bounds.w == 84.0f;
+        }
+        UNIT_CHECK(found);
+        cache.Clear(&device);
+        UNIT_CHECK(device.LiveObjects == 0);
+    }
+
+    // without font table font atlas cannot be told apart, quads are polygons
+    ImGui_ImplD2D_TranslateParams params = UnitParams();
+    params.Fonts = nullptr;
+    ImGui_ImplD2D_CommandList commands;
+    ImGui_ImplD2D_FrameStats stats;
+    memset(&stats, 0, sizeof(stats));
+    ImGui_ImplD2D_TranslateDrawList(scene.Lists[0], params, &commands, &stats);
+    for (const ImGui_ImplD2D_Command& command : commands.Commands) {
+        UNIT_CHECK(command.Type != ImGui_ImplD2D_CommandType_Image);
+    }
+}
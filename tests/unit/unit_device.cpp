@@ -0,0 +1,201 @@
+// Stand-in devices of imgui_impl_d2d unit tests
+
+#include "unit_device.h"
+#include <cmath>
+#include <cstring>
+
+void RasterDevice::Begin(int width, int height) {
+    Reset();
+    Width = width;
+    Height = height;
+    Pixels.resize(width * height);
+    for (int n = 0; n < Pixels.Size; n++) {
+        Pixels[n] = IM_COL32_BLACK;
+    }
+    Clips.resize(0);
+    Brushes.resize(0);
+    ClearFills();
+}
+
+void* RasterDevice::CreateLinearGradientBrush(const ImVec2& p0, const ImVec2& p1, ImU32 col0, ImU32 col1) {
+    GeometryCheckDevice::CreateLinearGradientBrush(p0, p1, col0, col1);
+    Brushes.push_back(col0);
+    return (void*)(intptr_t)Brushes.Size;
+}
+
+void* RasterDevice::CreateRadialGradientBrush(const ImVec2& center, const ImVec2& end, ImU32 col0, ImU32 col1) {
+    GeometryCheckDevice::CreateRadialGradientBrush(center, end, col0, col1);
+    // corners of radial gradients overlap, each is drawn with half of its alpha
+    Brushes.push_back((col0 & ~IM_COL32_A_MASK) | ((((col0 >> IM_COL32_A_SHIFT) & 0xFF) / 2) << IM_COL32_A_SHIFT));
+    return (void*)(intptr_t)Brushes.Size;
+}
+
+void RasterDevice::FillGeometry(void* geometry, void* brush) {
+    const int first = Fills.Size;
+    GeometryCheckDevice::FillGeometry(geometry, brush);
+    Fill(Fills.Data + first, (Fills.Size - first) / 3, brush != nullptr ? Brushes[(int)(intptr_t)brush - 1] : Color);
+}
+
+void RasterDevice::DrawGlyph(void* format, unsigned int codepoint, const ImVec2& glyphPos) {
+    GeometryCheckDevice::DrawGlyph(format, codepoint, glyphPos);
+    const ImVec2 pos(glyphPos.x + Transform.x, glyphPos.y + Transform.y);
+    // half of font size square, inside of glyph quad of unit_scene.h fonts, as glyph ink is inside of its quad
+    const float size = FontSize * 0.5f;
+    const ImVec2 cell[6] = { pos, ImVec2(pos.x + size, pos.y), ImVec2(pos.x + size, pos.y + size),
+        pos, ImVec2(pos.x + size, pos.y + size), ImVec2(pos.x, pos.y + size) };
+    Fill(cell, 2, Color);
+}
+
+void StreamDevice::PushAxisAlignedClip(const ImVec4& rect) {
+    ImGui_ImplD2D_RecordingDevice::PushAxisAlignedClip(rect);
+    Record(Call_PushAxisAlignedClip);
+    Record(ImVec2(rect.x, rect.y));
+    Record(ImVec2(rect.z, rect.w));
+}
+
+void StreamDevice::PopAxisAlignedClip() {
+    ImGui_ImplD2D_RecordingDevice::PopAxisAlignedClip();
+    Record(Call_PopAxisAlignedClip);
+}
+
+void StreamDevice::SetAntialiasMode(bool enabled) {
+    ImGui_ImplD2D_RecordingDevice::SetAntialiasMode(enabled);
+    Record(Call_SetAntialiasMode);
+    Stream.push_back(enabled ? 1u : 0u);
+}
+
+void StreamDevice::SetTransform(const ImVec2& offset) {
+    ImGui_ImplD2D_RecordingDevice::SetTransform(offset);
+    Record(Call_SetTransform);
+    Record(offset);
+}
+
+void* StreamDevice::CreateGeometry(const ImVec2* points, int triangleCount) {
+    Record(Call_CreateGeometry);
+    Stream.push_back((ImU32)triangleCount);
+    for (int n = 0; n < triangleCount * 3; n++) {
+        Record(points[n]);
+    }
+    return ImGui_ImplD2D_RecordingDevice::CreateGeometry(points, triangleCount);
+}
+
+void StreamDevice::SetSolidColor(ImU32 col) {
+    ImGui_ImplD2D_RecordingDevice::SetSolidColor(col);
+    Record(Call_SetSolidColor);
+    Stream.push_back(col);
+}
+
+void* StreamDevice::CreateLinearGradientBrush(const ImVec2& p0, const ImVec2& p1, ImU32 col0, ImU32 col1) {
+    Record(Call_CreateLinearGradientBrush);
+    Record(p0);
+    Record(p1);
+    Stream.push_back(col0);
+    Stream.push_back(col1);
+    return ImGui_ImplD2D_RecordingDevice::CreateLinearGradientBrush(p0, p1, col0, col1);
+}
+
+void* StreamDevice::CreateRadialGradientBrush(const ImVec2& center, const ImVec2& end, ImU32 col0, ImU32 col1) {
+    Record(Call_CreateRadialGradientBrush);
+    Record(center);
+    Record(end);
+    Stream.push_back(col0);
+    Stream.push_back(col1);
+    return ImGui_ImplD2D_RecordingDevice::CreateRadialGradientBrush(center, end, col0, col1);
+}
+
+void StreamDevice::FillGeometry(void* geometry, void* brush) {
+    ImGui_ImplD2D_RecordingDevice::FillGeometry(geometry, brush);
+    Record(Call_FillGeometry);
+    // shared solid color brush or brush created just before
+    Stream.push_back(brush != nullptr ? 1u : 0u);
+}
+
+void* StreamDevice::CreateTextFormat(int font, float fontSize) {
+    Record(Call_CreateTextFormat);
+    Stream.push_back((ImU32)font);
+    Record(fontSize);
+    return ImGui_ImplD2D_RecordingDevice::CreateTextFormat(font, fontSize);
+}
+
+void StreamDevice::DrawGlyph(void* format, unsigned int codepoint, const ImVec2& pos) {
+    ImGui_ImplD2D_RecordingDevice::DrawGlyph(format, codepoint, pos);
+    Record(Call_DrawGlyph);
+    Stream.push_back(codepoint);
+    Record(pos);
+}
+
+void StreamDevice::DrawImage(ImTextureID texture, const ImVec4& rect, const ImVec2& uv0, const ImVec2& uv1, ImU32 col) {
+    ImGui_ImplD2D_RecordingDevice::DrawImage(texture, rect, uv0, uv1, col);
+    Record(Call_DrawImage);
+    Record(ImVec2(rect.x, rect.y));
+    Record(ImVec2(rect.z, rect.w));
+    Record(uv0);
+    Record(uv1);
+    Stream.push_back(col);
+}
+
+void* StreamDevice::CreateLayer(int width, int height) {
+    Record(Call_CreateLayer);
+    Stream.push_back((ImU32)width);
+    Stream.push_back((ImU32)height);
+    return ImGui_ImplD2D_RecordingDevice::CreateLayer(width, height);
+}
+
+void StreamDevice::BeginLayer(void* layer, const ImVec2& origin) {
+    ImGui_ImplD2D_RecordingDevice::BeginLayer(layer, origin);
+    Record(Call_BeginLayer);
+    Record(origin);
+}
+
+void StreamDevice::DrawLayer(void* layer, const ImVec2& origin) {
+    ImGui_ImplD2D_RecordingDevice::DrawLayer(layer, origin);
+    Record(Call_DrawLayer);
+    Record(origin);
+}
+
+static float RasterEdge(const ImVec2& a, const ImVec2& b, float x, float y) {
+    return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+}
+
+void RasterDevice::Fill(const ImVec2* points, int triangleCount, ImU32 col) {
+    ImVec4 area(0.0f, 0.0f, (float)Width, (float)Height);
+    for (const ImVec4& clip : Clips) {
+        area = ImVec4(clip.x > area.x ? clip.x : area.x, clip.y > area.y ? clip.y : area.y, clip.z < area.z ? clip.z : area.z, clip.w < area.w ? clip.w : area.w);
+    }
+    ImVec4 bounds;
+    ImGui_ImplD2D_GetPointsBoundsScalar(points, triangleCount * 3, &bounds);
+    const int x1 = (int)floorf(area.x > bounds.x ? area.x : bounds.x);
+    const int y1 = (int)floorf(area.y > bounds.y ? area.y : bounds.y);
+    const int x2 = (int)ceilf(area.z < bounds.z ? area.z : bounds.z);
+    const int y2 = (int)ceilf(area.w < bounds.w ? area.w : bounds.w);
+    const ImU32 alpha = (col >> IM_COL32_A_SHIFT) & 0xFF;
+    for (int y = y1; y < y2; y++) {
+        for (int x = x1; x < x2; x++) {
+            // pixel center nudged off diagonals shared by triangles of quad, which would count twice
+            const float cx = x + 0.5f + 1.0f / 4096.0f;
+            const float cy = y + 0.5f + 1.0f / 8192.0f;
+            if (cx < area.x || cx >= area.z || cy < area.y || cy >= area.w) {
+                continue;
+            }
+            int inside = 0;
+            for (int t = 0; t < triangleCount; t++) {
+                const ImVec2* p = points + t * 3;
+                const float e0 = RasterEdge(p[0], p[1], cx, cy);
+                const float e1 = RasterEdge(p[1], p[2], cx, cy);
+                const float e2 = RasterEdge(p[2], p[0], cx, cy);
+                inside += (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f) || (e0 <= 0.0f && e1 <= 0.0f && e2 <= 0.0f) ? 1 : 0;
+            }
+            if ((inside & 1) == 0) {
+                continue;
+            }
+            ImU32& pixel = Pixels[y * Width + x];
+            ImU32 blended = IM_COL32_A_MASK;
+            for (int shift = 0; shift < 24; shift += 8) {
+                const ImU32 src = (col >> shift) & 0xFF;
+                const ImU32 dst = (pixel >> shift) & 0xFF;
+                blended |= ((src * alpha + dst * (255 - alpha) + 127) / 255) << shift;
+            }
+            pixel = blended;
+        }
+    }
+}
@@ -0,0 +1,164 @@
+// Stand-in devices of imgui_impl_d2d unit tests
+//
+// Built on ImGui_ImplD2D_RecordingDevice (so calls are still counted & objects tracked), each keeps what its tests
+// compare: framebuffer points of fills, bounds & clip of draws, or rasterized pixels.
+
+#pragma once
+#include "imgui.h"
+#include "imgui_impl_d2d_internal.h"
+#include <cstring>
+
+/** @brief Counting device keeping points of created geometries, framebuffer points of each fill & clip rectangles
+
+    Like Direct2D, clip rectangles are moved by transform current when they are pushed.
+ */
+struct GeometryCheckDevice : ImGui_ImplD2D_RecordingDevice
+{
+    /** @brief Points of all created geometries, geometry handle is index in @see Geometries plus one */
+    ImVector<ImVec2> GeometryPoints;
+    /** @brief First point & point count of each geometry */
+    ImVector<int> Geometries;
+    /** @brief Points of filled geometries moved by transform, in order of fills */
+    ImVector<ImVec2> Fills;
+    /** @brief Framebuffer rectangles of clips pushed now */
+    ImVector<ImVec4> Clips;
+    /** @brief Framebuffer rectangles of all clips pushed, in order of pushes */
+    ImVector<ImVec4> PushedClips;
+    ImVec2  Transform;
+
+    GeometryCheckDevice() : Transform(0, 0) {}
+
+    /** @brief Forget geometries, fills & clips of previous frame, created geometries must not outlive it */
+    void    ClearFills() { GeometryPoints.resize(0); Geometries.resize(0); Fills.resize(0); PushedClips.resize(0); }
+    void    SetTransform(const ImVec2& offset) override { ImGui_ImplD2D_RecordingDevice::SetTransform(offset); Transform = offset; }
+    void    PushAxisAlignedClip(const ImVec4& rect) override {
+        ImGui_ImplD2D_RecordingDevice::PushAxisAlignedClip(rect);
+        const ImVec4 clip(rect.x + Transform.x, rect.y + Transform.y, rect.z + Transform.x, rect.w + Transform.y);
+        Clips.push_back(clip);
+        PushedClips.push_back(clip);
+    }
+    void    PopAxisAlignedClip() override { ImGui_ImplD2D_RecordingDevice::PopAxisAlignedClip(); Clips.pop_back(); }
+    void*   CreateGeometry(const ImVec2* points, int triangleCount) override {
+        ImGui_ImplD2D_RecordingDevice::CreateGeometry(points, triangleCount);
+        Geometries.push_back(GeometryPoints.Size);
+        Geometries.push_back(triangleCount * 3);
+        for (int n = 0; n < triangleCount * 3; n++) {
+            GeometryPoints.push_back(points[n]);
+        }
+        return (void*)(intptr_t)(Geometries.Size / 2);
+    }
+    void    FillGeometry(void* geometry, void* brush) override {
+        ImGui_ImplD2D_RecordingDevice::FillGeometry(geometry, brush);
+        const int index = (int)(intptr_t)geometry - 1;
+        const int first = Geometries[index * 2];
+        for (int n = 0; n < Geometries[index * 2 + 1]; n++) {
+            Fills.push_back(ImVec2(GeometryPoints[first + n].x + Transform.x, GeometryPoints[first + n].y + Transform.y));
+        }
+    }
+};
+
+/** @brief Counting device keeping every call with its arguments, frames drawn the same way have equal streams
+
+    Each call is stored as its @see ImGui_ImplD2D_RecordingDevice::Call followed by bits of its arguments, handles
+    are left out as they differ between devices.
+ */
+struct StreamDevice : ImGui_ImplD2D_RecordingDevice
+{
+    ImVector<ImU32> Stream;
+
+    void    ClearStream() { Stream.resize(0); }
+    /** @brief Same calls with the same arguments in the same order */
+    bool    EqualStream(const StreamDevice& other) const {
+        return Stream.Size == other.Stream.Size && memcmp(Stream.Data, other.Stream.Data, (size_t)Stream.size_in_bytes()) == 0;
+    }
+    void    PushAxisAlignedClip(const ImVec4& rect) override;
+    void    PopAxisAlignedClip() override;
+    void    SetAntialiasMode(bool enabled) override;
+    void    SetTransform(const ImVec2& offset) override;
+    void*   CreateGeometry(const ImVec2* points, int triangleCount) override;
+    void    SetSolidColor(ImU32 col) override;
+    void*   CreateLinearGradientBrush(const ImVec2& p0, const ImVec2& p1, ImU32 col0, ImU32 col1) override;
+    void*   CreateRadialGradientBrush(const ImVec2& center, const ImVec2& end, ImU32 col0, ImU32 col1) override;
+    void    FillGeometry(void* geometry, void* brush) override;
+    void*   CreateTextFormat(int font, float fontSize) override;
+    void    DrawGlyph(void* format, unsigned int codepoint, const ImVec2& pos) override;
+    void    DrawImage(ImTextureID texture, const ImVec4& rect, const ImVec2& uv0, const ImVec2& uv1, ImU32 col) override;
+    void*   CreateLayer(int width, int height) override;
+    void    BeginLayer(void* layer, const ImVec2& origin) override;
+    void    DrawLayer(void* layer, const ImVec2& origin) override;
+
+private:
+    void    Record(int call) { Stream.push_back((ImU32)call); }
+    void    Record(float value) { ImU32 bits; memcpy(&bits, &value, sizeof(bits)); Stream.push_back(bits); }
+    void    Record(const ImVec2& value) { Record(value.x); Record(value.y); }
+};
+
+/** @brief Draw seen by @see CullCheckDevice, bounds of filled geometry or of glyph cell & clip rectangle it is drawn with */
+struct CullCheckDraw
+{
+    ImVec4  Bounds;
+    ImVec4  Clip;
+    bool    Clipped;
+};
+
+/** @brief Counting device recording bounds & clip of every draw */
+struct CullCheckDevice : GeometryCheckDevice
+{
+    ImVector<CullCheckDraw> Draws;
+    float   FontSize;
+
+    CullCheckDevice() : FontSize(0.0f) {}
+
+    void*   CreateTextFormat(int font, float fontSize) override { FontSize = fontSize; return GeometryCheckDevice::CreateTextFormat(font, fontSize); }
+    void    FillGeometry(void* geometry, void* brush) override {
+        const int first = Fills.Size;
+        GeometryCheckDevice::FillGeometry(geometry, brush);
+        ImVec4 bounds;
+        ImGui_ImplD2D_GetPointsBoundsScalar(Fills.Data + first, Fills.Size - first, &bounds);
+        AddDraw(bounds);
+    }
+    void    DrawGlyph(void* format, unsigned int codepoint, const ImVec2& pos) override {
+        GeometryCheckDevice::DrawGlyph(format, codepoint, pos);
+        AddDraw(ImVec4(pos.x, pos.y, pos.x + FontSize, pos.y + FontSize));
+    }
+    void    DrawImage(ImTextureID texture, const ImVec4& rect, const ImVec2& uv0, const ImVec2& uv1, ImU32 col) override {
+        GeometryCheckDevice::DrawImage(texture, rect, uv0, uv1, col);
+        AddDraw(ImVec4(rect.x + Transform.x, rect.y + Transform.y, rect.z + Transform.x, rect.w + Transform.y));
+    }
+    void    AddDraw(const ImVec4& bounds) {
+        CullCheckDraw draw;
+        draw.Bounds = bounds;
+        draw.Clipped = Clips.Size > 0;
+        draw.Clip = draw.Clipped ? Clips.back() : ImVec4(0, 0, 0, 0);
+        Draws.push_back(draw);
+    }
+};
+
+/** @brief Counting device rasterizing what it is asked to draw, reference to compare frames drawn two ways
+
+    Fills replace pixels with centers inside of odd number of their triangles (alternate fill mode, like Direct2D
+    device) & inside of pushed clip rectangles, blended with source alpha. Gradients are drawn with their first color
+    & glyphs as filled cells, which is enough to tell whether two frames draw the same pixels.
+ */
+struct RasterDevice : GeometryCheckDevice
+{
+    int     Width, Height;
+    ImVector<ImU32> Pixels;
+    ImVector<ImU32> Brushes;
+    ImU32   Color;
+    float   FontSize;
+
+    RasterDevice() : Width(0), Height(0), Color(0), FontSize(0.0f) {}
+
+    /** @brief Clear framebuffer of @p width x @p height pixels to opaque black */
+    void    Begin(int width, int height);
+    void    SetSolidColor(ImU32 col) override { GeometryCheckDevice::SetSolidColor(col); Color = col; }
+    void*   CreateLinearGradientBrush(const ImVec2& p0, const ImVec2& p1, ImU32 col0, ImU32 col1) override;
+    void*   CreateRadialGradientBrush(const ImVec2& center, const ImVec2& end, ImU32 col0, ImU32 col1) override;
+    void*   CreateTextFormat(int font, float fontSize) override { FontSize = fontSize; return GeometryCheckDevice::CreateTextFormat(font, fontSize); }
+    void    FillGeometry(void* geometry, void* brush) override;
+    void    DrawGlyph(void* format, unsigned int codepoint, const ImVec2& glyphPos) override;
+
+    /** @brief Blend @p col into pixels covered by odd number of @p triangleCount triangles */
+    void    Fill(const ImVec2* points, int triangleCount, ImU32 col);
+};
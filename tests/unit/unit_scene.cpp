@@ -0,0 +1,347 @@
+// Raw draw lists for imgui_impl_d2d unit tests
+
+#include "unit_scene.h"
+#include "unit_test.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+const ImTextureID UnitFontTexID = (ImTextureID)(intptr_t)1;
+const ImVec2 UnitWhitePixel(0.999f, 0.999f);
+const ImVec2 UnitDisplaySize(1280.0f, 720.0f);
+
+static const int UnitFontCount = 2;
+static const int UnitGlyphsPerFont = 96;
+
+const ImGui_ImplD2D_FontTable& UnitFonts() {
+    static ImGui_ImplD2D_FontTable fonts;
+    if (fonts.Glyphs.Size == 0) {
+        fonts.TexID = UnitFontTexID;
+        fonts.Version = 1;
+        for (int f = 0; f < UnitFontCount; f++) {
+            ImGui_ImplD2D_FontInfo info;
+            info.FontSize = 13.0f + f * 5.0f;
+            info.Scale = 1.0f;
+            info.Ascent = 10.0f + f * 4.0f;
+            info.GlyphOffset = fonts.Glyphs.Size;
+            info.GlyphCount = UnitGlyphsPerFont;
+            fonts.Fonts.push_back(info);
+            for (int c = 0; c < UnitGlyphsPerFont; c++) {
+                const int cell = f * UnitGlyphsPerFont + c;
+                ImGui_ImplD2D_FontGlyph glyph;
+                glyph.Codepoint = 32 + c;
+                glyph.X0 = 0.0f;
+                glyph.Y0 = 1.0f;
+                glyph.U0 = (cell % 16) / 16.0f;
+                glyph.V0 = (cell / 16) / 16.0f;
+                glyph.U1 = glyph.U0 + 1.0f / 32.0f;
+                glyph.V1 = glyph.V0 + 1.0f / 32.0f;
+                fonts.Glyphs.push_back(glyph);
+            }
+        }
+        fonts.BuildLookup();
+    }
+    return fonts;
+}
+
+ImGui_ImplD2D_TranslateParams UnitParams(ImGui_ImplD2D_TranslateFeatures features) {
+    ImGui_ImplD2D_TranslateParams params;
+    params.Fonts = &UnitFonts();
+    params.FramebufferSize = UnitDisplaySize;
+    params.Features = features;
+    return params;
+}
+
+//-----------------------------------------------------------------------------
+// Draw list
+//-----------------------------------------------------------------------------
+
+ImDrawCmd* UnitDrawList::PrepareCommand(int vtxCount, unsigned int* firstIndex) {
+    ImDrawCmd* cmd = List->CmdBuffer.Size > 0 ? &List->CmdBuffer.back() : nullptr;
+    // 16 bit indices reach only 64k vertices from VtxOffset of command
+    const bool indicesFull = sizeof(ImDrawIdx) == 2 && cmd != nullptr && List->VtxBuffer.Size - (int)cmd->VtxOffset + vtxCount > 0xFFFF;
+    if (cmd == nullptr || cmd->UserCallback != nullptr || indicesFull || cmd->TextureId != Texture ||
+        memcmp(&cmd->ClipRect, &Clip, sizeof(Clip)) != 0) {
+        ImDrawCmd next;
+        next.ClipRect = Clip;
+        next.TextureId = Texture;
+        next.VtxOffset = cmd != nullptr && !indicesFull ? cmd->VtxOffset : (unsigned int)List->VtxBuffer.Size;
+        next.IdxOffset = (unsigned int)List->IdxBuffer.Size;
+        next.ElemCount = 0;
+        List->CmdBuffer.push_back(next);
+        cmd = &List->CmdBuffer.back();
+        List->Flags |= ImDrawListFlags_AllowVtxOffset;
+    }
+    *firstIndex = (unsigned int)List->VtxBuffer.Size - cmd->VtxOffset;
+    return cmd;
+}
+
+void UnitDrawList::AddRect(const ImVec2& min, const ImVec2& max, ImU32 col) {
+    AddRectMultiColor(min, max, col, col, col, col);
+}
+
+void UnitDrawList::AddRectMultiColor(const ImVec2& min, const ImVec2& max, ImU32 colUprLeft, ImU32 colUprRight, ImU32 colBotRight, ImU32 colBotLeft) {
+    unsigned int first;
+    ImDrawCmd* cmd = PrepareCommand(4, &first);
+    AddVertex(min, UnitWhitePixel, colUprLeft);
+    AddVertex(ImVec2(max.x, min.y), UnitWhitePixel, colUprRight);
+    AddVertex(max, UnitWhitePixel, colBotRight);
+    AddVertex(ImVec2(min.x, max.y), UnitWhitePixel, colBotLeft);
+    static const unsigned int quad[6] = { 0, 1, 2, 0, 2, 3 };
+    for (unsigned int i : quad) {
+        AddIndex(cmd, first + i);
+    }
+}
+
+void UnitDrawList::AddImage(ImTextureID texture, const ImVec2& min, const ImVec2& max, const ImVec2& uv0, const ImVec2& uv1, ImU32 col) {
+    const ImTextureID previous = Texture;
+    Texture = texture;
+    // quad like ImDrawList::PrimRectUV()
+    unsigned int first;
+    ImDrawCmd* cmd = PrepareCommand(4, &first);
+    AddVertex(min, uv0, col);
+    AddVertex(ImVec2(max.x, min.y), ImVec2(uv1.x, uv0.y), col);
+    AddVertex(max, uv1, col);
+    AddVertex(ImVec2(min.x, max.y), ImVec2(uv0.x, uv1.y), col);
+    static const unsigned int quad[6] = { 0, 1, 2, 0, 2, 3 };
+    for (unsigned int i : quad) {
+        AddIndex(cmd, first + i);
+    }
+    Texture = previous;
+}
+
+void UnitDrawList::AddTriangle(const ImVec2& p0, const ImVec2& p1, const ImVec2& p2, ImU32 col0, ImU32 col1, ImU32 col2) {
+    unsigned int first;
+    ImDrawCmd* cmd = PrepareCommand(3, &first);
+    AddVertex(p0, UnitWhitePixel, col0);
+    AddVertex(p1, UnitWhitePixel, col1);
+    AddVertex(p2, UnitWhitePixel, col2);
+    for (unsigned int i = 0; i < 3; i++) {
+        AddIndex(cmd, first + i);
+    }
+}
+
+void UnitDrawList::AddCircle(const ImVec2& center, float radius, int segments, ImU32 col) {
+    IM_ASSERT(segments >= 3);
+    unsigned int first;
+    ImDrawCmd* cmd = PrepareCommand(segments, &first);
+    for (int s = 0; s < segments; s++) {
+        const float angle = 6.2831853f * s / segments;
+        AddVertex(ImVec2(center.x + cosf(angle) * radius, center.y + sinf(angle) * radius), UnitWhitePixel, col);
+    }
+    for (int s = 2; s < segments; s++) {
+        AddIndex(cmd, first);
+        AddIndex(cmd, first + s - 1);
+        AddIndex(cmd, first + s);
+    }
+}
+
+ImVec2 UnitDrawList::AddText(int font, const ImVec2& pos, ImU32 col, const char* text) {
+    const ImGui_ImplD2D_FontTable& fonts = UnitFonts();
+    IM_ASSERT(font >= 0 && font < fonts.Fonts.Size);
+    const ImGui_ImplD2D_FontInfo& info = fonts.Fonts[font];
+    const ImTextureID texture = Texture;
+    Texture = UnitFontTexID;
+    const float advance = info.FontSize * 0.5f;
+    ImVec2 cursor = pos;
+    for (const char* c = text; *c != 0; c++) {
+        const unsigned int codepoint = (unsigned int)(unsigned char)*c;
+        if (codepoint <= 32 || codepoint >= 32 + UnitGlyphsPerFont) {
+            cursor.x += advance;
+            continue;
+        }
+        // quad of glyph bitmap like ImFont::RenderText(): top-left, top-right, bottom-right, bottom-left
+        const ImGui_ImplD2D_FontGlyph& glyph = fonts.Glyphs[info.GlyphOffset + (int)codepoint - 32];
+        const ImVec2 min(cursor.x + glyph.X0, cursor.y + glyph.Y0);
+        const ImVec2 max(min.x + advance, min.y + info.FontSize * 0.75f);
+        unsigned int first;
+        ImDrawCmd* cmd = PrepareCommand(4, &first);
+        AddVertex(min, ImVec2(glyph.U0, glyph.V0), col);
+        AddVertex(ImVec2(max.x, min.y), ImVec2(glyph.U1, glyph.V0), col);
+        AddVertex(max, ImVec2(glyph.U1, glyph.V1), col);
+        AddVertex(ImVec2(min.x, max.y), ImVec2(glyph.U0, glyph.V1), col);
+        static const unsigned int quad[6] = { 0, 1, 2, 0, 2, 3 };
+        for (unsigned int i : quad) {
+            AddIndex(cmd, first + i);
+        }
+        cursor.x += advance;
+    }
+    Texture = texture;
+    return cursor;
+}
+
+void UnitDrawList::AddCallback(ImDrawCallback callback, void* userData) {
+    ImDrawCmd cmd;
+    cmd.ClipRect = Clip;
+    cmd.TextureId = Texture;
+    cmd.VtxOffset = List->CmdBuffer.Size > 0 ? List->CmdBuffer.back().VtxOffset : 0;
+    cmd.IdxOffset = (unsigned int)List->IdxBuffer.Size;
+    cmd.UserCallback = callback;
+    cmd.UserCallbackData = userData;
+    List->CmdBuffer.push_back(cmd);
+}
+
+//-----------------------------------------------------------------------------
+// Scene
+//-----------------------------------------------------------------------------
+
+UnitScene::~UnitScene() {
+    for (int n = 0; n < Lists.Size; n++) {
+        IM_DELETE(Lists[n]);
+    }
+    for (int n = 0; n < Names.Size; n++) {
+        IM_FREE(Names[n]);
+    }
+}
+
+void UnitScene::Clear() {
+    ListCount = 0;
+    DrawData.Clear();
+}
+
+ImDrawList* UnitScene::AddList(const char* name) {
+    if (ListCount == Lists.Size) {
+        Lists.push_back(IM_NEW(ImDrawList)(nullptr));
+    }
+    ImDrawList* list = Lists[ListCount++];
+    list->CmdBuffer.resize(0);
+    list->IdxBuffer.resize(0);
+    list->VtxBuffer.resize(0);
+    list->Flags = ImDrawListFlags_None;
+    list->_OwnerName = name;
+    return list;
+}
+
+void UnitScene::Finish() {
+    DrawData.Clear();
+    DrawData.Valid = true;
+    DrawData.DisplayPos = ImVec2(0, 0);
+    DrawData.DisplaySize = UnitDisplaySize;
+    DrawData.FramebufferScale = ImVec2(1, 1);
+    for (int n = 0; n < ListCount; n++) {
+        DrawData.CmdLists.push_back(Lists[n]);
+        DrawData.TotalVtxCount += Lists[n]->VtxBuffer.Size;
+        DrawData.TotalIdxCount += Lists[n]->IdxBuffer.Size;
+    }
+    DrawData.CmdListsCount = ListCount;
+}
+
+void UnitScene::Build(const UnitSceneDesc& desc) {
+    Clear();
+    const int windows = desc.Windows > 0 ? desc.Windows : 1;
+    int columns = 1;
+    while (columns * columns < windows) {
+        columns++;
+    }
+    const int rows = (windows + columns - 1) / columns;
+    const ImVec2 cellSize(UnitDisplaySize.x / columns, UnitDisplaySize.y / rows);
+    // window names are kept for keys of draw lists, one per window index
+    while (Names.Size <= windows) {
+        char* name = (char*)IM_ALLOC(32);
+        if (Names.Size < windows) {
+            snprintf(name, 32, "Window %d", Names.Size);
+        }
+        else {
+            snprintf(name, 32, "Frame counter");
+        }
+        Names.push_back(name);
+    }
+    for (int w = 0; w < windows; w++) {
+        UnitDrawList draw(AddList(Names[w]));
+        UnitRandom random(desc.Seed * 7919u + (unsigned int)w);
+        ImVec2 min, max;
+        if (desc.Stacked) {
+            min = ImVec2(20.0f + 310.0f * (w % 4), 30.0f + 40.0f * (w % 4));
+            max = ImVec2(min.x + 300.0f, min.y + 500.0f);
+        }
+        else {
+            min = ImVec2(cellSize.x * (w % columns) + 4.0f, cellSize.y * (w / columns) + 4.0f);
+            max = ImVec2(min.x + cellSize.x - 8.0f, min.y + cellSize.y - 8.0f);
+        }
+        draw.SetClip(ImVec4(min.x, min.y, max.x, max.y));
+        draw.AddRect(min, max, desc.Opaque ? IM_COL32(25, 25, 30, 255) : IM_COL32(25, 25, 30, 240));
+        draw.AddRect(min, ImVec2(max.x, min.y + 20.0f), IM_COL32(40, 60, 110, 255));
+        draw.AddText(0, ImVec2(min.x + 4.0f, min.y + 3.0f), IM_COL32_WHITE, Names[w]);
+
+        const ImVec4 content(min.x + 4.0f, min.y + 22.0f, max.x - 4.0f, max.y - 4.0f);
+        draw.SetClip(content);
+        float y = content.y + 2.0f - desc.Scroll;
+        for (int item = 0; item < desc.Items; item++, y += 18.0f) {
+            const float x = content.x + 2.0f;
+            const ImU32 col = random.Color();
+            const float width = random.Range(20.0f, 200.0f);
+            switch (random.Index(6)) {
+            case 0: {
+                char text[24];
+                const int length = 5 + random.Index(15);
+                for (int c = 0; c < length; c++) {
+                    text[c] = (char)(33 + random.Index(94));
+                }
+                text[length] = 0;
+                draw.AddText(random.Index(2), ImVec2(x, y), col, text);
+                break;
+            }
+            case 1:
+                draw.AddRect(ImVec2(x, y + 2.0f), ImVec2(x + width, y + 16.0f), col);
+                break;
+            case 2:
+                draw.AddRectMultiColor(ImVec2(x, y + 2.0f), ImVec2(x + width, y + 16.0f), col, random.Color(), random.Color(), col);
+                break;
+            case 3:
+                draw.AddTriangle(ImVec2(x, y + 16.0f), ImVec2(x + 8.0f, y + 2.0f), ImVec2(x + 16.0f, y + 16.0f), col, random.Color(), random.Color());
+                break;
+            case 4:
+                draw.AddCircle(ImVec2(x + 9.0f, y + 9.0f), 8.0f, 12, col);
+                break;
+            default:
+                // child region with its own clip rectangle, the next one returns to window clip
+                if (draw.Clip.x == content.x) {
+                    draw.SetClip(ImVec4(content.x + 30.0f, content.y, content.z - 30.0f, content.w));
+                }
+                else {
+                    draw.SetClip(content);
+                }
+                draw.AddRect(ImVec2(x, y + 4.0f), ImVec2(x + width * 2.0f, y + 14.0f), col);
+                break;
+            }
+        }
+    }
+    if (desc.Counter >= 0) {
+        UnitDrawList draw(AddList(Names[windows]));
+        char text[32];
+        snprintf(text, sizeof(text), "Frame %d", desc.Counter);
+        draw.AddRect(ImVec2(10, 10), ImVec2(130, 34), IM_COL32(60, 60, 60, 255));
+        draw.AddText(0, ImVec2(14, 14), IM_COL32_WHITE, text);
+    }
+    Finish();
+}
+
+//-----------------------------------------------------------------------------
+// Comparison
+//-----------------------------------------------------------------------------
+
+bool UnitEqualDrawData(const ImDrawData* a, const ImDrawData* b) {
+    if (a->CmdListsCount != b->CmdListsCount || memcmp(&a->DisplayPos, &b->DisplayPos, sizeof(ImVec2)) != 0 ||
+        memcmp(&a->DisplaySize, &b->DisplaySize, sizeof(ImVec2)) != 0 || memcmp(&a->FramebufferScale, &b->FramebufferScale, sizeof(ImVec2)) != 0) {
+        return false;
+    }
+    for (int n = 0; n < a->CmdListsCount; n++) {
+        const ImDrawList* listA = a->CmdLists[n];
+        const ImDrawList* listB = b->CmdLists[n];
+        if (listA->VtxBuffer.Size != listB->VtxBuffer.Size || listA->IdxBuffer.Size != listB->IdxBuffer.Size || listA->CmdBuffer.Size != listB->CmdBuffer.Size ||
+            listA->Flags != listB->Flags ||
+            memcmp(listA->VtxBuffer.Data, listB->VtxBuffer.Data, (size_t)listA->VtxBuffer.size_in_bytes()) != 0 ||
+            memcmp(listA->IdxBuffer.Data, listB->IdxBuffer.Data, (size_t)listA->IdxBuffer.size_in_bytes()) != 0 ||
+            memcmp(listA->CmdBuffer.Data, listB->CmdBuffer.Data, (size_t)listA->CmdBuffer.size_in_bytes()) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool UnitEqualCommandLists(const ImGui_ImplD2D_CommandList& a, const ImGui_ImplD2D_CommandList& b) {
+    return a.Commands.Size == b.Commands.Size && a.Points.Size == b.Points.Size && a.Glyphs.Size == b.Glyphs.Size &&
+        memcmp(a.Commands.Data, b.Commands.Data, (size_t)a.Commands.size_in_bytes()) == 0 &&
+        memcmp(a.Points.Data, b.Points.Data, (size_t)a.Points.size_in_bytes()) == 0 &&
+        memcmp(a.Glyphs.Data, b.Glyphs.Data, (size_t)a.Glyphs.size_in_bytes()) == 0;
+}
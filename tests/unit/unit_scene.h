@@ -0,0 +1,100 @@
+// Raw draw lists for imgui_impl_d2d unit tests
+//
+// Primitives are written into ImDrawList buffers directly, with vertex & index layout Dear ImGui emits them with
+// (PrimRect & PrimRectUV quads, convex polygon fans, glyph quads), so scenes need no ImGui context & are the same
+// with every ImGui version. Text uses synthetic font table with glyphs on regular grid of font atlas.
+
+#pragma once
+#include "imgui.h"
+#include "imgui_impl_d2d_internal.h"
+
+/** @brief Texture id of synthetic font atlas */
+extern const ImTextureID UnitFontTexID;
+/** @brief Texture coordinates of solid primitives, not a glyph corner */
+extern const ImVec2 UnitWhitePixel;
+/** @brief Display size of scenes */
+extern const ImVec2 UnitDisplaySize;
+
+/** @brief Font table of synthetic atlas: two fonts, glyphs of codepoints 32 to 127 on 16x16 grid, built once */
+const ImGui_ImplD2D_FontTable& UnitFonts();
+
+/** @brief Translation parameters of scenes: synthetic fonts, display sized framebuffer & given features */
+ImGui_ImplD2D_TranslateParams UnitParams(ImGui_ImplD2D_TranslateFeatures features = ImGui_ImplD2D_TranslateFeatures_All);
+
+/** @brief Appends primitives to draw list, draw command is split when clip rectangle or texture changes */
+struct UnitDrawList
+{
+    ImDrawList* List;
+    ImVec4      Clip;
+    ImTextureID Texture;
+
+    UnitDrawList(ImDrawList* list) { List = list; Clip = ImVec4(0, 0, UnitDisplaySize.x, UnitDisplaySize.y); Texture = UnitFontTexID; }
+
+    void    SetClip(const ImVec4& clip) { Clip = clip; }
+    void    SetTexture(ImTextureID texture) { Texture = texture; }
+    /** @brief Quad of two triangles (a, b, c) & (a, c, d) like ImDrawList::PrimRect() */
+    void    AddRect(const ImVec2& min, const ImVec2& max, ImU32 col);
+    /** @brief Quad with color per corner like ImDrawList::AddRectFilledMultiColor() */
+    void    AddRectMultiColor(const ImVec2& min, const ImVec2& max, ImU32 colUprLeft, ImU32 colUprRight, ImU32 colBotRight, ImU32 colBotLeft);
+    /** @brief Textured quad of @p texture like ImDrawList::AddImage(), texture is restored afterwards */
+    void    AddImage(ImTextureID texture, const ImVec2& min, const ImVec2& max, const ImVec2& uv0, const ImVec2& uv1, ImU32 col);
+    void    AddTriangle(const ImVec2& p0, const ImVec2& p1, const ImVec2& p2, ImU32 col0, ImU32 col1, ImU32 col2);
+    /** @brief Regular polygon as triangle fan like ImDrawList::AddConvexPolyFilled() without antialiasing */
+    void    AddCircle(const ImVec2& center, float radius, int segments, ImU32 col);
+    /** @brief Glyph quads of @p text (codepoints 32 to 127) in @p font of @see UnitFonts, returns position after text */
+    ImVec2  AddText(int font, const ImVec2& pos, ImU32 col, const char* text);
+    void    AddCallback(ImDrawCallback callback, void* userData);
+
+private:
+    /** @brief Draw command for primitive of @p vtxCount vertices, returns index of first new vertex relative to its VtxOffset */
+    ImDrawCmd* PrepareCommand(int vtxCount, unsigned int* firstIndex);
+    void    AddVertex(const ImVec2& pos, const ImVec2& uv, ImU32 col) { ImDrawVert vert; vert.pos = pos; vert.uv = uv; vert.col = col; List->VtxBuffer.push_back(vert); }
+    void    AddIndex(ImDrawCmd* cmd, unsigned int index) { List->IdxBuffer.push_back((ImDrawIdx)index); cmd->ElemCount++; }
+};
+
+/** @brief Windows of generated scene, same description gives same draw lists */
+struct UnitSceneDesc
+{
+    int     Windows;
+    /** @brief Rows of content per window: text, rectangles, gradients, circles & clip changes */
+    int     Items;
+    /** @brief Window backgrounds are opaque, otherwise slightly transparent */
+    bool    Opaque;
+    /** @brief Windows are stacked at four places & overlap, otherwise they are laid out on grid */
+    bool    Stacked;
+    /** @brief Content of every window is scrolled up by this many pixels */
+    float   Scroll;
+    /** @brief Value shown by small frame counter window drawn last, no such window when negative */
+    int     Counter;
+    unsigned int Seed;
+
+    UnitSceneDesc() { Windows = 4; Items = 20; Opaque = true; Stacked = false; Scroll = 0.0f; Counter = -1; Seed = 1; }
+};
+
+/** @brief Owns draw lists & draw data of scene */
+struct UnitScene
+{
+    ImVector<ImDrawList*> Lists;
+    ImDrawData DrawData;
+
+    UnitScene() { Clear(); }
+    ~UnitScene();
+
+    /** @brief Replace contents with generated windows */
+    void    Build(const UnitSceneDesc& desc);
+    /** @brief Remove all draw lists, memory of lists is kept */
+    void    Clear();
+    /** @brief Append empty draw list named @p name (ImDrawList::_OwnerName), name must outlive scene */
+    ImDrawList* AddList(const char* name);
+    /** @brief Update draw data totals after draw lists were filled */
+    void    Finish();
+
+private:
+    int     ListCount;
+    ImVector<char*> Names;
+};
+
+/** @brief Display rectangle & all buffers of draw lists are equal */
+bool UnitEqualDrawData(const ImDrawData* a, const ImDrawData* b);
+/** @brief Command lists are equal byte for byte (commands are zero filled before fields are set) */
+bool UnitEqualCommandLists(const ImGui_ImplD2D_CommandList& a, const ImGui_ImplD2D_CommandList& b);
@@ -0,0 +1,69 @@
+// Runner of imgui_impl_d2d unit tests
+//
+// Usage: imgui_impl_d2d_unit_tests [unit] [--update-baseline]
+//        runs all tests, or tests of one unit (e.g. occlusion), fails when any check fails or unit has no tests
+//        --update-baseline rewrites baseline files (call_counts.baseline) with current results
+
+#include "unit_test.h"
+#include <cstdio>
+#include <cstring>
+
+static UnitTest* g_FirstTest = nullptr;
+static UnitTest* g_LastTest = nullptr;
+static int g_Failures = 0;
+bool g_UnitUpdateBaseline = false;
+
+UnitTest::UnitTest(const char* unit, const char* name, UnitTestFunc func) {
+    Unit = unit;
+    Name = name;
+    Func = func;
+    Next = nullptr;
+    if (g_LastTest != nullptr) {
+        g_LastTest->Next = this;
+    }
+    else {
+        g_FirstTest = this;
+    }
+    g_LastTest = this;
+}
+
+void UnitTestFail(const char* file, int line, const char* expr) {
+    fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expr);
+    g_Failures++;
+}
+
+int main(int argc, char** argv) {
+    const char* unit = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--update-baseline") == 0) {
+            g_UnitUpdateBaseline = true;
+        }
+        else if (unit == nullptr && argv[i][0] != '-') {
+            unit = argv[i];
+        }
+        else {
+            fprintf(stderr, "Usage: %s [unit] [--update-baseline]\n", argv[0]);
+            return 1;
+        }
+    }
+    int tests = 0;
+    int failedTests = 0;
+    for (UnitTest* test = g_FirstTest; test != nullptr; test = test->Next) {
+        if (unit != nullptr && strcmp(unit, test->Unit) != 0) {
+            continue;
+        }
+        const int failures = g_Failures;
+        test->Func();
+        const bool passed = g_Failures == failures;
+        printf("%-8s %s.%s\n", passed ? "ok" : "FAILED", test->Unit, test->Name);
+        fflush(stdout);
+        tests++;
+        failedTests += passed ? 0 : 1;
+    }
+    if (tests == 0) {
+        fprintf(stderr, "No tests of unit %s\n", unit != nullptr ? unit : "(any)");
+        return 1;
+    }
+    printf("%d of %d tests passed\n", tests - failedTests, tests);
+    return failedTests != 0 ? 1 : 0;
+}
@@ -0,0 +1,59 @@
+// Unit tests of portable part of imgui_impl_d2d
+//
+// Each test file covers one unit & registers its tests with UNIT_TEST(unit, name). Tests draw raw draw lists built
+// by unit_scene.h, so they need neither Direct2D nor ImGui context, and results do not depend on ImGui version.
+// The render_draw_data unit (test_render_draw_data.cpp) is the exception, built on Windows into its own executable.
+
+#pragma once
+#include "imgui.h"
+
+typedef void (*UnitTestFunc)();
+
+/** @brief Registered test, tests of all files form linked list in order of registration */
+struct UnitTest
+{
+    const char*     Unit;
+    const char*     Name;
+    UnitTestFunc    Func;
+    UnitTest*       Next;
+
+    UnitTest(const char* unit, const char* name, UnitTestFunc func);
+};
+
+/** @brief Report failed check of current test, test keeps running */
+void UnitTestFail(const char* file, int line, const char* expr);
+
+/** @brief Set by --update-baseline, tests comparing against checked in baseline files rewrite them instead */
+extern bool g_UnitUpdateBaseline;
+
+/** @brief Deterministic random numbers (xorshift32), independent of platform rand() */
+struct UnitRandom
+{
+    unsigned int State;
+
+    UnitRandom(unsigned int seed) { State = seed != 0 ? seed : 1u; }
+    unsigned int Next() {
+        State ^= State << 13;
+        State ^= State >> 17;
+        State ^= State << 5;
+        return State;
+    }
+    /** @brief Integer in [0, count) */
+    int     Index(int count) { return (int)(Next() % (unsigned int)count); }
+    float   Range(float min, float max) { return min + (max - min) * (float)(Next() & 0xFFFFu) / 65535.0f; }
+    ImU32   Color() { return Next() | IM_COL32_A_MASK; }
+};
+
+#define UNIT_TEST_CONCAT_(_A, _B)   _A##_B
+#define UNIT_TEST_CONCAT(_A, _B)    UNIT_TEST_CONCAT_(_A, _B)
+
+/** @brief Define test @p _NAME of unit @p _UNIT, body follows */
+#define UNIT_TEST(_UNIT, _NAME) \
+    static void UnitTest_##_UNIT##_##_NAME(); \
+    static UnitTest UNIT_TEST_CONCAT(g_UnitTest_##_UNIT##_##_NAME, __LINE__)(#_UNIT, #_NAME, UnitTest_##_UNIT##_##_NAME); \
+    static void UnitTest_##_UNIT##_##_NAME()
+
+/** @brief Failed check is reported & test continues */
+#define UNIT_CHECK(_EXPR)   do { if (!(_EXPR)) { UnitTestFail(__FILE__, __LINE__, #_EXPR); } } while (0)
+/** @brief Failed check is reported & test returns, for checks later code depends on */
+#define UNIT_REQUIRE(_EXPR) do { if (!(_EXPR)) { UnitTestFail(__FILE__, __LINE__, #_EXPR); return; } } while (0)
@@ -0,0 +1,82 @@
+// Replays draw data captured by ImGui_ImplD2D_BeginCapture()
+//
+// Frames are translated & submitted exactly like ImGui_ImplD2D_RenderDrawData() does, but to device that only
+// counts calls, so renderer changes can be compared on the same input (also on machines without Direct2D).
+//
+// Usage: replay_draw_data <capture file> [repeat count]
+
+#include "imgui.h"
+#include "imgui_impl_d2d.h"
+#include "imgui_impl_d2d_internal.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void PrintFrame(int frame, const ImDrawData& drawData, const ImGui_ImplD2D_FrameStats& stats, const ImGui_ImplD2D_RecordingDevice& device) {
+    printf("frame %d: lists %d, vertices %d, indices %d\n", frame, drawData.CmdListsCount, drawData.TotalVtxCount, drawData.TotalIdxCount);
+    printf("  polygons: solid %d, linear %d, radial %d, glyphs %d\n",
+        stats.SolidPolygons, stats.LinearGradientPolygons, stats.RadialGradientPolygons, stats.Glyphs);
+    printf("  time [us]: classify %.1f, glyph %.1f, submit %.1f\n",
+        stats.ClassifyTime / 1000.0, stats.GlyphTime / 1000.0, stats.SubmitTime / 1000.0);
+    printf("  calls %d:", device.GetTotalCalls());
+    for (int c = 0; c < ImGui_ImplD2D_RecordingDevice::Call_COUNT; c++) {
+        if (device.Calls[c] != 0) {
+            printf(" %s %d", ImGui_ImplD2D_RecordingDevice::GetCallName(c), device.Calls[c]);
+        }
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <capture file> [repeat count]\n", argv[0]);
+        return 1;
+    }
+    const int repeat = argc > 2 ? atoi(argv[2]) : 1;
+    ImGui_ImplD2D_CaptureReader reader;
+    if (!reader.Open(argv[1])) {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    ImGui_ImplD2D_CommandList commands;
+    ImGui_ImplD2D_RecordingDevice device;
+    ImGui_ImplD2D_FrameStats total;
+    memset(&total, 0, sizeof(total));
+    int frames = 0;
+    for (int r = 0; r < repeat; r++) {
+        if (r > 0 && !reader.Rewind()) {
+            break;
+        }
+        while (reader.ReadFrame()) {
+            ImGui_ImplD2D_TranslateParams params;
+            params.Fonts = &reader.Fonts;
+            params.FontGlobalScale = reader.FontGlobalScale;
+            params.FramebufferSize = reader.FramebufferSize;
+
+            ImGui_ImplD2D_FrameStats stats;
+            memset(&stats, 0, sizeof(stats));
+            device.Reset();
+            for (int n = 0; n < reader.DrawData.CmdListsCount; n++) {
+                commands.Reset();
+                ImGui_ImplD2D_TranslateDrawList(reader.DrawData.CmdLists[n], params, &commands, &stats);
+                ImGui_ImplD2D_SubmitCommandList(commands, &device, &stats);
+            }
+            IM_ASSERT(device.ClipDepth == 0 && device.LiveObjects == 0);
+            if (r == 0) {
+                PrintFrame(reader.FrameCount, reader.DrawData, stats, device);
+            }
+            total.ClassifyTime += stats.ClassifyTime;
+            total.GlyphTime += stats.GlyphTime;
+            total.SubmitTime += stats.SubmitTime;
+            frames++;
+        }
+    }
+    if (frames == 0) {
+        fprintf(stderr, "No frames read from %s\n", argv[1]);
+        return 1;
+    }
+    printf("%d frames, average time [us]: classify %.1f, glyph %.1f, submit %.1f\n", frames,
+        total.ClassifyTime / 1000.0 / frames, total.GlyphTime / 1000.0 / frames, total.SubmitTime / 1000.0 / frames);
+    return 0;
+}